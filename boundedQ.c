@@ -1,36 +1,80 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
+#include <errno.h>
+#include <time.h>
 #include <pthread.h>
+#include <sys/types.h>
 
 #ifndef BQSIZE
 #define BQSIZE 10
 #endif
 
+#ifndef BQHEAPSIZE
+#define BQHEAPSIZE 4096		// paths a largest-first queue holds
+#endif
+
+#ifndef BQGATECOUNT
+#define BQGATECOUNT 256		// paths a largest-first queue waits for before handing any out
+#endif
+
+#ifndef BQGATEMS
+#define BQGATEMS 20		// or fewer, once nothing new has been queued for this many milliseconds
+#endif
+
+// a queue is either first in, first out (a ring starting at head) or largest
+// first: a max-heap on the size hints, which hands nothing out until it holds
+// BQGATECOUNT items, is closed, or the producer has stalled for BQGATEMS, so
+// the first files taken are the largest of a good many without a slow walk
+// holding the readers back (tests/gatesim.py simulates the choice)
 typedef struct {
-	char * data[BQSIZE];
+	char ** data;
+	off_t * hint;		// size hint that came with each item, -1 for none
+	unsigned capacity;
 	unsigned count;
 	unsigned head;
+	int largestFirst;
+	int gated;		// a largest-first queue whose gate has not opened yet
+	struct timespec lastPut;	// when the last item was put, while gated
+	off_t bytes;		// sum of the hints queued
 	int open;
 	pthread_mutex_t lock;
 	pthread_cond_t read_ready;
 	pthread_cond_t write_ready;
 } bounded_queue_t;
 
-int init_bounded(bounded_queue_t *Q)
+int init_queue(bounded_queue_t *Q, unsigned capacity, int largestFirst)
 {
+	Q->data = malloc(sizeof(char *) * capacity);
+	Q->hint = malloc(sizeof(off_t) * capacity);
+	Q->capacity = capacity;
 	Q->count = 0;
 	Q->head = 0;
+	Q->largestFirst = largestFirst;
+	Q->gated = largestFirst;
+	Q->bytes = 0;
 	Q->open = 1;
 	pthread_mutex_init(&Q->lock, NULL);
 	pthread_cond_init(&Q->read_ready, NULL);
 	pthread_cond_init(&Q->write_ready, NULL);
-	
+
 	return 0;
 }
 
+int init_bounded(bounded_queue_t *Q)
+{
+	return init_queue(Q, BQSIZE, 0);
+}
+
+int init_bounded_largest(bounded_queue_t *Q)
+{
+	return init_queue(Q, BQHEAPSIZE, 1);
+}
+
 int destroy_bounded(bounded_queue_t *Q)
 {
+	free(Q->data);
+	free(Q->hint);
 	pthread_mutex_destroy(&Q->lock);
 	pthread_cond_destroy(&Q->read_ready);
 	pthread_cond_destroy(&Q->write_ready);
@@ -38,14 +82,74 @@ int destroy_bounded(bounded_queue_t *Q)
 	return 0;
 }
 
-// add item to end of queue
+// store one item, with the lock held and room for it
+static void put(bounded_queue_t *Q, char * item, off_t hint)
+{
+	if (hint > 0) Q->bytes += hint;
+
+	if (!Q->largestFirst) {
+		unsigned i = Q->head + Q->count;
+		if (i >= Q->capacity) i -= Q->capacity;
+		Q->data[i] = item;
+		Q->hint[i] = hint;
+		++Q->count;
+		return;
+	}
+
+	// sift up
+	unsigned i = Q->count++;
+	while (i > 0 && Q->hint[(i - 1) / 2] < hint) {
+		Q->data[i] = Q->data[(i - 1) / 2];
+		Q->hint[i] = Q->hint[(i - 1) / 2];
+		i = (i - 1) / 2;
+	}
+	Q->data[i] = item;
+	Q->hint[i] = hint;
+	if (Q->count >= BQGATECOUNT || Q->count == Q->capacity) Q->gated = 0;
+	if (Q->gated) clock_gettime(CLOCK_REALTIME, &Q->lastPut);
+}
+
+// take the next item, with the lock held and an item there
+static void take(bounded_queue_t *Q, char ** item, off_t * hint)
+{
+	if (!Q->largestFirst) {
+		*item = Q->data[Q->head];
+		*hint = Q->hint[Q->head];
+		--Q->count;
+		++Q->head;
+		if (Q->head == Q->capacity) Q->head = 0;
+	} else {
+		*item = Q->data[0];
+		*hint = Q->hint[0];
+		char * last = Q->data[--Q->count];
+		off_t lastHint = Q->hint[Q->count];
+
+		// sift the last item down from the root
+		unsigned i = 0;
+		while (2 * i + 1 < Q->count) {
+			unsigned c = 2 * i + 1;
+			if (c + 1 < Q->count && Q->hint[c + 1] > Q->hint[c]) c++;
+			if (Q->hint[c] <= lastHint) break;
+			Q->data[i] = Q->data[c];
+			Q->hint[i] = Q->hint[c];
+			i = c;
+		}
+		Q->data[i] = last;
+		Q->hint[i] = lastHint;
+	}
+
+	if (*hint > 0) Q->bytes -= *hint;
+}
+
+// add item to the queue with its size hint (-1 for none), taking ownership of it (the pointer itself is stored)
 // if the queue is full, block until space becomes available
-int enqueue(bounded_queue_t *Q, char * item)
+// returns -1 if the queue is closed, in which case the caller still owns item
+int enqueue_hinted(bounded_queue_t *Q, char * item, off_t hint)
 {
 
 	pthread_mutex_lock(&Q->lock);
-	
-	while ( (Q->count == BQSIZE) && Q->open) {
+
+	while ( (Q->count == Q->capacity) && Q->open) {
 		pthread_cond_wait(&Q->write_ready, &Q->lock);
 	}
 
@@ -54,54 +158,116 @@ int enqueue(bounded_queue_t *Q, char * item)
 		return -1;
 	}
 
-	unsigned i = Q->head + Q->count;
-	if (i >= BQSIZE) i -= BQSIZE;
+	int wasGated = Q->gated;
+	put(Q, item, hint);
 
-	Q->data[i] = malloc(1 + strlen(item));
-	strcpy(Q->data[i], item);
-	free(item);
-	++Q->count;
+	// a gate that just opened lets every reader in; behind a closed one, a
+	// reader still has to wake to time the stall
+	if (wasGated && !Q->gated) {
+		pthread_cond_broadcast(&Q->read_ready);
+	} else {
+		pthread_cond_signal(&Q->read_ready);
+	}
 
-	pthread_cond_signal(&Q->read_ready);
-	
 	pthread_mutex_unlock(&Q->lock);
 
 	return 0;
 }
 
+int enqueue(bounded_queue_t *Q, char * item)
+{
+	return enqueue_hinted(Q, item, -1);
+}
 
-int dequeue(bounded_queue_t *Q, char ** item)
+
+// add n items with their size hints, taking the lock once for as many as fit at a time
+// returns the number enqueued, fewer than n only if the queue closed; the caller still owns the rest
+int enqueue_batch(bounded_queue_t *Q, char ** items, off_t * hints, int n)
+{
+	int done = 0;
+
+	pthread_mutex_lock(&Q->lock);
+
+	while (done < n) {
+		while ( (Q->count == Q->capacity) && Q->open) {
+			pthread_cond_wait(&Q->write_ready, &Q->lock);
+		}
+		if (!Q->open) break;
+
+		while (done < n && Q->count < Q->capacity) {
+			put(Q, items[done], hints[done]);
+			++done;
+		}
+		if (!Q->gated) pthread_cond_broadcast(&Q->read_ready);
+		else pthread_cond_signal(&Q->read_ready);
+	}
+
+	pthread_mutex_unlock(&Q->lock);
+
+	return done;
+}
+
+// dequeue, also handing out the size hint the item came with (-1 for none)
+int dequeue_hinted(bounded_queue_t *Q, char ** item, off_t * hint)
 {
 	pthread_mutex_lock(&Q->lock);
-	while (Q->count == 0 && Q->open) {
-		pthread_cond_wait(&Q->read_ready, &Q->lock);
+	while ((Q->count == 0 || Q->gated) && Q->open) {
+		if (Q->count == 0) {
+			pthread_cond_wait(&Q->read_ready, &Q->lock);
+			continue;
+		}
+
+		// items wait behind the gate: open it if nothing more comes for BQGATEMS
+		struct timespec since = Q->lastPut;
+		struct timespec until = since;
+		until.tv_nsec += BQGATEMS * 1000000L;
+		until.tv_sec += until.tv_nsec / 1000000000L;
+		until.tv_nsec %= 1000000000L;
+		if (pthread_cond_timedwait(&Q->read_ready, &Q->lock, &until) == ETIMEDOUT && Q->gated
+		    && Q->lastPut.tv_sec == since.tv_sec && Q->lastPut.tv_nsec == since.tv_nsec) {
+			Q->gated = 0;
+			pthread_cond_broadcast(&Q->read_ready);
+		}
 	}
 	if (Q->count == 0) {
 		pthread_mutex_unlock(&Q->lock);
 		return -1;
 	}
 
-	*item = malloc(strlen(Q->data[Q->head]) + 1);
-	strcpy(*item, Q->data[Q->head]);
-	free(Q->data[Q->head]);
-	--Q->count;
-	++Q->head;
-	if (Q->head == BQSIZE) Q->head = 0;
-	
+	take(Q, item, hint);
+
 	pthread_cond_signal(&Q->write_ready);
-	
+
 	pthread_mutex_unlock(&Q->lock);
-	
+
 	return 0;
 }
 
+// hands the oldest item (the largest, for a largest-first queue), and the ownership of it, to the caller
+int dequeue(bounded_queue_t *Q, char ** item)
+{
+	off_t hint;
+	return dequeue_hinted(Q, item, &hint);
+}
+
+// the sum of the size hints still queued
+off_t queued_bytes(bounded_queue_t *Q)
+{
+	pthread_mutex_lock(&Q->lock);
+	off_t bytes = Q->bytes;
+	pthread_mutex_unlock(&Q->lock);
+
+	return bytes;
+}
+
 int qclose(bounded_queue_t *Q)
 {
 	pthread_mutex_lock(&Q->lock);
 	Q->open = 0;
+	Q->gated = 0;
 	pthread_cond_broadcast(&Q->read_ready);
 	pthread_cond_broadcast(&Q->write_ready);
-	pthread_mutex_unlock(&Q->lock);	
+	pthread_mutex_unlock(&Q->lock);
 
 	return 0;
-}
\ No newline at end of file
+}
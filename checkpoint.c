@@ -0,0 +1,466 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+#define CHECKPOINT_MAGIC "JSDK"
+#define CHECKPOINT_VERSION 4
+#define CHECKPOINT_CORPUS_OFFSET 65536    //a multiple of every page size, so the corpus can be mapped
+
+//---------------------------------------------------------------------
+// Stopping early: cancellation, time budgets and checkpoints
+//---------------------------------------------------------------------
+
+/*
+ * The analysis threads look at a stop flag before every tile. SIGINT or
+ * SIGTERM raises it, and so does running past --time-budget. The threads then
+ * finish the tile they are on and take no more, so every tile is either done
+ * or untouched. A second SIGINT kills the process as usual.
+ *
+ * --checkpoint keeps a file that a crashed, killed or stopped run can be
+ * continued from. It is created when the analysis starts and a thread adds
+ * the results of the tiles finished since, every --checkpoint-every seconds
+ * and once more when the run stops early:
+ *
+ *     header    checkpoint_header_t
+ *     corpus    a corpus snapshot (snapshot.c) at CHECKPOINT_CORPUS_OFFSET,
+ *               for runs over the whole corpus; sharded runs have none
+ *     tiles     one block per finished tile in the order they were saved:
+ *               checkpoint_block_t, then a checkpoint_result_t per pair in
+ *               the order analyseTile writes them
+ *
+ * Blocks are only appended. They are synced before the header is rewritten
+ * to count them, so whatever the header counts is on disk, and a block torn
+ * by a crash is past the end the header records and is written over.
+ *
+ * --resume maps the embedded corpus instead of collecting the files again,
+ * rebuilds the tiles from it exactly as before and only hands out the tiles
+ * that are missing. The fingerprint (paths and summaries of the analysed
+ * documents, where the second set of a bipartite run starts, the shard, the
+ * threshold and the --metrics) must match. The header keeps that start for the resume. A run that finishes
+ * every tile and prints its results removes its checkpoint.
+ */
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t numTiles;
+    uint32_t tileSize;
+    uint64_t numPairs;
+    uint64_t fingerprint;
+    uint64_t corpusBytes;       //size of the embedded snapshot, 0 if there is none
+    uint64_t tilesOffset;       //where the first tile block starts
+    uint64_t doneTiles;         //tile blocks on disk
+    uint64_t endOffset;         //end of the last of them
+    uint64_t split;             //first --against document of the corpus, 0 if the run pairs all of them
+} checkpoint_header_t;
+
+typedef struct {
+    uint32_t tile;
+    uint32_t pairs;
+} checkpoint_block_t;
+
+typedef struct {
+    double JSD;
+    double cosine;
+    double hellinger;
+    int32_t totalWords;
+    int32_t pruned;
+    int32_t shared;
+    int32_t unused;
+} checkpoint_result_t;
+
+//set from a signal handler or by the first thread past the deadline
+volatile sig_atomic_t stopRequested = 0;
+
+typedef struct {
+    double deadline;            //monotonic seconds, 0 for no time budget
+    char *tileDone;             //one flag per tile, set once its results are in
+} run_control_t;
+
+double monotonicSeconds(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+void requestStop(int sig){
+    (void) sig;
+    stopRequested = 1;
+}
+
+static struct sigaction savedInt, savedTerm;
+
+/**
+ * purpose: make SIGINT and SIGTERM stop the analysis instead of the process.
+ * The handlers reset themselves, so a second signal still kills it. A signal
+ * the process was started ignoring (nohup, background jobs) stays ignored.
+ */
+void installStopHandlers(void){
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = requestStop;
+    action.sa_flags = SA_RESETHAND;
+    sigemptyset(&action.sa_mask);
+
+    sigaction(SIGINT, NULL, &savedInt);
+    sigaction(SIGTERM, NULL, &savedTerm);
+    if(savedInt.sa_handler != SIG_IGN) sigaction(SIGINT, &action, NULL);
+    if(savedTerm.sa_handler != SIG_IGN) sigaction(SIGTERM, &action, NULL);
+}
+
+void restoreStopHandlers(void){
+    sigaction(SIGINT, &savedInt, NULL);
+    sigaction(SIGTERM, &savedTerm, NULL);
+}
+
+/**
+ * purpose: whether the threads should take no more tiles.
+ */
+int shouldStop(run_control_t *control){
+    if(stopRequested) return 1;
+    if(control->deadline > 0 && monotonicSeconds() >= control->deadline){
+        stopRequested = 1;
+        return 1;
+    }
+    return 0;
+}
+
+static inline void markTileDone(run_control_t *control, pair_tile_t *tile){
+    __atomic_store_n(&control->tileDone[tile->id], 1, __ATOMIC_RELEASE);
+}
+
+static inline int tileIsDone(run_control_t *control, int id){
+    return __atomic_load_n(&control->tileDone[id], __ATOMIC_ACQUIRE);
+}
+
+/**
+ * purpose: a hash of everything the tiles and their results depend on.
+ */
+uint64_t runFingerprint(FileAndList **docs, int numDocs, int split, int shardIndex, int shardCount, double threshold,
+                        int metrics){
+    uint64_t h = 14695981039346656037ULL;
+    h = fnvBytes(h, &numDocs, sizeof(numDocs));
+    h = fnvBytes(h, &split, sizeof(split));
+    h = fnvBytes(h, &shardIndex, sizeof(shardIndex));
+    h = fnvBytes(h, &shardCount, sizeof(shardCount));
+    h = fnvBytes(h, &threshold, sizeof(threshold));
+    h = fnvBytes(h, &metrics, sizeof(metrics));
+    for(int i = 0; i < numDocs; i++){
+        h = fnvBytes(h, docs[i]->filepath, strlen(docs[i]->filepath) + 1);
+        h = fnvBytes(h, &docs[i]->summary.vocabSize, sizeof(int));
+        h = fnvBytes(h, &docs[i]->summary.mass, sizeof(double));
+        h = fnvBytes(h, docs[i]->summary.topMass, sizeof(double) * TOPK);
+    }
+    return h;
+}
+
+typedef struct {
+    int fd;                     //the checkpoint, open for appending blocks
+    char *path;
+    checkpoint_header_t header;
+    char *saved;                //one flag per tile, set once its block is on disk
+    pair_tile_t *tiles;
+    int numTiles;
+    final_struct *fs;
+    run_control_t *control;
+    double interval;            //seconds between saves
+    int finished;
+    pthread_t tid;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+} checkpoint_writer_t;
+
+/**
+ * purpose: read and check the header of the checkpoint at path.
+ */
+int readCheckpointHeader(const char *path, checkpoint_header_t *header){
+    FILE *in = fopen(path, "rb");
+    if(in == NULL){
+        perror(path);
+        return -1;
+    }
+    int err = (fread(header, sizeof(*header), 1, in) != 1);
+    fclose(in);
+    if(err || memcmp(header->magic, CHECKPOINT_MAGIC, 4) != 0 || header->version != CHECKPOINT_VERSION){
+        fprintf(stderr, "ERROR: %s is not a checkpoint\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * purpose: fill the results of the tiles saved in the checkpoint at path and
+ * flag them in control. The names and pair indices come from docs, like
+ * analyseTile.
+ */
+int readCheckpoint(const char *path, uint64_t fingerprint, pair_tile_t *tiles, int numTiles,
+                   long numPairs, run_control_t *control, final_struct *fs, FileAndList **docs, int numDocs,
+                   int split){
+    checkpoint_header_t header;
+    if(readCheckpointHeader(path, &header)) return -1;
+    if(header.fingerprint != fingerprint || header.numTiles != (uint32_t) numTiles
+       || header.tileSize != TILESIZE || header.numPairs != (uint64_t) numPairs){
+        fprintf(stderr, "ERROR: %s belongs to a different run (other files, contents, -t, --metrics, --against or --shard)\n", path);
+        return -1;
+    }
+
+    FILE *in = fopen(path, "rb");
+    if(in == NULL || fseeko(in, header.tilesOffset, SEEK_SET)){
+        perror(path);
+        if(in != NULL) fclose(in);
+        return -1;
+    }
+
+    int err = 0;
+    for(uint64_t b = 0; b < header.doneTiles && !err; b++){
+        checkpoint_block_t block;
+        if(fread(&block, sizeof(block), 1, in) != 1 || block.tile >= (uint32_t) numTiles
+           || block.pairs != tilePairs(&tiles[block.tile]) || control->tileDone[block.tile]){
+            err = 1;
+            break;
+        }
+        pair_tile_t *tile = &tiles[block.tile];
+        long w = tile->base;
+        for(int i = tile->rowStart; i < tile->rowEnd && !err; i++){
+            int j = (tile->colStart > i + 1) ? tile->colStart : i + 1;
+            for(; j < tile->colEnd; j++, w++){
+                checkpoint_result_t record;
+                if(fread(&record, sizeof(record), 1, in) != 1){
+                    err = 1;
+                    break;
+                }
+                fs[w].filepath1 = docs[i]->filepath;
+                fs[w].filepath2 = docs[j]->filepath;
+                fs[w].pairIndex = runPairIndex(i, j, numDocs, split);
+                fs[w].JSD = record.JSD;
+                fs[w].totalWords = record.totalWords;
+                fs[w].pruned = record.pruned;
+                fs[w].shared = record.shared;
+                fs[w].cosine = record.cosine;
+                fs[w].hellinger = record.hellinger;
+            }
+        }
+        control->tileDone[block.tile] = 1;
+    }
+    fclose(in);
+
+    if(err){
+        fprintf(stderr, "ERROR: %s is corrupt\n", path);
+        memset(control->tileDone, 0, numTiles);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * purpose: append a block for every tile finished since the last save, sync
+ * them, then rewrite the header to count them.
+ */
+int saveCheckpoint(checkpoint_writer_t *writer){
+    checkpoint_header_t *header = &writer->header;
+    uint64_t end = header->endOffset;
+    uint64_t added = 0;
+    int err = 0;
+
+    for(int t = 0; t < writer->numTiles && !err; t++){
+        if(writer->saved[t] || !tileIsDone(writer->control, t)) continue;
+
+        pair_tile_t *tile = &writer->tiles[t];
+        long pairs = tilePairs(tile);
+        size_t bytes = sizeof(checkpoint_block_t) + sizeof(checkpoint_result_t) * pairs;
+        unsigned char *buf = malloc(bytes);
+        checkpoint_block_t block = { (uint32_t) t, (uint32_t) pairs };
+        memcpy(buf, &block, sizeof(block));
+        checkpoint_result_t *records = (checkpoint_result_t *) (buf + sizeof(block));
+        for(long p = 0; p < pairs; p++){
+            final_struct *result = &writer->fs[tile->base + p];
+            records[p].JSD = result->JSD;
+            records[p].totalWords = result->totalWords;
+            records[p].pruned = result->pruned;
+            records[p].shared = result->shared;
+            records[p].cosine = result->cosine;
+            records[p].hellinger = result->hellinger;
+            records[p].unused = 0;
+        }
+        err = (pwrite(writer->fd, buf, bytes, end) != (ssize_t) bytes);
+        free(buf);
+        if(!err){
+            end += bytes;
+            added++;
+            writer->saved[t] = 2;       //on disk, not yet counted by the header
+        }
+    }
+
+    checkpoint_header_t before = *header;
+    if(added > 0 && !err){
+        err = fdatasync(writer->fd);
+        if(!err){
+            header->doneTiles += added;
+            header->endOffset = end;
+            err = (pwrite(writer->fd, header, sizeof(*header), 0) != (ssize_t) sizeof(*header))
+                  || fdatasync(writer->fd);
+        }
+    }
+
+    //after a failed save the blocks are written again from the old end
+    for(int t = 0; t < writer->numTiles; t++){
+        if(writer->saved[t] == 2) writer->saved[t] = err ? 0 : 1;
+    }
+    if(err){
+        *header = before;
+        perror(writer->path);
+        return -1;
+    }
+    return 0;
+}
+
+void* checkpointThreadTask(void* arg){
+    checkpoint_writer_t *writer = arg;
+    pthread_mutex_lock(&writer->lock);
+    while(!writer->finished){
+        struct timespec until;
+        clock_gettime(CLOCK_REALTIME, &until);
+        until.tv_sec += (time_t) writer->interval;
+        until.tv_nsec += (long) ((writer->interval - (time_t) writer->interval) * 1e9);
+        if(until.tv_nsec >= 1000000000L){
+            until.tv_sec++;
+            until.tv_nsec -= 1000000000L;
+        }
+        while(!writer->finished && pthread_cond_timedwait(&writer->wake, &writer->lock, &until) != ETIMEDOUT);
+        if(writer->finished) break;
+
+        pthread_mutex_unlock(&writer->lock);
+        saveCheckpoint(writer);
+        pthread_mutex_lock(&writer->lock);
+    }
+    pthread_mutex_unlock(&writer->lock);
+    return NULL;
+}
+
+int sameFile(const char *a, const char *b){
+    struct stat x, y;
+    return stat(a, &x) == 0 && stat(b, &y) == 0 && x.st_dev == y.st_dev && x.st_ino == y.st_ino;
+}
+
+/**
+ * purpose: create the checkpoint at path, holding the corpus when corpus is
+ * given (split is where its --against set starts), or carry on with it if
+ * it is the file the run resumed from. Then
+ * save the tiles already done and start saving every interval seconds.
+ */
+int openCheckpoint(checkpoint_writer_t *writer, const char *path, const char *resumePath, uint64_t fingerprint,
+                   pair_tile_t *tiles, int numTiles, long numPairs, run_control_t *control, final_struct *fs,
+                   repository *corpus, int split, vocabulary_t *vocab, double interval){
+    writer->path = malloc(strlen(path) + 1);
+    strcpy(writer->path, path);
+    writer->saved = calloc(numTiles + 1, 1);
+    writer->tiles = tiles;
+    writer->numTiles = numTiles;
+    writer->fs = fs;
+    writer->control = control;
+    writer->interval = interval;
+    writer->finished = 0;
+    writer->fd = -1;
+
+    if(resumePath != NULL && sameFile(path, resumePath)){
+        //everything the run resumed with is in the file already
+        writer->fd = open(path, O_RDWR);
+        if(writer->fd == -1 || pread(writer->fd, &writer->header, sizeof(writer->header), 0)
+                               != (ssize_t) sizeof(writer->header)){
+            perror(path);
+        } else {
+            memcpy(writer->saved, control->tileDone, numTiles);
+        }
+    } else {
+        checkpoint_header_t *header = &writer->header;
+        memset(header, 0, sizeof(*header));
+        memcpy(header->magic, CHECKPOINT_MAGIC, 4);
+        header->version = CHECKPOINT_VERSION;
+        header->numTiles = numTiles;
+        header->tileSize = TILESIZE;
+        header->numPairs = numPairs;
+        header->fingerprint = fingerprint;
+        header->split = split;
+
+        char *temp = malloc(strlen(path) + 5);
+        sprintf(temp, "%s.tmp", path);
+        FILE *out = fopen(temp, "wb");
+        int err = (out == NULL);
+        uint64_t offset = 0;
+        if(!err && corpus != NULL){
+            //a mapped corpus is copied as it is, a collected one written out
+            err = writePadding(out, &offset, CHECKPOINT_CORPUS_OFFSET);
+            if(!err && corpus->snapshot != NULL){
+                header->corpusBytes = corpus->snapshot->size;
+                err = copySnapshot(corpus->snapshot, out);
+                offset += corpus->snapshot->size;
+            } else if(!err){
+                err = writeSnapshot(out, corpus, vocab, tokenRules, ngramSize, &header->corpusBytes);
+                offset += header->corpusBytes;
+            }
+        }
+        header->tilesOffset = (corpus != NULL) ? alignOffset(offset, 8) : sizeof(*header);
+        header->endOffset = header->tilesOffset;
+        if(!err){
+            err = fseeko(out, 0, SEEK_SET) || fwrite(header, sizeof(*header), 1, out) != 1 || fflush(out)
+                  || fsync(fileno(out));
+        }
+        if(!err){
+            writer->fd = dup(fileno(out));
+        }
+        if(out != NULL && fclose(out)) err = 1;
+        if(!err && (writer->fd == -1 || rename(temp, path))) err = 1;
+        if(err){
+            perror(temp);
+            unlink(temp);
+            if(writer->fd != -1) close(writer->fd);
+            writer->fd = -1;
+        }
+        free(temp);
+    }
+
+    if(writer->fd == -1){
+        free(writer->path);
+        free(writer->saved);
+        return -1;
+    }
+
+    pthread_mutex_init(&writer->lock, NULL);
+    pthread_cond_init(&writer->wake, NULL);
+    if(saveCheckpoint(writer) == 0 && interval > 0){
+        pthread_create(&writer->tid, NULL, checkpointThreadTask, writer);
+    } else {
+        writer->finished = 1;
+    }
+    return 0;
+}
+
+/**
+ * purpose: stop the saving thread and, unless every tile is done (the caller
+ * then removes the file), save the last tiles. Returns -1 if that failed.
+ */
+int closeCheckpoint(checkpoint_writer_t *writer, int complete){
+    pthread_mutex_lock(&writer->lock);
+    int running = !writer->finished;
+    writer->finished = 1;
+    pthread_cond_signal(&writer->wake);
+    pthread_mutex_unlock(&writer->lock);
+    if(running) pthread_join(writer->tid, NULL);
+
+    int err = complete ? 0 : saveCheckpoint(writer);
+
+    close(writer->fd);
+    pthread_mutex_destroy(&writer->lock);
+    pthread_cond_destroy(&writer->wake);
+    free(writer->path);
+    free(writer->saved);
+    return err;
+}
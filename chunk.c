@@ -0,0 +1,447 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/types.h>
+
+#ifndef CHUNKBYTES
+#define CHUNKBYTES (16 * 1024 * 1024)
+#endif
+#define CHUNKBUF (64 * 1024)
+
+//---------------------------------------------------------------------
+// Word tables: hash counting for big files
+//---------------------------------------------------------------------
+
+typedef struct {
+    char *word;
+    uint64_t hash;
+    uint64_t count;
+} wordEntry;
+
+typedef struct {
+    wordEntry *entries;
+    size_t used;
+    size_t capacity;    //always a power of two
+} wordtable_t;
+
+int init_wordtable(wordtable_t *table){
+    table->used = 0;
+    table->capacity = 1024;
+    table->entries = calloc(table->capacity, sizeof(wordEntry));
+    return (table->entries == NULL);
+}
+
+void destroy_wordtable(wordtable_t *table){
+    for(size_t i = 0; i < table->capacity; i++){
+        free(table->entries[i].word);
+    }
+    free(table->entries);
+}
+
+/**
+ * purpose: add count occurrences of a word. If owned is set the table takes
+ * the word's memory instead of copying it.
+ */
+void wordtable_add(wordtable_t *table, char *word, uint64_t hash, uint64_t count, int owned){
+    if(2 * (table->used + 1) > table->capacity){
+        size_t capacity = 2 * table->capacity;
+        wordEntry *entries = calloc(capacity, sizeof(wordEntry));
+        if(entries == NULL){
+            perror("word table resize failed");
+            abort();
+        }
+        for(size_t i = 0; i < table->capacity; i++){
+            if(table->entries[i].word == NULL) continue;
+            size_t slot = table->entries[i].hash & (capacity - 1);
+            while(entries[slot].word != NULL) slot = (slot + 1) & (capacity - 1);
+            entries[slot] = table->entries[i];
+        }
+        free(table->entries);
+        table->entries = entries;
+        table->capacity = capacity;
+    }
+
+    size_t mask = table->capacity - 1;
+    size_t slot = hash & mask;
+    while(table->entries[slot].word != NULL){
+        if(table->entries[slot].hash == hash && strcmp(table->entries[slot].word, word) == 0){
+            table->entries[slot].count += count;
+            if(owned) free(word);
+            return;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    if(!owned){
+        char *copy = malloc(strlen(word) + 1);
+        strcpy(copy, word);
+        word = copy;
+    }
+    table->entries[slot].word = word;
+    table->entries[slot].hash = hash;
+    table->entries[slot].count = count;
+    table->used++;
+}
+
+/**
+ * purpose: move every word of from into to, leaving from empty.
+ */
+void wordtable_merge(wordtable_t *to, wordtable_t *from){
+    for(size_t i = 0; i < from->capacity; i++){
+        if(from->entries[i].word == NULL) continue;
+        wordtable_add(to, from->entries[i].word, from->entries[i].hash, from->entries[i].count, 1);
+        from->entries[i].word = NULL;
+    }
+    from->used = 0;
+}
+
+/**
+ * purpose: turn a table into a List with its WFD computed, emptying the table.
+ * The list comes back unsorted like the ones fillList builds.
+ */
+List *wordtable_to_list(wordtable_t *table, uint64_t word_count){
+    List *head = NULL;
+    for(size_t i = 0; i < table->capacity; i++){
+        if(table->entries[i].word == NULL) continue;
+        List *node = malloc(sizeof(List));
+        node->word = table->entries[i].word;
+        node->frequency = table->entries[i].count;
+        node->WFD = (double) node->frequency / word_count;
+        node->next = head;
+        head = node;
+        table->entries[i].word = NULL;
+    }
+    table->used = 0;
+    return head;
+}
+
+//---------------------------------------------------------------------
+// Chunk pool: the threads that help count the ranges of big files
+//---------------------------------------------------------------------
+
+/*
+ * Every file over CHUNKBYTES becomes a chunk job. The thread reading the
+ * file counts its ranges itself, and up to threads - 1 workers of one pool
+ * shared by the whole process help it: a worker joins a job that still has
+ * ranges to hand out and fewer helpers than it asked for, stays with it
+ * until its ranges are all handed out, then looks for the next job. So the
+ * threads counting ranges are the -f file threads plus at most -f - 1 pool
+ * workers, however many big files are read at once.
+ *
+ * The pool starts with the first job that wants help and grows to the most
+ * helpers any job has asked for. Its workers never take signals, and stay
+ * parked between jobs until stop_chunk_pool joins them.
+ */
+
+typedef struct chunk_job_t {
+    int numChunks;
+    int nextChunk;              //the next range to hand out
+    int doneChunks;             //ranges counted
+    int helpers;                //pool workers that joined, each given its own slot
+    int maxHelpers;
+    void (*run)(struct chunk_job_t *job, int slot, int chunk);     //count one range; slot maxHelpers is the owner's
+    void *ctx;
+    pthread_cond_t finished;
+    struct chunk_job_t *next;
+} chunk_job_t;
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t work;
+    chunk_job_t *jobs;          //jobs that may still have ranges to hand out
+    pthread_t *tids;
+    int numWorkers;
+    int stop;
+} chunk_pool_t;
+
+static chunk_pool_t chunkPool = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, NULL, NULL, 0, 0 };
+
+//count the ranges of job left to hand out, with the pool lock held
+static void workChunks(chunk_job_t *job, int slot){
+    while(job->nextChunk < job->numChunks){
+        int chunk = job->nextChunk++;
+        pthread_mutex_unlock(&chunkPool.lock);
+        job->run(job, slot, chunk);
+        pthread_mutex_lock(&chunkPool.lock);
+        if(++job->doneChunks == job->numChunks){
+            pthread_cond_broadcast(&job->finished);
+        }
+    }
+}
+
+void* chunkWorkerTask(void* arg){
+    (void) arg;
+    pthread_mutex_lock(&chunkPool.lock);
+    while(!chunkPool.stop){
+        chunk_job_t *job = chunkPool.jobs;
+        while(job != NULL && (job->nextChunk >= job->numChunks || job->helpers >= job->maxHelpers)){
+            job = job->next;
+        }
+        if(job == NULL){
+            pthread_cond_wait(&chunkPool.work, &chunkPool.lock);
+            continue;
+        }
+        workChunks(job, job->helpers++);
+    }
+    pthread_mutex_unlock(&chunkPool.lock);
+    return NULL;
+}
+
+//grow the pool to at least workers threads, with the pool lock held
+static void growChunkPool(int workers){
+    if(workers <= chunkPool.numWorkers) return;
+    chunkPool.tids = realloc(chunkPool.tids, sizeof(pthread_t) * workers);
+
+    //whatever signals the process handles go to the threads that wait for them
+    sigset_t all, previous;
+    sigfillset(&all);
+    pthread_sigmask(SIG_BLOCK, &all, &previous);
+    while(chunkPool.numWorkers < workers){
+        if(pthread_create(&chunkPool.tids[chunkPool.numWorkers], NULL, chunkWorkerTask, NULL)) break;
+        chunkPool.numWorkers++;
+    }
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+}
+
+/**
+ * purpose: run every range of job, on the calling thread and up to
+ * threads - 1 pool workers, returning once all of them are counted. The
+ * caller sets numChunks, run and ctx; run gets a slot below threads that
+ * no other thread uses for this job at the same time.
+ */
+void runChunkJob(chunk_job_t *job, int threads){
+    job->nextChunk = 0;
+    job->doneChunks = 0;
+    job->helpers = 0;
+    job->maxHelpers = ((threads < job->numChunks) ? threads : job->numChunks) - 1;
+    if(job->maxHelpers < 0) job->maxHelpers = 0;
+    pthread_cond_init(&job->finished, NULL);
+
+    pthread_mutex_lock(&chunkPool.lock);
+    if(job->maxHelpers > 0){
+        growChunkPool(job->maxHelpers);
+        job->next = chunkPool.jobs;
+        chunkPool.jobs = job;
+        pthread_cond_broadcast(&chunkPool.work);
+    }
+    workChunks(job, job->maxHelpers);
+    while(job->doneChunks < job->numChunks){
+        pthread_cond_wait(&job->finished, &chunkPool.lock);
+    }
+    if(job->maxHelpers > 0){
+        chunk_job_t **link = &chunkPool.jobs;
+        while(*link != job) link = &(*link)->next;
+        *link = job->next;
+    }
+    pthread_mutex_unlock(&chunkPool.lock);
+    pthread_cond_destroy(&job->finished);
+}
+
+/**
+ * purpose: stop and join the pool's workers. Nothing may be running a job.
+ */
+void stop_chunk_pool(void){
+    pthread_mutex_lock(&chunkPool.lock);
+    chunkPool.stop = 1;
+    pthread_cond_broadcast(&chunkPool.work);
+    pthread_mutex_unlock(&chunkPool.lock);
+    for(int i = 0; i < chunkPool.numWorkers; i++){
+        pthread_join(chunkPool.tids[i], NULL);
+    }
+    free(chunkPool.tids);
+    chunkPool.tids = NULL;
+    chunkPool.numWorkers = 0;
+    chunkPool.stop = 0;
+}
+
+//---------------------------------------------------------------------
+// Chunked tokenization
+//---------------------------------------------------------------------
+
+/*
+ * A big file is cut into CHUNKBYTES ranges. A word (a run of characters that
+ * are not separators, as in fillList) belongs to the range its first
+ * character starts in: a range skips
+ * the tail of a word that started before it, and finishes its own last word
+ * even if that runs past the end of the range. Every thread on the file
+ * counts into its own word table, so memory grows with the distinct words,
+ * not the file. Counts are 64 bits wide, for files of any size.
+ */
+
+typedef struct {
+    int fd;
+    off_t size;
+    int numChunks;
+    int rules;              //the tokenizer rules the ranges are read with
+} chunked_file_t;
+
+//the range [start, end) chunk covers
+void chunkBounds(const chunked_file_t *file, int chunk, off_t *start, off_t *end){
+    *start = (off_t) chunk * CHUNKBYTES;
+    *end = (chunk + 1 == file->numChunks) ? file->size : *start + CHUNKBYTES;
+}
+
+typedef struct {
+    wordtable_t *table;
+    uint64_t *word_count;
+} tableWords;
+
+void countWord(void *ctx, char *word){
+    tableWords *words = ctx;
+    wordtable_add(words->table, word, hashWord(word), 1, 0);
+    (*words->word_count)++;
+}
+
+enum { RANGE_SKIP, RANGE_BODY, RANGE_TAIL, RANGE_DONE };
+
+/**
+ * purpose: hand every word starting in [start, end) of fd to emit, in order.
+ */
+void tokenizeRange(int fd, off_t start, off_t end, off_t size, int rules, void (*emit)(void *ctx, char *word), void *ctx){
+    unsigned char *buf = malloc(CHUNKBUF);
+    tokenizer_t tok;
+    init_tokenizer(&tok, rules, emit, ctx);
+
+    //both ranges around a boundary move it the same way, off any multibyte character
+    start = tokenBoundary(fd, start, size, rules);
+    end = tokenBoundary(fd, end, size, rules);
+    off_t pos = start;
+
+    //a range that starts in the middle of a word leaves it to the previous range
+    int phase = RANGE_BODY;
+    if(start > 0 && tokenKindBefore(fd, start, rules) != TOKEN_SEPARATOR){
+        phase = RANGE_SKIP;
+    }
+
+    while(phase != RANGE_DONE){
+        //the word running past end is finished character by character
+        if(phase == RANGE_BODY && pos >= end){
+            phase = tok.inWord ? RANGE_TAIL : RANGE_DONE;
+            continue;
+        }
+
+        ssize_t bytes_read = pread(fd, buf, CHUNKBUF, pos);
+        if(bytes_read <= 0) break;
+        int atEnd = (bytes_read < CHUNKBUF || pos + bytes_read >= size);
+        size_t i = 0;
+
+        if(phase == RANGE_BODY){
+            //end is a character boundary, so the text stops there as far as this range is concerned
+            size_t limit = (end - pos < bytes_read) ? (size_t) (end - pos) : (size_t) bytes_read;
+            i = tokenize(&tok, buf, limit, atEnd || pos + (off_t) limit == end);
+        } else {
+            token_char_t ch;
+            size_t length;
+            while(i < (size_t) bytes_read && (length = tokenChar(rules, buf + i, bytes_read - i, atEnd, &ch)) > 0){
+                i += length;
+                if(ch.kind == TOKEN_SEPARATOR){
+                    phase = (phase == RANGE_SKIP) ? RANGE_BODY : RANGE_DONE;
+                    break;
+                }
+                if(phase == RANGE_TAIL) tokenAppend(&tok.word, &ch);
+            }
+        }
+        pos += i;
+    }
+
+    tokenEndWord(&tok);
+    destroy_tokenizer(&tok);
+    free(buf);
+}
+
+/**
+ * purpose: count the words starting in [start, end) of fd into table.
+ */
+void countRange(int fd, off_t start, off_t end, off_t size, int rules, wordtable_t *table, uint64_t *word_count){
+    tableWords words = { table, word_count };
+    tokenizeRange(fd, start, end, size, rules, countWord, &words);
+}
+
+//one slot's word table and count, for fillListChunked
+typedef struct {
+    wordtable_t table;
+    uint64_t word_count;
+    int used;
+} chunkSlot;
+
+typedef struct {
+    chunked_file_t *file;
+    chunkSlot *slots;
+} chunkedList;
+
+void countChunk(chunk_job_t *job, int slot, int chunk){
+    chunkedList *list = job->ctx;
+    chunkSlot *mine = &list->slots[slot];
+    if(!mine->used){
+        init_wordtable(&mine->table);
+        mine->word_count = 0;
+        mine->used = 1;
+    }
+    off_t start, end;
+    chunkBounds(list->file, chunk, &start, &end);
+    countRange(list->file->fd, start, end, list->file->size, list->file->rules, &mine->table, &mine->word_count);
+}
+
+/**
+ * purpose: the chunked version of fillList, for files bigger than CHUNKBYTES.
+ * The ranges are counted on up to threads threads (the calling thread and
+ * chunk pool workers) and their word tables are merged at the end.
+ */
+void fillListChunked(List **listOne, int fd, off_t size, int threads, int rules){
+    chunked_file_t file;
+    file.fd = fd;
+    file.size = size;
+    file.rules = rules;
+    file.numChunks = (int) ((size + CHUNKBYTES - 1) / CHUNKBYTES);
+    if(threads > file.numChunks) threads = file.numChunks;
+    if(threads < 1) threads = 1;
+
+    chunkedList list = { &file, calloc(threads, sizeof(chunkSlot)) };
+    chunk_job_t job;
+    job.numChunks = file.numChunks;
+    job.run = countChunk;
+    job.ctx = &list;
+    runChunkJob(&job, threads);
+
+    //the owner's slot is the last one, and the others are merged into it
+    chunkSlot *into = &list.slots[threads - 1];
+    if(!into->used){
+        init_wordtable(&into->table);
+        into->word_count = 0;
+    }
+    for(int i = 0; i < threads - 1; i++){
+        if(!list.slots[i].used) continue;
+        wordtable_merge(&into->table, &list.slots[i].table);
+        into->word_count += list.slots[i].word_count;
+        destroy_wordtable(&list.slots[i].table);
+    }
+
+    *listOne = wordtable_to_list(&into->table, into->word_count);
+
+    destroy_wordtable(&into->table);
+    free(list.slots);
+}
+
+/**
+ * purpose: fillList for text already in memory.
+ */
+List *listFromBuffer(const char *data, size_t length, int rules){
+    wordtable_t table;
+    uint64_t word_count = 0;
+    tableWords words = { &table, &word_count };
+    tokenizer_t tok;
+    init_wordtable(&table);
+    init_tokenizer(&tok, rules, countWord, &words);
+
+    tokenize(&tok, (const unsigned char *) data, length, 1);
+    tokenEndWord(&tok);
+
+    List *list = wordtable_to_list(&table, word_count);
+    destroy_wordtable(&table);
+    destroy_tokenizer(&tok);
+    return list;
+}
@@ -1,3 +1,4 @@
+#define _GNU_SOURCE
 #include <stdio.h>
 #include <stdlib.h>
 #include <pthread.h>
@@ -12,37 +13,75 @@
 #include <ctype.h>
 #include "unboundedQ.c"
 #include "boundedQ.c"
-#include "repo.c"
+#include "engine.c"
+
+//the words compare reads: --rules, and -n words per n-gram (1 for plain words);
+//set before any thread reads a file
+int tokenRules = RULES_DEFAULT;
+int ngramSize = 1;
+
+#include "shard.c"
+#include "dedup.c"
+#include "numa.c"
+#include "checkpoint.c"
+#include "vcache.c"
+#include "membudget.c"
+#include "server.c"
+#include "watch.c"
 
 int exit_status;
+int verbose;            //--verbose: report what the optimizations did on stderr
 
 typedef struct {
     unbounded_queue_t *dQ;
     bounded_queue_t *fQ;
     char* fileSuffix;
+    memory_budget_t *budget;    //NULL unless --max-memory was given
     int id;
 } dirThreadArgs;
 
 typedef struct {
     bounded_queue_t *fQ;
     repository *repos;
+    vocabulary_t *vocab;    //NULL unless compact vectors are enabled
     char* fileSuffix;
+    int deferLoad;          //only record the path, the file is read after the documents are sorted
+    dedup_table_t *dedup;   //NULL unless identical files should share one document
+    int chunkThreads;       //threads that may share one big file
+    memory_budget_t *budget;    //NULL unless --max-memory was given
     int id;
 } fileThreadArgs;
 
 typedef struct {
-    char *filepath1;
-    char *filepath2;
-    int totalWords;
-    double JSD;
-} final_struct;
+    FileAndList **docs;
+    char *needed;
+    int numDocs;
+    vocabulary_t *vocab;
+    int chunkThreads;
+    int stride;
+    int id;
+} loadThreadArgs;
 
 typedef struct {
     analysis_queue_t *aQ;
     final_struct *fs;
+    FileAndList **docs;
+    int numDocs;
+    int split;                      //first column document of a bipartite run, 0 for all pairs
+    double threshold;
+    int metrics;                    //METRIC_ flags to compute besides the JSD
+    long pruned;
+    numa_topology_t *numa;          //only set in NUMA runs
+    numa_schedule_t *schedule;
+    int node;
+    run_control_t *control;         //stop flag, deadline and finished tiles
+    vector_cache_t *cache;          //only set out of core
     int id;
 } analysisThreadArgs;
 
+//slack on the pruning bound so rounding in calculateJSD never changes the output
+#define PRUNE_EPSILON 1e-9
+
 /**
  * purpose: retrieve the data passed in with the option(s).
  */ 
@@ -57,7 +96,7 @@ void obtainSuffix(char* input, char** outputLocation){
 
 /**
  * Purpose: see if the specified suffix is at the end of the 
- * given string
+ * given string, or of its name without a .gz extension
  * 
  * Return values:
  * 1 if suffix is at the end of str
@@ -65,33 +104,48 @@ void obtainSuffix(char* input, char** outputLocation){
  * -1 if error occured
  */ 
 int strSuffixCmp(char* str, char* suffix){
-    int result = 1;
-
     int suffixLength = strlen(suffix);
     assert(suffixLength >= 0);
-    int strLength = strlen(str);
-    assert(strLength >= 0);
-    int expectedSuffixLocation = strLength - suffixLength;
-    for(int i = expectedSuffixLocation; i < strLength; i++){
-        if( (tolower(str[i])) == (tolower(suffix[i - expectedSuffixLocation])) ){
-            //current character match, so keep going
-        } else {
-            //the current characters match, we can stop and return false (0).
-            return 0;
+    int fullLength = strlen(str);
+    assert(fullLength >= 0);
+
+    //compressed files also match by the name they decompress to
+    int lengths[2] = { fullLength, (int) uncompressedLength(str) };
+    for(int n = 0; n < 2; n++){
+        int strLength = lengths[n];
+        int expectedSuffixLocation = strLength - suffixLength;
+        if (expectedSuffixLocation < 0) continue;
+        int result = 1;
+        for(int i = expectedSuffixLocation; i < strLength; i++){
+            if( (tolower(str[i])) != (tolower(suffix[i - expectedSuffixLocation])) ){
+                //the current characters differ, so this name does not end with the suffix
+                result = 0;
+                break;
+            }
         }
+        if (result) return 1;
     }
 
-    return result;
+    return 0;
+}
+
+/**
+ * purpose: a path for a directory entry, allocated once at its final size.
+ * The queues pass it on without copying and it ends up as the document's
+ * filepath.
+ */
+char *childPath(const char *dirPath, size_t dirLength, const char *name){
+    size_t nameLength = strlen(name);
+    char *path = malloc(dirLength + nameLength + 2);
+    memcpy(path, dirPath, dirLength);
+    path[dirLength] = '/';
+    memcpy(path + dirLength + 1, name, nameLength + 1);
+    return path;
 }
 
 void* dirThreadTask(void* arg){
     dirThreadArgs *args = arg;
 
-    //dequeue the directory
-    unbounded_queue_t * Q = arg;
-    bounded_queue_t fQ;
-    init_bounded(&fQ);
-
     while(args->dQ->activeThreads > 0){
         char* dirPath;
 
@@ -117,39 +171,40 @@ void* dirThreadTask(void* arg){
             DIR *dirStruct;
             struct dirent *dirEntry;
             dirStruct = opendir(dirPath);
+            size_t dirLength = strlen(dirPath);
 
             if(dirStruct){
 
                 while((dirEntry = readdir(dirStruct))){
 
-                    char* directoryPath = malloc(strlen(dirPath) + 1);
-                    strcpy(directoryPath, dirPath);
-
                     //skip any files beginning with a period
                     if ((strncmp(dirEntry->d_name, ".", 1) == 0)){
-                        free(directoryPath);
                         continue;
                     }
 
-                    //check what type of file were dealing with
+                    //check what type of file were dealing with; the queues own the new paths
                     if(dirEntry->d_type == DT_DIR){
                         //its a directory
-                        int path_size = strlen(directoryPath) + strlen(dirEntry->d_name) + 2;
-                        char* new_path = malloc(sizeof(char)*path_size);
-                        strcpy(new_path, directoryPath);
-                        strcat(new_path, "/");
-                        strcat(new_path, dirEntry->d_name);
-                        enqueue_unbounded(args->dQ, new_path);
-                        free(new_path);
+                        char *new_path = childPath(dirPath, dirLength, dirEntry->d_name);
+                        chargeMemory(args->budget, pathCost(new_path));
+                        if(enqueue_unbounded(args->dQ, new_path)){
+                            releaseMemory(args->budget, pathCost(new_path));
+                            free(new_path);
+                        }
 
                     } else if(dirEntry->d_type == DT_REG){
                         //regular file
                         if(strSuffixCmp(dirEntry->d_name, args->fileSuffix)){
-                            char* temp = malloc(strlen(dirEntry->d_name) + strlen(directoryPath) + 2);
-                            strcpy(temp, directoryPath);
-                            strcat(temp, "/");
-                            strcat(temp, dirEntry->d_name);
-                            enqueue(args->fQ, temp);
+                            //its size orders the file queue, largest first
+                            struct stat fileData;
+                            off_t size = fstatat(dirfd(dirStruct), dirEntry->d_name, &fileData, 0) ? -1
+                                                                                                   : fileData.st_size;
+                            char *temp = childPath(dirPath, dirLength, dirEntry->d_name);
+                            chargeMemory(args->budget, pathCost(temp));
+                            if(enqueue_hinted(args->fQ, temp, size)){
+                                releaseMemory(args->budget, pathCost(temp));
+                                free(temp);
+                            }
                         }
 
                     } else {
@@ -157,8 +212,6 @@ void* dirThreadTask(void* arg){
                         continue;
                     }
 
-                    free(directoryPath);
-
                 }
 
                 if (closedir(dirStruct)){
@@ -173,6 +226,7 @@ void* dirThreadTask(void* arg){
 
         }
 
+        releaseMemory(args->budget, pathCost(dirPath));
         free(dirPath);        
         
     }
@@ -189,168 +243,358 @@ void* fileThreadTask(void* arg){
         char* fileName;     
         
 
-        if(dequeue(args->fQ, &fileName)){
+        off_t sizeHint;
+        if(dequeue_hinted(args->fQ, &fileName, &sizeHint)){
             //all the work is done, so end this thread
             return NULL;
         }
 
-        //create a new list & open the file from the queue
-        List * listOne = NULL;
+        //a file that is a large share of the bytes not yet started gets that share of the threads
+        int chunkThreads = args->chunkThreads;
+        if (sizeHint >= 0){
+            off_t left = sizeHint + queued_bytes(args->fQ);
+            chunkThreads = (left > 0) ? (int) ceil((double) args->chunkThreads * sizeHint / left) : 1;
+            if (chunkThreads < 1) chunkThreads = 1;
+        }
+
+        //under --max-memory a file is only read once its estimate fits (by its decompressed size)
+        uint64_t estimate = 0;
+        if (args->budget != NULL){
+            struct stat fileData;
+            int hinted = sizeHint >= 0 && uncompressedLength(fileName) == strlen(fileName);
+            off_t size = hinted ? sizeHint : 0;
+            int probe = hinted ? -1 : open(fileName, O_RDONLY, 0);
+            if (probe != -1){
+                if (fstat(probe, &fileData) == 0) size = textSize(probe, fileData.st_size);
+                close(probe);
+            }
+            estimate = fileEstimate(size);
+            admitFile(args->budget, estimate);
+        }
+
+        //under --max-memory the words are interned once their growth of the vocabulary is charged
+        vocabulary_t *vocab = (args->budget != NULL) ? NULL : args->vocab;
+
         FileAndList *fal = malloc(sizeof(FileAndList));
-        int file = open(fileName, O_RDONLY, 0);
-        if(file == -1)  {  
-            perror("File 1 error");
+        fal->filepath = fileName;
+
+        if (args->deferLoad){
+            //sharded runs only read the documents their tiles need
+            fal->list = NULL;
+            fal->vec = NULL;
+            fal->same = NULL;
+            summarizeList(NULL, &fal->summary);
+
+        } else if (args->dedup != NULL){
+            int file = open(fileName, O_RDONLY, 0);
+            uint64_t hash;
+            off_t size;
+            if (file == -1 || hashFile(file, &hash, &size)){
+                perror(fileName);
+                if (file != -1) close(file);
+                if (args->budget != NULL){
+                    cancelFile(args->budget, estimate);
+                    releaseMemory(args->budget, pathCost(fileName));
+                }
+                free(fileName);
+                free(fal);
+                exit_status = 1;
+                continue;
+            }
+
+            //a copy of a file already claimed borrows its words once collection is done
+            fal->list = NULL;
+            fal->vec = NULL;
+            summarizeList(NULL, &fal->summary);
+            fal->same = claimContent(args->dedup, hash, size, fal, file);
+            if (fal->same == NULL && readDocument(fal, file, vocab, chunkThreads, tokenRules, ngramSize)){
+                //its copies may already borrow it, so the document stays, empty
+                perror(fileName);
+                exit_status = 1;
+            }
+            close(file);
+
+        } else if (loadDocument(fal, vocab, chunkThreads, tokenRules, ngramSize)){
+            perror(fileName);
+            destroy_list(&fal->list);
+            destroy_vector(fal->vec);
+            if (args->budget != NULL){
+                cancelFile(args->budget, estimate);
+                releaseMemory(args->budget, pathCost(fileName));
+            }
             free(fileName);
+            free(fal);
             exit_status = 1;
             continue;
-        } 
-
-        //fill the list
-        fillList(&listOne, file);
-        if (listOne != NULL){
-            //add the list to the WFD repository
-            fal->filepath = fileName; 
-            fal->list = listOne;
-            append_repository(repos, fal);
-        } else {
-            //empty files
-            fal->filepath = fileName; 
-            fal->list = listOne;
-            append_repository(repos, fal);
         }
 
+        //the document's words replace its estimate, spilled to disk if need be
+        if (args->budget != NULL && !args->deferLoad){
+            internDocument(args->budget, fal, args->vocab);
+        }
+        if (args->budget != NULL && finishFile(args->budget, fal, estimate)){
+            exit_status = 1;
+        }
+
+        //add the list (possibly empty) to the WFD repository
+        append_repository(repos, fal);
+
     }
 
     return NULL;
 }
 
-void* analysisThreadTask(void* arg){
-    analysisThreadArgs *args = arg;
+void* loadThreadTask(void* arg){
+    loadThreadArgs *args = arg;
 
-    FileAndList *temp1;
-    FileAndList *temp2;
-    int writeIndex;
+    for(int i = args->id; i < args->numDocs; i += args->stride){
+        if(!args->needed[i]) continue;
 
-    //continue looping until -1 is returned from the queue
-    while(!dequeue_analysis(args->aQ, &temp1, &temp2, &writeIndex)){
+        //the document keeps its place in the order, so a file that cannot be read is treated as empty
+        if(loadDocument(args->docs[i], args->vocab, args->chunkThreads, tokenRules, ngramSize)){
+            perror(args->docs[i]->filepath);
+            exit_status = 1;
+        }
+    }
 
-        if( (temp1 == NULL) || (temp2 == NULL) || (writeIndex == -1) ){
-            fprintf(stderr, "ERROR, dequeue failed for analysis thread %d\n", args->id);
-            abort();
+    return NULL;
+}
+
+/**
+ * purpose: compute (or prune) every pair of one tile into the final structure.
+ */
+void analyseTile(analysisThreadArgs *args, pair_tile_t *tile){
+    long writeIndex = tile->base;
+
+    //out of core, a vector is read in the first time a pair of the tile needs it
+    char rowPinned[TILESIZE] = {0};
+    char colPinned[TILESIZE] = {0};
+
+    for(int i = tile->rowStart; i < tile->rowEnd; i++){
+        int j = (tile->colStart > i + 1) ? tile->colStart : i + 1;
+        for(; j < tile->colEnd; j++, writeIndex++){
+            FileAndList *temp1 = args->docs[i];
+            FileAndList *temp2 = args->docs[j];
+            final_struct *result = &args->fs[writeIndex];
+
+            //store data into the specified index of the final structure array
+            result->filepath1 = temp1->filepath;
+            result->filepath2 = temp2->filepath;
+            result->pairIndex = runPairIndex(i, j, args->numDocs, args->split);
+            result->pruned = 0;
+
+            //skip the merge when the summaries already prove the pair is over the threshold
+            if(args->threshold >= 0 && 
+               jsdLowerBound(&temp1->summary, &temp2->summary) > (args->threshold * args->threshold) + PRUNE_EPSILON){
+                result->pruned = 1;
+                result->JSD = -1;
+                result->totalWords = temp1->summary.vocabSize + temp2->summary.vocabSize;
+                result->shared = 0;
+                result->cosine = 0;
+                result->hellinger = 1;
+                args->pruned++;
+            } else {
+                if(args->cache != NULL && !rowPinned[i - tile->rowStart]){
+                    pinVector(args->cache, i);
+                    rowPinned[i - tile->rowStart] = 1;
+                }
+                if(args->cache != NULL && !colPinned[j - tile->colStart]){
+                    pinVector(args->cache, j);
+                    colPinned[j - tile->colStart] = 1;
+                }
+                pair_metrics_t metrics;
+                documentMetrics(temp1, temp2, args->metrics, &metrics);
+                result->JSD = metrics.JSD;
+                result->totalWords = metrics.totalWords;
+                result->shared = metrics.shared;
+                result->cosine = metrics.cosine;
+                result->hellinger = metrics.hellinger;
+            }
         }
+    }
 
-        //store data into the specified index of the final structure array
-        int wordCount;
-        args->fs[writeIndex].filepath1 = temp1->filepath;
-        args->fs[writeIndex].filepath2 = temp2->filepath;
-        args->fs[writeIndex].JSD = calculateJSD(temp1->list, temp2->list, &wordCount);
-        args->fs[writeIndex].totalWords = wordCount;
+    for(int i = 0; args->cache != NULL && i < TILESIZE; i++){
+        if(rowPinned[i]) unpinVector(args->cache, tile->rowStart + i);
+        if(colPinned[i]) unpinVector(args->cache, tile->colStart + i);
+    }
+}
 
-        //reset the structs just to be safe & for debugging
-        writeIndex = -1;
-        temp1 = NULL;
-        temp2 = NULL;
+void* analysisThreadTask(void* arg){
+    analysisThreadArgs *args = arg;
+    pair_tile_t tile;
 
+    //continue looping until -1 is returned from the queue, only draining it once the run stops
+    while(!dequeue_analysis(args->aQ, &tile)){
+        if(shouldStop(args->control)) continue;
+        analyseTile(args, &tile);
+        markTileDone(args->control, &tile);
     }
 
     return NULL;
 }
 
-void sortStruct(final_struct *fs, int size){
-    for (int i = 0; i < size; i++){
-        for (int j = i+1; j < size; j++){
-            if (fs[i].totalWords < fs[j].totalWords){
-                //swap
-                char *fsi_path1 = fs[i].filepath1;
-                char *fsi_path2 = fs[i].filepath2; 
-                int temp_total = fs[i].totalWords;
-                double temp_JSD = fs[i].JSD;
+/**
+ * purpose: the analysis thread of a NUMA run: pinned to the CPUs of its
+ * node, it takes that node's tiles first and then helps the other nodes.
+ */
+void* numaAnalysisThreadTask(void* arg){
+    analysisThreadArgs *args = arg;
+    pair_tile_t tile;
 
-                fs[i].filepath1 = fs[j].filepath1;
-                fs[i].filepath2 = fs[j].filepath2;
-                fs[i].totalWords = fs[j].totalWords;
-                fs[i].JSD = fs[j].JSD;
+    pinToNode(args->numa, args->node);
+    while(!shouldStop(args->control) && !nextNumaTile(args->schedule, args->node, &tile)){
+        analyseTile(args, &tile);
+        markTileDone(args->control, &tile);
+    }
 
-                fs[j].filepath1 = fsi_path1;
-                fs[j].filepath2 = fsi_path2;
-                fs[j].totalWords = temp_total;
-                fs[j].JSD = temp_JSD;
+    return NULL;
+}
 
-                // free(fsi_path1);
-                // free(fsi_path2);
+#ifndef MANIFEST_BATCH
+#define MANIFEST_BATCH 64       //paths handed to the file queue at a time
+#endif
 
-            }
+/**
+ * purpose: queue the entries of one --files-from list, stripping a trailing
+ * carriage return and a tab plus size hint.
+ */
+void queueManifestEntry(char *entry, size_t length, int separator, char **batch, off_t *hints, int *batched){
+    if (separator == '\n' && length > 0 && entry[length - 1] == '\r') length--;
+
+    off_t hint = -1;
+    char *tab = memrchr(entry, '\t', length);
+    if (tab != NULL && tab + 1 < entry + length){
+        char *digit = tab + 1;
+        while (digit < entry + length && isdigit((unsigned char) *digit)) digit++;
+        if (digit == entry + length){
+            hint = strtoll(tab + 1, NULL, 10);
+            length = tab - entry;
         }
     }
-}
+    if (length == 0) return;
+    if (zstdName(entry, length)){
+        fprintf(stderr, "ERROR: %.*s: zstd files are not supported, decompress it first\n", (int) length, entry);
+        exit_status = 1;
+        return;
+    }
 
-int main(int argc, char ** argv){
+    batch[*batched] = strndup(entry, length);
+    hints[*batched] = hint;
+    (*batched)++;
+}
 
-    //---------------------------------------------------------
-    // SET UP
-    //---------------------------------------------------------
+void flushManifest(bounded_queue_t *fQ, memory_budget_t *budget, char **batch, off_t *hints, int *batched){
+    for(int i = 0; i < *batched; i++){
+        chargeMemory(budget, pathCost(batch[i]));
+    }
+    for(int i = enqueue_batch(fQ, batch, hints, *batched); i < *batched; i++){
+        releaseMemory(budget, pathCost(batch[i]));
+        free(batch[i]);
+    }
+    *batched = 0;
+}
 
-    int directory_threads = 1;
-    int file_threads = 1;
-    int analysis_threads = 1; 
-    char *search_suffix;
-    int suffixAssigned = 0;
-    exit_status = 0;
-    
-    //read in options from command line
-    int i = 1;
-    while (i < argc){
-        char *str;
-        if (strncmp(argv[i], "-s", 2) == 0){
-            search_suffix = malloc(strlen(argv[i]) + 1);
-            obtainSuffix(argv[i], &search_suffix);
-            suffixAssigned = 1;
+/**
+ * purpose: --files-from: hand every path listed in path ("-" for stdin)
+ * straight to the file threads, without stat, directory walks or the
+ * suffix rule. Entries are separated by NUL bytes or by newlines, whichever
+ * comes first, and may end in a tab and the size of the file in bytes, which
+ * --max-memory then uses instead of looking at the file.
+ * Returns -1 if the list could not be read.
+ */
+int readManifest(const char *path, bounded_queue_t *fQ, memory_budget_t *budget){
+    int fd = (strcmp(path, "-") == 0) ? STDIN_FILENO : open(path, O_RDONLY, 0);
+    if (fd == -1){
+        perror(path);
+        return -1;
+    }
 
-        } else if (strncmp(argv[i], "-d", 2) == 0){
-            char* temp = malloc(strlen(argv[i]) + 1);
-            obtainSuffix(argv[i], &temp);
-            directory_threads = atoi(temp);
-            free(temp);
+    size_t capacity = 65536;
+    size_t have = 0;
+    char *buf = malloc(capacity);
+    char *batch[MANIFEST_BATCH];
+    off_t hints[MANIFEST_BATCH];
+    int batched = 0;
+    int separator = -1;
+    int atEnd = 0;
+    int err = 0;
+
+    while (!atEnd){
+        if (have == capacity){
+            capacity *= 2;
+            buf = realloc(buf, capacity);
+        }
+        ssize_t got = read(fd, buf + have, capacity - have);
+        if (got < 0 && errno == EINTR) continue;
+        if (got < 0){
+            perror(path);
+            err = -1;
+        }
+        if (got <= 0){
+            atEnd = 1;
+        } else {
+            have += got;
+        }
 
-        } else if (strncmp(argv[i], "-a", 2) == 0){
-            char* temp = malloc(strlen(argv[i]) + 1);
-            obtainSuffix(argv[i], &temp);
-            analysis_threads = atoi(temp);
-            free(temp);
+        //the first separator seen decides between NUL and newline lists
+        if (separator < 0){
+            for(size_t i = 0; i < have; i++){
+                if (buf[i] == '\0' || buf[i] == '\n'){
+                    separator = buf[i];
+                    break;
+                }
+            }
+            if (separator < 0 && !atEnd) continue;
+        }
 
-        } else if (strncmp(argv[i], "-f", 2) == 0){
-            char* temp = malloc(strlen(argv[i]) + 1);
-            obtainSuffix(argv[i], &temp);
-            file_threads = atoi(temp);
-            free(temp);
+        size_t start = 0;
+        while (start < have){
+            char *end = memchr(buf + start, separator, have - start);
+            if (end == NULL && !atEnd) break;
+            size_t length = (end != NULL) ? (size_t) (end - (buf + start)) : have - start;
+            queueManifestEntry(buf + start, length, separator, batch, hints, &batched);
+            if (batched == MANIFEST_BATCH) flushManifest(fQ, budget, batch, hints, &batched);
+            start += length + 1;
         }
-        i++;
+        if (start > have) start = have;
+        memmove(buf, buf + start, have - start);
+        have -= start;
     }
+    flushManifest(fQ, budget, batch, hints, &batched);
 
-    //if a suffix wasnt given, assign the default value
-    if(!suffixAssigned){
-        search_suffix = malloc(strlen(".txt") + 1);
-        strcpy(search_suffix, ".txt");
-    }
+    free(buf);
+    if (fd != STDIN_FILENO) close(fd);
+    return err;
+}
 
-    //---------------------------------------------------------
-    // COLLETION PAHSE
-    //---------------------------------------------------------
- 
-    //Declare and initialize our queues and WFD repository
+/**
+ * purpose: the collection phase. Walks the inputs with the directory threads
+ * and reads every matching file into the repository with the file threads.
+ * vocab is NULL unless compact vectors are enabled; with deferLoad the files
+ * are only recorded, see loadThreadTask. With dedup, byte-identical files
+ * are tokenized once and share the words, see dedup.c. A budget (or NULL)
+ * throttles the file threads and spills vectors, see membudget.c. manifest
+ * (or NULL) is a --files-from list, see readManifest.
+ */
+void collectRepository(char **inputs, int numInputs, char *manifest, int directory_threads, int file_threads,
+                       char *search_suffix, repository *repos, vocabulary_t *vocab, int deferLoad, int dedup,
+                       memory_budget_t *budget){
+
+    //Declare and initialize our queues
     unbounded_queue_t directoryQueue;
     bounded_queue_t fileQueue;
-    repository repos;
-    if (init_repository(&repos, 1)){
-        perror("Repository failure");
-        abort();
-    }
     init_unbounded(&directoryQueue);
-    init_bounded(&fileQueue);
+    init_bounded_largest(&fileQueue);
 
     //set active threads = 1, to account for the main thread
     directoryQueue.activeThreads = 1;
 
+    //deferred loads never read the files here, so there is nothing to hash
+    dedup_table_t dedupTable;
+    if (dedup && !deferLoad && init_dedup(&dedupTable)){
+        abort();
+    }
+
     //set up thread argument arrays
     pthread_t *tids = malloc((file_threads + directory_threads) * sizeof(pthread_t));
     fileThreadArgs *fArgs = malloc(file_threads * sizeof(fileThreadArgs));
@@ -368,6 +612,7 @@ int main(int argc, char ** argv){
             dArgs[loopIndex].dQ = &directoryQueue;
             dArgs[loopIndex].fQ = &fileQueue;
             dArgs[loopIndex].fileSuffix = search_suffix;
+            dArgs[loopIndex].budget = budget;
             dArgs[loopIndex].id = loopIndex;
             pthread_create(&tids[loopIndex], NULL, dirThreadTask, &dArgs[loopIndex]);
 
@@ -375,8 +620,13 @@ int main(int argc, char ** argv){
 
             //were making file threads
             fArgs[loopIndex - directory_threads].fQ = &fileQueue;
-            fArgs[loopIndex - directory_threads].repos = &repos;
+            fArgs[loopIndex - directory_threads].repos = repos;
+            fArgs[loopIndex - directory_threads].vocab = vocab;
             fArgs[loopIndex - directory_threads].fileSuffix = search_suffix;
+            fArgs[loopIndex - directory_threads].deferLoad = deferLoad;
+            fArgs[loopIndex - directory_threads].dedup = (dedup && !deferLoad) ? &dedupTable : NULL;
+            fArgs[loopIndex - directory_threads].chunkThreads = file_threads;
+            fArgs[loopIndex - directory_threads].budget = budget;
             fArgs[loopIndex - directory_threads].id = loopIndex;
             pthread_create(&tids[loopIndex], NULL, fileThreadTask, &fArgs[loopIndex - directory_threads]);
 
@@ -385,44 +635,59 @@ int main(int argc, char ** argv){
     }
 
     //read in command line input, looking for files/directories
-    for(int i = 1; i < argc; i++){
-        if(strncmp(argv[i], "-s", 2) == 0 || strncmp(argv[i], "-d", 2) == 0 || strncmp(argv[i], "-a", 2) == 0|| strncmp(argv[i], "-f", 2) == 0){
-            //were dealing with an option. ignore it.
-            continue;
+    for(int i = 0; i < numInputs; i++){
 
-        } else {
+        //we are dealing with a directory or a file.
+        struct stat dirData;
 
-            //then we are dealing with a directory or a file.
-            struct stat dirData;
+        if (stat(inputs[i], &dirData)){
+            //if theres an error report it and continue but exit will be a failure
+            perror(inputs[i]);
+            exit_status = 1;
+            continue;
+        }
 
-            if (stat(argv[i], &dirData)){
-                //if theres an error report it and continue but exit will be a failure
-                perror(argv[i]);
+        //check the file type
+        if (S_ISDIR(dirData.st_mode)){
+            //we found a directory, so add a copy of its path to the unbounded directory queue
+            char* temp = malloc(strlen(inputs[i]) + 1);
+            strcpy(temp, inputs[i]);
+            chargeMemory(budget, pathCost(temp));
+            if(enqueue_unbounded(&directoryQueue, temp)){
+                releaseMemory(budget, pathCost(temp));
+                free(temp);
+            }
+
+        } else if (S_ISREG(dirData.st_mode)){
+            if (zstdName(inputs[i], strlen(inputs[i]))){
+                fprintf(stderr, "ERROR: %s: zstd files are not supported, decompress it first\n", inputs[i]);
                 exit_status = 1;
                 continue;
             }
 
-            //check the file type
-            if (S_ISDIR(dirData.st_mode)){
-                //we found a directory, so add it to the unbounded directory queue
-                enqueue_unbounded(&directoryQueue, argv[i]);
-
-            } else if (S_ISREG(dirData.st_mode)){
-                //we found a file; checking its suffix
-                if(strSuffixCmp(argv[i], search_suffix)){
-                    //enqueue the file path
-                    char* temp = malloc(strlen(argv[i]) + 1);
-                    strcpy(temp, argv[i]);
-                    enqueue(&fileQueue, temp);
+            //we found a file; checking its suffix
+            if(strSuffixCmp(inputs[i], search_suffix)){
+                //enqueue the file path
+                char* temp = malloc(strlen(inputs[i]) + 1);
+                strcpy(temp, inputs[i]);
+                chargeMemory(budget, pathCost(temp));
+                if(enqueue_hinted(&fileQueue, temp, dirData.st_size)){
+                    releaseMemory(budget, pathCost(temp));
+                    free(temp);
                 }
-
-            } else {
-                //for any other file type, just ignore it
-                continue;
             }
+
+        } else {
+            //for any other file type, just ignore it
+            continue;
         }
     }
 
+    //a list of files goes straight to the file threads
+    if (manifest != NULL && readManifest(manifest, &fileQueue, budget)){
+        exit_status = 1;
+    }
+
     //"deactivate" the main thread by decrementing thee activeThread counter
     pthread_mutex_lock(&directoryQueue.lock);
     directoryQueue.activeThreads--;
@@ -442,37 +707,1045 @@ int main(int argc, char ** argv){
         pthread_join(tids[i], NULL);
     }
 
+    if (dedup && !deferLoad){
+        shareDuplicates(repos);
+        if (verbose && dedupTable.duplicates > 0){
+            fprintf(stderr, "%ld identical files share the words of another file\n", dedupTable.duplicates);
+        }
+        destroy_dedup(&dedupTable);
+    }
+
     //free undeeded resources
     free(tids);
     free(dArgs);
     free(fArgs);
+    destroy_unbounded(&directoryQueue);
+    destroy_bounded(&fileQueue);
 
-    //TODO: ERROR CONDITION: IF REPOS < 2 FILES
-    if (repos.size < 2){
-        fprintf(stderr, "ERROR: Arguments do not have enough files to compute JSD\n");
-        for(int i = 0; i < repos.nextIndex; i++){
-            free(repos.fal[i]->filepath);
+}
+
+/**
+ * purpose: turn the results of the distinct documents into the results of
+ * every pair of the repository. distinctIndex[i] is the distinct document
+ * holding document i's content; two copies of one content are at JSD 0.
+ * distinct may hold only some of the pairs (a run that stopped early), the
+ * others are left out; reached then marks the distinct documents of the
+ * finished tiles, and only their copies are paired (NULL if every tile
+ * finished). A bipartite run gives where its columns start among
+ * the documents (split) and among the distinct ones (distinctSplit).
+ * Returns the new array and sets *size to its length.
+ */
+final_struct *expandDuplicates(final_struct *distinct, long numDistinctPairs, FileAndList **docs, int numDocs,
+                               int split, int *distinctIndex, int numDistinct, int distinctSplit,
+                               const char *reached, long *size){
+    long numPairs = (split > 0) ? (long) split * (numDocs - split) : (long) numDocs * (numDocs - 1) / 2;
+    final_struct *fs = malloc(sizeof(final_struct) * (numPairs + 1));
+
+    //results are found by the pair index of the two distinct documents
+    long allDistinct = (distinctSplit > 0) ? (long) distinctSplit * (numDistinct - distinctSplit)
+                                           : (long) numDistinct * (numDistinct - 1) / 2;
+    long *byPair = malloc(sizeof(long) * (allDistinct + 1));
+    for(long p = 0; p < allDistinct; p++){
+        byPair[p] = -1;
+    }
+    for(long w = 0; w < numDistinctPairs; w++){
+        byPair[distinct[w].pairIndex] = w;
+    }
+
+    long w = 0;
+    int rows = (split > 0) ? split : numDocs;
+    for(int i = 0; i < rows; i++){
+        for(int j = (split > i + 1) ? split : i + 1; j < numDocs; j++){
+            int a = distinctIndex[i];
+            int b = distinctIndex[j];
+            if(a == b && reached != NULL && !reached[a]) continue;
+            long found = (a == b) ? 0 : byPair[(a < b) ? runPairIndex(a, b, numDistinct, distinctSplit)
+                                                       : runPairIndex(b, a, numDistinct, distinctSplit)];
+            if(found < 0) continue;
+            fs[w].filepath1 = docs[i]->filepath;
+            fs[w].filepath2 = docs[j]->filepath;
+            fs[w].pairIndex = runPairIndex(i, j, numDocs, split);
+            if(a == b){
+                fs[w].JSD = 0;
+                fs[w].totalWords = 2 * docs[i]->summary.vocabSize;
+                fs[w].pruned = 0;
+                fs[w].shared = docs[i]->summary.vocabSize;
+                fs[w].cosine = 1;
+                fs[w].hellinger = 0;
+            } else {
+                final_struct *result = &distinct[found];
+                fs[w].JSD = result->JSD;
+                fs[w].totalWords = result->totalWords;
+                fs[w].pruned = result->pruned;
+                fs[w].shared = result->shared;
+                fs[w].cosine = result->cosine;
+                fs[w].hellinger = result->hellinger;
+            }
+            w++;
+        }
+    }
+
+    free(byPair);
+    *size = w;
+    return fs;
+}
+
+/**
+ * purpose: print the topK documents of the corpus closest to each query file,
+ * closest first, using an inverted index built once for all queries. Up to
+ * QUERY_BATCH queries at a time share their walks of the index. With a
+ * vantage-point tree the queries search it one at a time instead, and a
+ * radius that is not negative prints every document within it.
+ */
+int runQueries(char **queries, int numQueries, int topK, repository *repos, vocabulary_t *vocab, int chunkThreads,
+               vp_tree_t *tree, double radius){
+    int err = 0;
+    inverted_index_t index;
+    if (tree == NULL){
+        init_index(&index, repos->fal, repos->nextIndex, vocab->count);
+    }
+    index_match_t *best = malloc(sizeof(index_match_t) * topK * QUERY_BATCH);
+    DocVector **batch = malloc(sizeof(DocVector *) * QUERY_BATCH);
+    char **names = malloc(sizeof(char *) * QUERY_BATCH);
+    int found[QUERY_BATCH];
+
+    for(int first = 0; first < numQueries; first += QUERY_BATCH){
+        int count = 0;
+        for(int q = first; q < numQueries && q < first + QUERY_BATCH; q++){
+            DocVector *query = loadQueryVector(queries[q], vocab, chunkThreads, tokenRules);
+            if(query == NULL){
+                perror(queries[q]);
+                err = 1;
+                continue;
+            }
+            names[count] = queries[q];
+            batch[count++] = query;
+        }
+
+        if (tree == NULL){
+            query_index_batch(&index, batch, count, topK, NULL, best, found);
+        }
+        for(int q = 0; q < count; q++){
+            index_match_t *matches = &best[q * topK];
+            if (tree != NULL && radius >= 0){
+                found[q] = query_vptree_radius(tree, repos->fal, batch[q], radius, NULL, &matches);
+            } else if (tree != NULL){
+                found[q] = query_vptree(tree, repos->fal, batch[q], topK, NULL, matches);
+            }
+            for(int i = 0; i < found[q]; i++){
+                printf("%f     %s     %s\n", matches[i].JSD, names[q], repos->fal[matches[i].doc]->filepath);
+            }
+            if (tree != NULL && radius >= 0){
+                free(matches);
+            }
+            destroy_vector(batch[q]);
+        }
+    }
+
+    if (verbose && tree != NULL && numQueries > 0){
+        fprintf(stderr, "vptree: %.1f of %d documents compared per query\n",
+                (double) tree->compared / numQueries, repos->nextIndex);
+    }
+
+    free(best);
+    free(batch);
+    free(names);
+    if (tree == NULL){
+        destroy_index(&index);
+    }
+    return err;
+}
+
+/**
+ * purpose: compute the pairs of tiles into fs on analysis_threads threads,
+ * without the checkpoints, caches and NUMA placement of a full run.
+ */
+void analysePairs(pair_tile_t *tiles, int numTiles, final_struct *fs, FileAndList **docs, int numDocs,
+                  double threshold, int metrics, int analysis_threads){
+    run_control_t control;
+    control.deadline = 0;
+    control.tileDone = calloc(numTiles + 1, 1);
+    analysis_queue_t analysisQueue;
+    init_analysis(&analysisQueue);
+
+    pthread_t *analysisTid = malloc(analysis_threads * sizeof(pthread_t));
+    analysisThreadArgs *analysisArgs = calloc(analysis_threads, sizeof(analysisThreadArgs));
+    for(int i = 0; i < analysis_threads; i++){
+        analysisArgs[i].aQ = &analysisQueue;
+        analysisArgs[i].id = i;
+        analysisArgs[i].fs = fs;
+        analysisArgs[i].docs = docs;
+        analysisArgs[i].numDocs = numDocs;
+        analysisArgs[i].threshold = threshold;
+        analysisArgs[i].metrics = metrics;
+        analysisArgs[i].control = &control;
+        pthread_create(&analysisTid[i], NULL, analysisThreadTask, &analysisArgs[i]);
+    }
+    for(int i = 0; i < numTiles && !stopRequested; i++){
+        enqueue_analysis(&analysisQueue, &tiles[i]);
+    }
+    aQClose(&analysisQueue);
+    for(int i = 0; i < analysis_threads; i++){
+        pthread_join(analysisTid[i], NULL);
+    }
+
+    free(analysisTid);
+    free(analysisArgs);
+    free(control.tileDone);
+    destory_analysis(&analysisQueue);
+}
+
+/**
+ * purpose: write the results, sorted and filtered as compare prints them, to
+ * path through a temporary file, so a reader always finds a whole set.
+ */
+int publishResults(const char *path, final_struct *pairs, long numPairs, double threshold, int metrics){
+    final_struct *fs = malloc(sizeof(final_struct) * (numPairs + 1));
+    memcpy(fs, pairs, sizeof(final_struct) * numPairs);
+    sortStruct(fs, numPairs);
+
+    char *temp = malloc(strlen(path) + 5);
+    sprintf(temp, "%s.tmp", path);
+    FILE *out = fopen(temp, "w");
+    int err = (out == NULL);
+    for(long i = 0; i < numPairs && !err; i++){
+        if(threshold >= 0 && (fs[i].pruned || fs[i].JSD > threshold)){
+            continue;
         }
-        destroy_unbounded(&directoryQueue);
-        destroy_bounded(&fileQueue);
+        err = printResult(out, &fs[i], metrics) < 0;
+    }
+    if(out != NULL && fclose(out)) err = 1;
+    if(!err && rename(temp, path)) err = 1;
+    if(err){
+        perror(path);
+        unlink(temp);
+    }
+
+    free(temp);
+    free(fs);
+    return err ? -1 : 0;
+}
+
+/**
+ * purpose: --watch: read the documents of a deferred collection with the
+ * state watch.c keeps, publish the results of every pair to path, then
+ * republish them whenever files change, recomputing only the pairs of the
+ * documents whose words changed. Runs until SIGINT or SIGTERM.
+ * Returns 1 if a file could not be read or the results not written.
+ */
+int watchCorpus(char *path, repository *repos, vocabulary_t *vocab, int file_threads, int analysis_threads,
+                double threshold, int metrics){
+    int numDocs = repos->nextIndex;
+    int err = 0;
+    watch_t watch;
+    if (init_watch(&watch, repos->fal, numDocs)){
+        destroy_watch(&watch);
+        return 1;
+    }
+    if (refreshWatchFiles(&watch, vocab, file_threads) > 0){
+        err = 1;
+    }
+
+    //the first results are kept by pair index, so later ones can be put in their place
+    installStopHandlers();
+    pair_tile_t *tiles = NULL;
+    int capacity = 0;
+    long numPairs = 0;
+    int numTiles = addTiles(&tiles, 0, &capacity, 0, numDocs, 0, numDocs, TILESIZE, &numPairs);
+    final_struct *pairs = malloc(sizeof(final_struct) * (numPairs + 1));
+    analysePairs(tiles, numTiles, pairs, repos->fal, numDocs, threshold, metrics, analysis_threads);
+    free(tiles);
+    //a stopped pass leaves the slots of the tiles it never ran unset
+    for(long w = 0; w < numPairs && !stopRequested; w++){
+        while(pairs[w].pairIndex != w){
+            final_struct temp = pairs[pairs[w].pairIndex];
+            pairs[pairs[w].pairIndex] = pairs[w];
+            pairs[w] = temp;
+        }
+    }
+    if (!stopRequested){
+        if (publishResults(path, pairs, numPairs, threshold, metrics)){
+            err = 1;
+        }
+        fprintf(stderr, "watch: %ld pairs of %d files in %s\n", numPairs, numDocs, path);
+    }
+
+    while (!stopRequested){
+        int flagged = waitForChanges(&watch);
+        if (flagged < 0){
+            err = 1;
+            break;
+        }
+        if (flagged == 0) continue;
+        if (refreshWatchFiles(&watch, vocab, file_threads) > 0){
+            err = 1;
+        }
+
+        //every pair of a document whose words changed: its row after it, and its column
+        //above it over the unchanged rows only, as a changed row already holds that pair
+        int appended = 0;
+        int reread = 0;
+        long count = 0;
+        tiles = NULL;
+        capacity = 0;
+        numTiles = 0;
+        for(int d = 0; d < numDocs; d++){
+            if(watch.files[d].action == WATCH_UNCHANGED) continue;
+            appended += (watch.files[d].action == WATCH_APPENDED);
+            reread += (watch.files[d].action == WATCH_REREAD);
+            for(int r = 0; r < d; r++){
+                if(watch.files[r].action != WATCH_UNCHANGED) continue;
+                int end = r + 1;
+                while(end < d && watch.files[end].action == WATCH_UNCHANGED) end++;
+                numTiles = addTiles(&tiles, numTiles, &capacity, r, end, d, d + 1, TILESIZE, &count);
+                r = end;
+            }
+            numTiles = addTiles(&tiles, numTiles, &capacity, d, d + 1, d + 1, numDocs, TILESIZE, &count);
+        }
+        if (numTiles == 0){
+            free(tiles);
+            continue;
+        }
+
+        final_struct *fs = malloc(sizeof(final_struct) * (count + 1));
+        analysePairs(tiles, numTiles, fs, repos->fal, numDocs, threshold, metrics, analysis_threads);
+        if (!stopRequested){
+            for(long w = 0; w < count; w++){
+                pairs[fs[w].pairIndex] = fs[w];
+            }
+            if (publishResults(path, pairs, numPairs, threshold, metrics)){
+                err = 1;
+            }
+            fprintf(stderr, "watch: %d files appended to, %d read again, %ld pairs recomputed\n",
+                    appended, reread, count);
+        }
+        free(fs);
+        free(tiles);
+    }
+    restoreStopHandlers();
+
+    free(pairs);
+    destroy_watch(&watch);
+    return err;
+}
+
+/**
+ * purpose: tokenize (or map) the corpus into an engine whose pool has
+ * analysis_threads threads, then serve it on the socket at path.
+ */
+int serveCorpus(char *path, char **inputs, int numInputs, char *corpusIn, int directory_threads,
+                int file_threads, int analysis_threads, char *search_suffix){
+    jsd_options options = { tokenRuleNames[tokenRules], ngramSize };
+    jsd_engine *engine = jsd_engine_create_with(analysis_threads, &options);
+    if (engine == NULL){
+        perror("Engine failure");
+        return 1;
+    }
+
+    int err = 0;
+    if (corpusIn != NULL){
+        err = loadSnapshot(corpusIn, &engine->repos, tokenRules, ngramSize) || loadSnapshotVocabulary(&engine->repos, &engine->vocab);
+    } else {
+        //no dedup: the engine may remove a document, so none may borrow another's words
+        collectRepository(inputs, numInputs, NULL, directory_threads, file_threads, search_suffix,
+                          &engine->repos, &engine->vocab, 0, 0, NULL);
+        sortRepository(&engine->repos);
+    }
+    engineAdopt(engine);
+
+    if (!err){
+        err = serveEngine(path, engine);
+    }
+    jsd_engine_destroy(engine);
+    return err || exit_status;
+}
+
+int main(int argc, char ** argv){
+
+    //---------------------------------------------------------
+    // SET UP
+    //---------------------------------------------------------
+
+    int directory_threads = 1;
+    int file_threads = 1;
+    int analysis_threads = 1; 
+    char *search_suffix;
+    int suffixAssigned = 0;
+    double threshold = -1;
+    int metrics = METRIC_JSD;
+    int compactVectors = 0;
+    int shardIndex = -1;
+    int shardCount = 0;
+    char *corpusOut = NULL;
+    char *corpusIn = NULL;
+    char **queries = malloc(sizeof(char*) * argc);
+    int numQueries = 0;
+    int topK = 10;
+    int useVptree = 0;
+    char *vptreeOut = NULL;
+    char *vptreeIn = NULL;
+    double radius = -1;
+    char *servePath = NULL;
+    int useNuma = 0;
+    int dedup = 1;
+    double timeBudget = 0;
+    char *checkpointPath = NULL;
+    double checkpointEvery = 300;
+    char *resumePath = NULL;
+    checkpoint_header_t resumeHeader;
+    double outOfCore = 0;
+    double maxMemory = 0;
+    char *filesFrom = NULL;
+    char *watchPath = NULL;
+    double startTime = monotonicSeconds();
+    //the --against paths share the allocation of inputs
+    char **inputs = malloc(sizeof(char*) * 2 * argc);
+    int numInputs = 0;
+    char **against = inputs + argc;
+    int numAgainst = 0;
+    int split = 0;
+    exit_status = 0;
+
+    //"compare merge shard..." combines the output of a sharded run
+    if (argc > 1 && strcmp(argv[1], "merge") == 0){
+        free(queries);
+        free(inputs);
+        return mergeShards(argc - 2, argv + 2);
+    }
+    
+    //read in options from command line, everything else is a file or directory
+    int i = 1;
+    while (i < argc){
+        char *str;
+        if (strncmp(argv[i], "-s", 2) == 0){
+            search_suffix = malloc(strlen(argv[i]) + 1);
+            obtainSuffix(argv[i], &search_suffix);
+            suffixAssigned = 1;
+
+        } else if (strncmp(argv[i], "-d", 2) == 0){
+            char* temp = malloc(strlen(argv[i]) + 1);
+            obtainSuffix(argv[i], &temp);
+            directory_threads = atoi(temp);
+            free(temp);
+
+        } else if (strncmp(argv[i], "-a", 2) == 0){
+            char* temp = malloc(strlen(argv[i]) + 1);
+            obtainSuffix(argv[i], &temp);
+            analysis_threads = atoi(temp);
+            free(temp);
+
+        } else if (strncmp(argv[i], "-f", 2) == 0){
+            char* temp = malloc(strlen(argv[i]) + 1);
+            obtainSuffix(argv[i], &temp);
+            file_threads = atoi(temp);
+            free(temp);
+
+        } else if (strncmp(argv[i], "-t", 2) == 0){
+            char* temp = malloc(strlen(argv[i]) + 1);
+            obtainSuffix(argv[i], &temp);
+            threshold = atof(temp);
+            free(temp);
+
+        } else if (strncmp(argv[i], "-q", 2) == 0){
+            compactVectors = 1;
+
+        } else if (strncmp(argv[i], "-n", 2) == 0){
+            //n-grams are counted straight into compact vectors
+            char* temp = malloc(strlen(argv[i]) + 1);
+            obtainSuffix(argv[i], &temp);
+            ngramSize = atoi(temp);
+            free(temp);
+            compactVectors = 1;
+            if (ngramSize < 1 || ngramSize > NGRAM_MAX){
+                fprintf(stderr, "ERROR: -n expects a number of words from 1 to %d\n", NGRAM_MAX);
+                free(queries);
+                free(inputs);
+                return EXIT_FAILURE;
+            }
+
+        } else if (strncmp(argv[i], "-k", 2) == 0){
+            char* temp = malloc(strlen(argv[i]) + 1);
+            obtainSuffix(argv[i], &temp);
+            topK = atoi(temp);
+            free(temp);
+
+        } else if (strcmp(argv[i], "--query") == 0 && i + 1 < argc){
+            //queries are looked up in the corpus vocabulary, so it has to be interned
+            queries[numQueries++] = argv[++i];
+            compactVectors = 1;
+            if (zstdName(argv[i], strlen(argv[i]))){
+                fprintf(stderr, "ERROR: %s: zstd files are not supported, decompress it first\n", argv[i]);
+                free(queries);
+                free(inputs);
+                return EXIT_FAILURE;
+            }
+
+        } else if (strcmp(argv[i], "--vptree") == 0){
+            useVptree = 1;
+
+        } else if (strcmp(argv[i], "--save-vptree") == 0 && i + 1 < argc){
+            //the tree is built over compact vectors
+            vptreeOut = argv[++i];
+            useVptree = 1;
+            compactVectors = 1;
+
+        } else if (strcmp(argv[i], "--load-vptree") == 0 && i + 1 < argc){
+            vptreeIn = argv[++i];
+            useVptree = 1;
+
+        } else if (strcmp(argv[i], "--radius") == 0 && i + 1 < argc){
+            //--query prints every file within the radius, found through the tree
+            radius = atof(argv[++i]);
+            useVptree = 1;
+            if (radius < 0){
+                fprintf(stderr, "ERROR: --radius expects a distance of at least 0\n");
+                free(queries);
+                free(inputs);
+                return EXIT_FAILURE;
+            }
+
+        } else if (strcmp(argv[i], "--shard") == 0 && i + 1 < argc){
+            //--shard i/n: this process computes shard i of n
+            i++;
+            if (sscanf(argv[i], "%d/%d", &shardIndex, &shardCount) != 2 || shardCount < 1
+                || shardIndex < 0 || shardIndex >= shardCount){
+                fprintf(stderr, "ERROR: --shard expects i/n with 0 <= i < n\n");
+                free(queries);
+                free(inputs);
+                return EXIT_FAILURE;
+            }
+
+        } else if (strcmp(argv[i], "--save-corpus") == 0 && i + 1 < argc){
+            //snapshots hold compact vectors
+            corpusOut = argv[++i];
+            compactVectors = 1;
+
+        } else if (strcmp(argv[i], "--load-corpus") == 0 && i + 1 < argc){
+            corpusIn = argv[++i];
+
+        } else if (strcmp(argv[i], "--numa") == 0){
+            useNuma = 1;
+
+        } else if (strcmp(argv[i], "--no-dedup") == 0){
+            dedup = 0;
+
+        } else if (strcmp(argv[i], "--verbose") == 0){
+            verbose = 1;
+
+        } else if (strcmp(argv[i], "--serve") == 0 && i + 1 < argc){
+            servePath = argv[++i];
+
+        } else if (strcmp(argv[i], "--time-budget") == 0 && i + 1 < argc){
+            //seconds for the whole run, after which no more tiles are started
+            timeBudget = atof(argv[++i]);
+
+        } else if (strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc){
+            checkpointPath = argv[++i];
+
+        } else if (strcmp(argv[i], "--checkpoint-every") == 0 && i + 1 < argc){
+            checkpointEvery = atof(argv[++i]);
+
+        } else if (strcmp(argv[i], "--resume") == 0 && i + 1 < argc){
+            resumePath = argv[++i];
+
+        } else if (strcmp(argv[i], "--out-of-core") == 0 && i + 1 < argc){
+            //megabytes of vectors the analysis may hold in memory at once
+            outOfCore = atof(argv[++i]);
+            if (outOfCore <= 0){
+                fprintf(stderr, "ERROR: --out-of-core expects a budget in megabytes\n");
+                free(queries);
+                free(inputs);
+                return EXIT_FAILURE;
+            }
+
+        } else if (strcmp(argv[i], "--max-memory") == 0 && i + 1 < argc){
+            //megabytes the collection may hold; vectors beyond its share are spilled to disk
+            maxMemory = atof(argv[++i]);
+            compactVectors = 1;
+            if (maxMemory <= 0){
+                fprintf(stderr, "ERROR: --max-memory expects a budget in megabytes\n");
+                free(queries);
+                free(inputs);
+                return EXIT_FAILURE;
+            }
+
+        } else if (strcmp(argv[i], "--against") == 0 && i + 1 < argc){
+            //a file or directory of the second set: only pairs across the two sets are compared
+            against[numAgainst++] = argv[++i];
+
+        } else if (strcmp(argv[i], "--watch") == 0 && i + 1 < argc){
+            //keep the results in a file up to date as the inputs grow
+            watchPath = argv[++i];
+
+        } else if (strcmp(argv[i], "--metrics") == 0 && i + 1 < argc){
+            //what to print for every pair, computed in one pass over the two documents
+            if ((metrics = parseMetrics(argv[++i])) < 0){
+                fprintf(stderr, "ERROR: --metrics expects a comma separated list of jsd, cosine, hellinger, "
+                                "jaccard and shared, or all\n");
+                free(queries);
+                free(inputs);
+                return EXIT_FAILURE;
+            }
+
+        } else if (strcmp(argv[i], "--files-from") == 0 && i + 1 < argc){
+            //a list of files to compare, "-" for stdin
+            filesFrom = argv[++i];
+
+        } else if (strcmp(argv[i], "--rules") == 0 && i + 1 < argc){
+            //set before any thread reads a file
+            i++;
+            if ((tokenRules = findTokenRules(argv[i])) < 0){
+                fprintf(stderr, "ERROR: --rules expects default, alnum or utf8\n");
+                free(queries);
+                free(inputs);
+                return EXIT_FAILURE;
+            }
+
+        } else {
+            inputs[numInputs++] = argv[i];
+        }
+        i++;
+    }
+
+    if (corpusOut != NULL && (shardCount > 0 || corpusIn != NULL)){
+        fprintf(stderr, "ERROR: --save-corpus needs a full collection phase, not --shard or --load-corpus\n");
+        free(queries);
+        free(inputs);
+        return EXIT_FAILURE;
+    }
+
+    if (numQueries > 0 && (shardCount > 0 || corpusOut != NULL || topK < 1)){
+        fprintf(stderr, "ERROR: --query needs -k of at least 1 and cannot be combined with --shard or --save-corpus\n");
+        free(queries);
+        free(inputs);
+        return EXIT_FAILURE;
+    }
+
+    //if a suffix wasnt given, assign the default value
+    if(!suffixAssigned){
+        search_suffix = malloc(strlen(".txt") + 1);
+        strcpy(search_suffix, ".txt");
+    }
+
+    if (useVptree && (shardCount > 0 || corpusOut != NULL || servePath != NULL || (numQueries == 0 && vptreeOut == NULL))){
+        fprintf(stderr, "ERROR: --vptree, --load-vptree and --radius need --query, and none of them nor --save-vptree "
+                        "can be combined with --shard, --save-corpus or --serve\n");
+        free(search_suffix);
+        free(queries);
+        free(inputs);
+        return EXIT_FAILURE;
+    }
+
+    if ((checkpointPath != NULL || resumePath != NULL) && (corpusOut != NULL || numQueries > 0 || servePath != NULL
+                                                           || vptreeOut != NULL)){
+        fprintf(stderr, "ERROR: --checkpoint and --resume only apply to pair analysis runs\n");
+        free(search_suffix);
+        free(queries);
+        free(inputs);
+        return EXIT_FAILURE;
+    }
+
+    if (servePath != NULL && (shardCount > 0 || corpusOut != NULL || numQueries > 0 || filesFrom != NULL)){
+        fprintf(stderr, "ERROR: --serve cannot be combined with --shard, --save-corpus, --query or --files-from\n");
+        free(search_suffix);
+        free(queries);
+        free(inputs);
+        return EXIT_FAILURE;
+    }
+
+    //a checkpoint of a whole corpus run holds its snapshot, which needs compact vectors
+    if (checkpointPath != NULL && shardCount == 0){
+        compactVectors = 1;
+    }
+    if (resumePath != NULL && readCheckpointHeader(resumePath, &resumeHeader)){
+        free(search_suffix);
+        free(queries);
+        free(inputs);
+        return EXIT_FAILURE;
+    }
+
+    //out of core the vectors are read from a snapshot while the pairs are analysed
+    if (outOfCore > 0 && ((corpusIn == NULL && (resumePath == NULL || resumeHeader.corpusBytes == 0))
+                          || numQueries > 0 || useVptree || servePath != NULL)){
+        fprintf(stderr, "ERROR: --out-of-core needs a corpus snapshot (--load-corpus, or --resume of a checkpoint "
+                        "holding one) and only applies to pair analysis runs\n");
+        free(search_suffix);
+        free(queries);
+        free(inputs);
+        return EXIT_FAILURE;
+    }
+
+    if (maxMemory > 0 && (shardCount > 0 || corpusIn != NULL || resumePath != NULL || numQueries > 0
+                          || useVptree || servePath != NULL)){
+        fprintf(stderr, "ERROR: --max-memory applies to collecting a corpus for pair analysis or --save-corpus, "
+                        "not to --shard, --load-corpus, --resume, --query or --serve runs\n");
+        free(search_suffix);
+        free(queries);
+        free(inputs);
+        return EXIT_FAILURE;
+    }
+
+    if (numAgainst > 0 && (shardCount > 0 || corpusIn != NULL || corpusOut != NULL || numQueries > 0
+                           || useVptree || vptreeOut != NULL || servePath != NULL)){
+        fprintf(stderr, "ERROR: --against pairs two collected sets, it cannot be combined with --shard, --load-corpus, "
+                        "--save-corpus, --query, --vptree or --serve\n");
+        free(search_suffix);
+        free(queries);
+        free(inputs);
+        return EXIT_FAILURE;
+    }
+
+    if (watchPath != NULL && (shardCount > 0 || corpusIn != NULL || corpusOut != NULL || numQueries > 0
+                              || useVptree || vptreeOut != NULL || servePath != NULL || checkpointPath != NULL
+                              || resumePath != NULL || timeBudget > 0 || maxMemory > 0 || numAgainst > 0)){
+        fprintf(stderr, "ERROR: --watch pairs the collected files with each other, it cannot be combined with "
+                        "--shard, a corpus snapshot, --query, --vptree, --serve, --checkpoint, --resume, "
+                        "--time-budget, --max-memory or --against\n");
+        free(search_suffix);
+        free(queries);
+        free(inputs);
+        return EXIT_FAILURE;
+    }
+
+    if (metrics != METRIC_JSD && (numQueries > 0 || vptreeOut != NULL || corpusOut != NULL || servePath != NULL)){
+        fprintf(stderr, "ERROR: --metrics only applies to pair analysis runs, not to --query, --save-vptree, "
+                        "--save-corpus or --serve\n");
+        free(search_suffix);
+        free(queries);
+        free(inputs);
+        return EXIT_FAILURE;
+    }
+
+    if (ngramSize > 1 && (numQueries > 0 || useVptree || servePath != NULL || watchPath != NULL)){
+        fprintf(stderr, "ERROR: -n cannot be combined with --query, --vptree, --save-vptree, --serve or --watch, "
+                        "which work on words\n");
+        free(search_suffix);
+        free(queries);
+        free(inputs);
+        return EXIT_FAILURE;
+    }
+
+    //server mode: the corpus goes straight into a resident engine
+    if (servePath != NULL){
+        exit_status = serveCorpus(servePath, inputs, numInputs, corpusIn, directory_threads,
+                                  file_threads, analysis_threads, search_suffix);
+        free(search_suffix);
+        free(queries);
+        free(inputs);
+        return exit_status;
+    }
+
+    //---------------------------------------------------------
+    // COLLETION PAHSE
+    //---------------------------------------------------------
+ 
+    //Declare and initialize our WFD repository
+    repository repos;
+    vocabulary_t vocab;
+    if (init_repository(&repos, 1) || init_vocabulary(&vocab)){
+        perror("Repository failure");
+        abort();
+    }
+    memory_budget_t budget;
+    if (maxMemory > 0){
+        init_memory_budget(&budget, (uint64_t) (maxMemory * 1024 * 1024));
+    }
+
+    if (resumePath != NULL && resumeHeader.corpusBytes > 0){
+        //so does a checkpoint of a whole corpus run
+        if (numInputs > 0 || filesFrom != NULL || numAgainst > 0 || corpusIn != NULL){
+            fprintf(stderr, "WARNING: %s holds the corpus, ignoring the file and directory arguments\n", resumePath);
+        }
+        split = resumeHeader.split;
+        if ((outOfCore > 0) ? loadSnapshotIndex(resumePath, CHECKPOINT_CORPUS_OFFSET, &repos, tokenRules, ngramSize)
+                            : loadSnapshotAt(resumePath, CHECKPOINT_CORPUS_OFFSET, &repos, tokenRules, ngramSize)){
+            exit_status = 1;
+        }
+    } else if (corpusIn != NULL){
+        //a snapshot already holds the sorted, tokenized corpus
+        if (numInputs > 0 || filesFrom != NULL){
+            fprintf(stderr, "WARNING: --load-corpus given, ignoring the file and directory arguments\n");
+        }
+        if ((outOfCore > 0) ? loadSnapshotIndex(corpusIn, 0, &repos, tokenRules, ngramSize) : loadSnapshot(corpusIn, &repos, tokenRules, ngramSize)){
+            exit_status = 1;
+        } else if (numQueries > 0 && loadSnapshotVocabulary(&repos, &vocab)){
+            exit_status = 1;
+        }
+    } else {
+        //watch mode reads the files itself, and no document may borrow the words of one that changes
+        collectRepository(inputs, numInputs, filesFrom, directory_threads, file_threads, search_suffix,
+                          &repos, compactVectors ? &vocab : NULL, (shardCount > 0 || watchPath != NULL),
+                          dedup && (watchPath == NULL), (maxMemory > 0) ? &budget : NULL);
+
+        //fix the order of the documents so pair indices and tiles are reproducible
+        sortRepository(&repos);
+
+        //a bipartite run collects its second set after the first and sorts it on its own
+        if (numAgainst > 0){
+            split = repos.nextIndex;
+            collectRepository(against, numAgainst, NULL, directory_threads, file_threads, search_suffix,
+                              &repos, compactVectors ? &vocab : NULL, 0, dedup, (maxMemory > 0) ? &budget : NULL);
+            qsort(repos.fal + split, repos.nextIndex - split, sizeof(FileAndList *), compareDocuments);
+        }
+    }
+
+    //spilled vectors are read back from the budget's file
+    if (maxMemory > 0){
+        reportMemoryBudget(&budget);
+        if (budget.store != NULL) repos.storeFd = fileno(budget.store);
+    }
+
+    //a collection only run: write the snapshot and stop
+    if (corpusOut != NULL){
+        if (saveSnapshot(corpusOut, &repos, &vocab, tokenRules, ngramSize)){
+            exit_status = 1;
+        }
+        if (maxMemory > 0) destroy_memory_budget(&budget);
+        destroy_repository(&repos);
+        destroy_vocabulary(&vocab);
+        free(search_suffix);
+        free(queries);
+        free(inputs);
+        return exit_status;
+    }
+
+    //a vantage-point tree over the corpus: read back or built on the analysis threads
+    vp_tree_t tree;
+    int treeFailed = 0;
+    if (useVptree){
+        treeFailed = (vptreeIn != NULL) ? loadVptree(vptreeIn, &tree, repos.fal, repos.nextIndex)
+                                        : init_vptree(&tree, repos.fal, repos.nextIndex, analysis_threads);
+        if (treeFailed || (vptreeOut != NULL && saveVptree(vptreeOut, &tree))){
+            exit_status = 1;
+        }
+    }
+
+    //query mode: rank the corpus against each query instead of pairing it with itself
+    if (numQueries > 0 || vptreeOut != NULL){
+        if (numQueries > 0 && !treeFailed && runQueries(queries, numQueries, topK, &repos, &vocab, file_threads,
+                                                        useVptree ? &tree : NULL, radius)){
+            exit_status = 1;
+        }
+        if (useVptree && !treeFailed){
+            destroy_vptree(&tree);
+        }
+        destroy_repository(&repos);
+        destroy_vocabulary(&vocab);
+        free(search_suffix);
+        free(queries);
+        free(inputs);
+        return exit_status;
+    }
+
+    //TODO: ERROR CONDITION: IF REPOS < 2 FILES
+    if (repos.nextIndex < 2 || (numAgainst > 0 && (split == 0 || split == repos.nextIndex))){
+        fprintf(stderr, (numAgainst > 0) ? "ERROR: --against needs files on both sides to compute JSD\n"
+                                         : "ERROR: Arguments do not have enough files to compute JSD\n");
+        if (maxMemory > 0) destroy_memory_budget(&budget);
         destroy_repository(&repos);
+        destroy_vocabulary(&vocab);
         free(search_suffix);
+        free(queries);
+        free(inputs);
         return EXIT_FAILURE;
     }
 
+    //watch mode stays resident and republishes the results as the files change
+    if (watchPath != NULL){
+        if (watchCorpus(watchPath, &repos, compactVectors ? &vocab : NULL, file_threads, analysis_threads,
+                        threshold, metrics)){
+            exit_status = 1;
+        }
+        destroy_repository(&repos);
+        destroy_vocabulary(&vocab);
+        free(search_suffix);
+        free(queries);
+        free(inputs);
+        return exit_status;
+    }
+
     //---------------------------------------------------------------------
     // STARTING ANALYSIS PHASE
     //---------------------------------------------------------------------
 
+    int numDocs = repos.nextIndex;
+
+    //the documents the analysis threads pair up: all of them, or one per content
+    FileAndList **analysisDocs = repos.fal;
+    int numAnalysed = numDocs;
+    FileAndList **distinctDocs = NULL;
+    int *distinctIndex = NULL;
+    int *group = NULL;
+    int numDistinct = 0;
+    int analysedSplit = split;
+
+    //split the pairs into tiles: all of them, or only the ones of this shard
+    pair_tile_t *tiles = NULL;
+    int numTiles = 0;
+    long numPairings = 0;
+    if (shardCount > 0){
+        char *needed = malloc(numDocs + 1);
+        numTiles = shardTiles(shardIndex, shardCount, numDocs, &tiles, needed, &numPairings);
+
+        //read only the documents this shard's tiles need (a snapshot has them all already)
+        if (corpusIn != NULL) memset(needed, 0, numDocs);
+        pthread_t *loadTid = malloc(file_threads * sizeof(pthread_t));
+        loadThreadArgs *loadArgs = malloc(file_threads * sizeof(loadThreadArgs));
+        for(int i = 0; i < file_threads; i++){
+            loadArgs[i].docs = repos.fal;
+            loadArgs[i].needed = needed;
+            loadArgs[i].numDocs = numDocs;
+            loadArgs[i].vocab = compactVectors ? &vocab : NULL;
+            loadArgs[i].chunkThreads = file_threads;
+            loadArgs[i].stride = file_threads;
+            loadArgs[i].id = i;
+            pthread_create(&loadTid[i], NULL, loadThreadTask, &loadArgs[i]);
+        }
+        for(int i = 0; i < file_threads; i++){
+            pthread_join(loadTid[i], NULL);
+        }
+        free(loadTid);
+        free(loadArgs);
+        free(needed);
+    } else {
+        //identical files are analysed once: only the first of each group gets tiles
+        group = malloc(sizeof(int) * (numDocs + 1));
+        contentGroups(&repos, group);
+        if (split > 0) splitContentGroups(group, numDocs, split);
+        for(int i = 0; i < numDocs; i++){
+            if(group[i] == i) numDistinct++;
+            if(i == split - 1) analysedSplit = numDistinct;
+        }
+        if(numDistinct < numDocs){
+            distinctDocs = malloc(sizeof(FileAndList *) * (numDistinct + 1));
+            distinctIndex = malloc(sizeof(int) * (numDocs + 1));
+            int next = 0;
+            for(int i = 0; i < numDocs; i++){
+                if(group[i] == i){
+                    distinctDocs[next] = repos.fal[i];
+                    distinctIndex[i] = next++;
+                } else {
+                    distinctIndex[i] = distinctIndex[group[i]];
+                }
+            }
+            analysisDocs = distinctDocs;
+            numAnalysed = numDistinct;
+        }
+
+        int capacity = 0;
+        if (split > 0){
+            numTiles = addCrossTiles(&tiles, 0, &capacity, analysedSplit, numAnalysed, TILESIZE, &numPairings);
+        } else {
+            numTiles = addTiles(&tiles, 0, &capacity, 0, numAnalysed, 0, numAnalysed, TILESIZE, &numPairings);
+        }
+    }
+
+    //under --max-memory the results have to fit next to the corpus; what is left caches spilled vectors
+    uint64_t cacheBudget = (uint64_t) (outOfCore * 1024 * 1024);
+    if (maxMemory > 0){
+        uint64_t resultBytes = sizeof(final_struct) * (numPairings + 1) + 2 * sizeof(pair_tile_t) * (numTiles + 1);
+        if (analysisDocs != repos.fal){
+            resultBytes += sizeof(final_struct) * ((split > 0) ? (uint64_t) split * (numDocs - split)
+                                                               : (uint64_t) numDocs * (numDocs - 1) / 2);
+        }
+        if (budget.held + resultBytes >= budget.limit){
+            fprintf(stderr, "ERROR: the results of %ld pairs need %.1f MB, more than --max-memory leaves\n",
+                    numPairings, resultBytes / (1024.0 * 1024.0));
+            free(tiles);
+            free(group);
+            free(distinctDocs);
+            free(distinctIndex);
+            free(queries);
+            free(inputs);
+            free(search_suffix);
+            destroy_memory_budget(&budget);
+            destroy_repository(&repos);
+            destroy_vocabulary(&vocab);
+            return EXIT_FAILURE;
+        }
+        if (budget.spilled > 0){
+            cacheBudget = budget.limit - budget.held - resultBytes;
+        }
+    }
+
+    //the results array, and the tiles a checkpoint already has results for
+    final_struct *fs = malloc(sizeof(final_struct) * (numPairings + 1));
+    run_control_t control;
+    control.deadline = (timeBudget > 0) ? startTime + timeBudget : 0;
+    control.tileDone = calloc(numTiles + 1, 1);
+    uint64_t fingerprint = 0;
+    if (checkpointPath != NULL || resumePath != NULL){
+        fingerprint = runFingerprint(analysisDocs, numAnalysed, analysedSplit, shardIndex, shardCount, threshold,
+                                     metrics);
+    }
+    checkpoint_writer_t checkpoint;
+    if ((resumePath != NULL && readCheckpoint(resumePath, fingerprint, tiles, numTiles, numPairings,
+                                              &control, fs, analysisDocs, numAnalysed, analysedSplit))
+        || (checkpointPath != NULL && openCheckpoint(&checkpoint, checkpointPath, resumePath, fingerprint, tiles,
+                                                     numTiles, numPairings, &control, fs,
+                                                     (shardCount > 0) ? NULL : &repos, split, &vocab,
+                                                     checkpointEvery))){
+        free(fs);
+        free(tiles);
+        free(control.tileDone);
+        free(group);
+        free(distinctDocs);
+        free(distinctIndex);
+        free(queries);
+        free(inputs);
+        free(search_suffix);
+        if (maxMemory > 0) destroy_memory_budget(&budget);
+        destroy_repository(&repos);
+        destroy_vocabulary(&vocab);
+        return EXIT_FAILURE;
+    }
+
+    //only the missing tiles are handed out
+    pair_tile_t *todo = malloc(sizeof(pair_tile_t) * (numTiles + 1));
+    int numTodo = 0;
+    for(int i = 0; i < numTiles; i++){
+        if(!control.tileDone[i]) todo[numTodo++] = tiles[i];
+    }
+    if (resumePath != NULL){
+        fprintf(stderr, "resume: %d of %d tiles already done\n", numTiles - numTodo, numTiles);
+    }
+
+    //out of core, the tiles are ordered so each vector is read in as few times as possible
+    vector_cache_t cache;
+    if (cacheBudget > 0){
+        const char *store = (repos.snapshot == NULL) ? "spilled vectors"
+                            : (resumePath != NULL && resumeHeader.corpusBytes > 0) ? resumePath : corpusIn;
+        init_vector_cache(&cache, analysisDocs, numAnalysed, repos.storeFd, store, cacheBudget);
+        orderCacheTiles(todo, numTodo, analysisDocs, cacheBudget);
+    }
+
+    //NUMA runs move the documents next to the threads that read them
+    numa_topology_t numa;
+    numa_schedule_t numaSchedule;
+    int numaNodes = 0;
+    if (useNuma){
+        detectNuma(&numa);
+        if (numa.numNodes > 1){
+            numaNodes = numa.numNodes;
+            if (repos.snapshot == NULL && repos.storeFd == -1){
+                placeDocuments(&numa, analysisDocs, numAnalysed);
+                shareDuplicates(&repos);
+            }
+            init_numa_schedule(&numaSchedule, todo, numTodo, numAnalysed, numaNodes);
+            fprintf(stderr, "numa: %d nodes, %d analysis threads\n", numaNodes, analysis_threads);
+        } else {
+            destroy_numa(&numa);
+        }
+    }
+
     //create the analysis queue
     analysis_queue_t analysisQueue;
     init_analysis(&analysisQueue);
 
-    //calculate the number of file pairsing to be created
-    int numPairings = (int) ( 0.5 * (repos.nextIndex) * ( repos.nextIndex - 1) );
+    //from here on SIGINT, SIGTERM and the time budget stop the run between tiles
+    installStopHandlers();
 
     //create the thread arg struct
-    final_struct *fs = malloc(sizeof(final_struct) * numPairings);
     pthread_t *analysisTid = malloc(analysis_threads * sizeof(pthread_t));
     analysisThreadArgs *analysisArgs =  malloc(analysis_threads * sizeof(analysisThreadArgs));
 
@@ -481,49 +1754,139 @@ int main(int argc, char ** argv){
         analysisArgs[i].aQ = &analysisQueue;
         analysisArgs[i].id = i;
         analysisArgs[i].fs = fs;
-        pthread_create(&analysisTid[i], NULL, analysisThreadTask, &analysisArgs[i]);
+        analysisArgs[i].docs = analysisDocs;
+        analysisArgs[i].numDocs = numAnalysed;
+        analysisArgs[i].split = analysedSplit;
+        analysisArgs[i].threshold = threshold;
+        analysisArgs[i].metrics = metrics;
+        analysisArgs[i].pruned = 0;
+        analysisArgs[i].control = &control;
+        analysisArgs[i].cache = (cacheBudget > 0) ? &cache : NULL;
+        if (numaNodes > 0){
+            //threads are dealt round robin to the nodes
+            analysisArgs[i].numa = &numa;
+            analysisArgs[i].schedule = &numaSchedule;
+            analysisArgs[i].node = i % numaNodes;
+            pthread_create(&analysisTid[i], NULL, numaAnalysisThreadTask, &analysisArgs[i]);
+        } else {
+            pthread_create(&analysisTid[i], NULL, analysisThreadTask, &analysisArgs[i]);
+        }
     }
 
-    //creating the file pairings
-    int pairNumber = 0;   //used to dictate where in the final struct the threads should save their results to
-    for(int i = 0; i < repos.nextIndex; i++){
-        for(int j = i + 1; j < repos.nextIndex; j++){
-            if(enqueue_analysis(&analysisQueue, repos.fal[i], repos.fal[j], pairNumber)){
-                fprintf(stderr, "--- ERROR: cannot enqueue since the queue has closed too early ---\n");
-            }
-            pairNumber++;
+    //hand out the tiles (a NUMA run has them in its schedule already)
+    for(int i = 0; i < numTodo && numaNodes == 0 && !stopRequested; i++){
+        if(enqueue_analysis(&analysisQueue, &todo[i])){
+            fprintf(stderr, "--- ERROR: cannot enqueue since the queue has closed too early ---\n");
         }
     }
 
-
     //close the analysis queue
     aQClose(&analysisQueue);
 
     //wait for the analysis threads to end
+    long prunedPairs = 0;
     for(int i = 0; i < analysis_threads; i ++){
         pthread_join(analysisTid[i], NULL);
+        prunedPairs += analysisArgs[i].pruned;
+    }
+    restoreStopHandlers();
+
+    if (cacheBudget > 0){
+        reportVectorCache(&cache, todo, numTodo, analysisDocs, numAnalysed);
+        destroy_vector_cache(&cache);
+    }
+
+    if (numaNodes > 0){
+        destroy_numa_schedule(&numaSchedule);
+        destroy_numa(&numa);
+    }
+
+    //a run that stopped early saves its finished tiles and keeps only their results
+    long analysedPairs = numPairings;
+    char *reached = NULL;
+    int doneTiles = 0;
+    for(int i = 0; i < numTiles; i++){
+        doneTiles += control.tileDone[i];
+    }
+    if (checkpointPath != NULL && closeCheckpoint(&checkpoint, doneTiles == numTiles)){
+        exit_status = 1;
+    }
+    if (doneTiles < numTiles){
+        fprintf(stderr, "stopped: %d of %d tiles done%s\n", doneTiles, numTiles,
+                (shardCount > 0) ? ", no shard output written" : ", printing their pairs only");
+        if (checkpointPath != NULL && exit_status == 0){
+            fprintf(stderr, "stopped: continue with --resume %s\n", checkpointPath);
+        }
+        reached = calloc(numAnalysed + 1, 1);
+        long kept = 0;
+        for(int i = 0; i < numTiles; i++){
+            if(!control.tileDone[i]) continue;
+            long pairs = tilePairs(&tiles[i]);
+            memmove(fs + kept, fs + tiles[i].base, sizeof(final_struct) * pairs);
+            kept += pairs;
+            markTileDocuments(&tiles[i], reached);
+        }
+        numPairings = kept;
+        if (exit_status == 0) exit_status = 2;
+    }
+
+    //fan the results of the distinct documents out to every copy
+    if (analysisDocs != repos.fal){
+        final_struct *distinct = fs;
+        fs = expandDuplicates(distinct, numPairings, repos.fal, numDocs, split, distinctIndex, numDistinct,
+                              analysedSplit, reached, &numPairings);
+        free(distinct);
     }
+    free(reached);
 
     //sort the contents of the final structure
     sortStruct(fs, numPairings);
 
-    //print the contents of the final structure
-    for(int i = 0; i < numPairings; i++){
-        printf("%f     %s     %s\n", fs[i].JSD, fs[i].filepath1, fs[i].filepath2);
+    if (shardCount > 0 && doneTiles < numTiles){
+        //"compare merge" needs whole shards: this one is finished by --resume
+    } else if (shardCount > 0){
+        //a shard writes its sorted partial results for "compare merge"
+        if (writeShard(stdout, shardIndex, shardCount, numDocs, fs, numPairings, threshold, metrics)){
+            perror("ERROR: could not write shard results");
+            exit_status = 1;
+        }
+    } else {
+        //print the contents of the final structure, keeping only pairs under the threshold if one was given
+        for(long i = 0; i < numPairings; i++){
+            if(threshold >= 0 && (fs[i].pruned || fs[i].JSD > threshold)){
+                continue;
+            }
+            printResult(stdout, &fs[i], metrics);
+        }
     }
 
-    //free up all resources
-    for(int i = 0; i < repos.nextIndex; i++){
-        free(repos.fal[i]->filepath);
+    if(verbose && threshold >= 0){
+        fprintf(stderr, "pruned %ld of %ld pairs using summary bounds\n", prunedPairs, analysedPairs);
+    }
+
+    //the results are out, the checkpoint of a finished run is no longer needed
+    if (checkpointPath != NULL && doneTiles == numTiles && exit_status == 0){
+        unlink(checkpointPath);
     }
+
+    //free up all resources
     free(fs);
+    free(tiles);
+    free(todo);
+    free(control.tileDone);
+    free(group);
+    free(distinctDocs);
+    free(distinctIndex);
+    free(queries);
+    free(inputs);
     free(analysisTid);
     free(analysisArgs);
     free(search_suffix);
+    if (maxMemory > 0) destroy_memory_budget(&budget);
     destroy_repository(&repos);
-    destroy_unbounded(&directoryQueue);
-    destroy_bounded(&fileQueue);
+    destroy_vocabulary(&vocab);
     destory_analysis(&analysisQueue);
+    stop_chunk_pool();
 
     return exit_status;
 }
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <zlib.h>
+
+//---------------------------------------------------------------------
+// Compressed inputs: reading gzip files without a scratch copy
+//---------------------------------------------------------------------
+
+/*
+ * A file is recognised by its first bytes, not its name: gzip starts with
+ * 1f 8b and is tokenized straight from zlib's streaming decoder (any number
+ * of concatenated members). Everything else is read as text. A compressed
+ * stream is read sequentially by one thread; only plain text over CHUNKBYTES
+ * is split between threads.
+ *
+ * With the suffix rule of -s, "name.txt.gz" matches .txt. There is no zstd
+ * decoder, so a .zst name given as an input, a --files-from entry or a
+ * --query is refused when the files are collected (see zstdName).
+ */
+
+#ifndef GZBUF
+#define GZBUF (128 * 1024)      //zlib's input buffer per file
+#endif
+
+enum { COMPRESSION_NONE, COMPRESSION_GZIP };
+
+int compressionOf(int fd){
+    unsigned char magic[4];
+    ssize_t n = pread(fd, magic, sizeof(magic), 0);
+    if(n >= 2 && magic[0] == 0x1f && magic[1] == 0x8b) return COMPRESSION_GZIP;
+    return COMPRESSION_NONE;
+}
+
+//the part of a name before a .gz extension
+size_t uncompressedLength(const char *name){
+    size_t length = strlen(name);
+    if(length > 3 && strcasecmp(name + length - 3, ".gz") == 0) return length - 3;
+    return length;
+}
+
+//whether the first length bytes of name end in .zst, which cannot be read
+int zstdName(const char *name, size_t length){
+    return length > 4 && strncasecmp(name + length - 4, ".zst", 4) == 0;
+}
+
+/**
+ * purpose: the size of the text in a file of the given size: for gzip the
+ * length its trailer records (modulo 4 GB, so never less than size).
+ */
+off_t textSize(int fd, off_t size){
+    uint32_t isize;
+    if(size >= 18 && compressionOf(fd) == COMPRESSION_GZIP && pread(fd, &isize, sizeof(isize), size - 4) == 4
+       && (off_t) isize > size){
+        return isize;
+    }
+    return size;
+}
+
+/**
+ * purpose: hand every word of a gzip file to emit, in order. Returns -1
+ * (with errno set) if the stream is corrupt or truncated; the words before
+ * the damage have been handed over. The fd is left open.
+ */
+int tokenizeGzip(int fd, int rules, void (*emit)(void *ctx, char *word), void *ctx){
+    int copy = dup(fd);
+    gzFile gz = (copy == -1) ? NULL : gzdopen(copy, "rb");
+    if(gz == NULL){
+        if(copy != -1) close(copy);
+        return -1;
+    }
+    gzbuffer(gz, GZBUF);
+
+    unsigned char *buf = malloc(TOKENBUF);
+    tokenizer_t tok;
+    init_tokenizer(&tok, rules, emit, ctx);
+    size_t have = 0;
+    int atEnd = 0;
+    int err = 0;
+
+    //decompress, keeping a character cut off at the end of the buffer for the next read
+    while(!atEnd || have > 0){
+        if(!atEnd){
+            int got = gzread(gz, buf + have, TOKENBUF - have);
+            if(got <= 0){
+                atEnd = 1;
+                err = (got < 0) ? -1 : 0;
+            } else {
+                have += got;
+            }
+        }
+        size_t used = tokenize(&tok, buf, have, atEnd);
+        memmove(buf, buf + used, have - used);
+        have -= used;
+    }
+    tokenEndWord(&tok);
+
+    //a truncated stream shows as a read error or only when it is closed
+    int zerr = Z_OK;
+    if(err) gzerror(gz, &zerr);
+    int closed = gzclose_r(gz);
+    if(!err && closed != Z_OK){
+        zerr = closed;
+        err = -1;
+    }
+    if(err && zerr != Z_ERRNO) errno = EBADMSG;
+
+    destroy_tokenizer(&tok);
+    free(buf);
+    return err;
+}
+
+/**
+ * purpose: fillList for a gzip file, counting into a word table as the
+ * chunked ranges do. Returns -1 (with errno set) if the stream is corrupt
+ * or truncated; the fd is left open.
+ */
+int fillListGzip(List **listOne, int fd, int rules){
+    wordtable_t table;
+    uint64_t word_count = 0;
+    tableWords words = { &table, &word_count };
+    init_wordtable(&table);
+
+    int err = tokenizeGzip(fd, rules, countWord, &words);
+
+    *listOne = wordtable_to_list(&table, word_count);
+    destroy_wordtable(&table);
+    return err;
+}
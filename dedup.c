@@ -0,0 +1,271 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#ifndef HASHBUF
+#define HASHBUF 65536       //bytes read at a time while hashing, a multiple of 32
+#endif
+
+//---------------------------------------------------------------------
+// Content hashes: finding byte-identical files before they are tokenized
+//---------------------------------------------------------------------
+
+/*
+ * The file threads hash every file with XXH64 before reading its words. The
+ * first file with a given (size, hash) is tokenized as usual; every later one
+ * is compared with it byte for byte and, if it is identical, only records
+ * that first document in its same field and borrows its list or vector once
+ * the collection phase is done (see shareDuplicates). A file that only
+ * collides with the first is tokenized on its own.
+ */
+
+#define XXH_PRIME1 11400714785074694791ULL
+#define XXH_PRIME2 14029467366897019727ULL
+#define XXH_PRIME3 1609587929392839161ULL
+#define XXH_PRIME4 9650029242287828579ULL
+#define XXH_PRIME5 2870177450012600261ULL
+
+uint64_t xxhRotl(uint64_t x, int r){
+    return (x << r) | (x >> (64 - r));
+}
+
+uint64_t xxhRead64(const unsigned char *p){
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+uint32_t xxhRead32(const unsigned char *p){
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+uint64_t xxhRound(uint64_t acc, uint64_t input){
+    acc += input * XXH_PRIME2;
+    acc = xxhRotl(acc, 31);
+    return acc * XXH_PRIME1;
+}
+
+uint64_t xxhMerge(uint64_t acc, uint64_t v){
+    acc ^= xxhRound(0, v);
+    return acc * XXH_PRIME1 + XXH_PRIME4;
+}
+
+/**
+ * purpose: XXH64 (seed 0) of the whole file, read from the start with pread.
+ * Returns -1 if the file could not be read.
+ */
+int hashFile(int fd, uint64_t *hashAddress, off_t *sizeAddress){
+    unsigned char *buf = malloc(HASHBUF);
+    uint64_t v1 = XXH_PRIME1 + XXH_PRIME2;
+    uint64_t v2 = XXH_PRIME2;
+    uint64_t v3 = 0;
+    uint64_t v4 = -XXH_PRIME1;
+    uint64_t total = 0;
+    size_t used = 0;
+
+    while(1){
+        //fill the buffer completely, so only the last one has a partial stripe
+        used = 0;
+        ssize_t n = 0;
+        while(used < HASHBUF && (n = pread(fd, buf + used, HASHBUF - used, total + used)) > 0){
+            used += n;
+        }
+        if(n < 0){
+            free(buf);
+            return -1;
+        }
+
+        size_t stripes = (used / 32) * 32;
+        for(size_t i = 0; i < stripes; i += 32){
+            v1 = xxhRound(v1, xxhRead64(buf + i));
+            v2 = xxhRound(v2, xxhRead64(buf + i + 8));
+            v3 = xxhRound(v3, xxhRead64(buf + i + 16));
+            v4 = xxhRound(v4, xxhRead64(buf + i + 24));
+        }
+        total += used;
+        if(used < HASHBUF){
+            memmove(buf, buf + stripes, used - stripes);
+            used -= stripes;
+            break;
+        }
+    }
+
+    uint64_t h;
+    if(total >= 32){
+        h = xxhRotl(v1, 1) + xxhRotl(v2, 7) + xxhRotl(v3, 12) + xxhRotl(v4, 18);
+        h = xxhMerge(h, v1);
+        h = xxhMerge(h, v2);
+        h = xxhMerge(h, v3);
+        h = xxhMerge(h, v4);
+    } else {
+        h = XXH_PRIME5;
+    }
+    h += total;
+
+    //the tail that did not fill a stripe
+    const unsigned char *p = buf;
+    const unsigned char *end = buf + used;
+    for(; p + 8 <= end; p += 8){
+        h ^= xxhRound(0, xxhRead64(p));
+        h = xxhRotl(h, 27) * XXH_PRIME1 + XXH_PRIME4;
+    }
+    if(p + 4 <= end){
+        h ^= (uint64_t) xxhRead32(p) * XXH_PRIME1;
+        h = xxhRotl(h, 23) * XXH_PRIME2 + XXH_PRIME3;
+        p += 4;
+    }
+    for(; p < end; p++){
+        h ^= *p * XXH_PRIME5;
+        h = xxhRotl(h, 11) * XXH_PRIME1;
+    }
+
+    h ^= h >> 33;
+    h *= XXH_PRIME2;
+    h ^= h >> 29;
+    h *= XXH_PRIME3;
+    h ^= h >> 32;
+
+    free(buf);
+    *hashAddress = h;
+    *sizeAddress = total;
+    return 0;
+}
+
+/**
+ * HOW TO: content tables
+ *
+ * declaration              dedup_table_t table;
+ *
+ * initialization           init_dedup(&table);
+ *
+ * claiming a file          FileAndList *first = claimContent(&table, hash, size, fal, fd);
+ *                          (NULL if fal is the first with this content)
+ *
+ * deallocation             destroy_dedup(&table);
+ */
+typedef struct {
+    uint64_t hash;
+    off_t size;
+    FileAndList *owner;     //NULL marks an empty slot
+} dedup_entry_t;
+
+typedef struct {
+    dedup_entry_t *entries;
+    size_t count;
+    size_t capacity;        //always a power of two
+    long duplicates;
+    pthread_mutex_t lock;
+} dedup_table_t;
+
+int init_dedup(dedup_table_t *table){
+    table->count = 0;
+    table->capacity = VOCABSIZE;
+    table->duplicates = 0;
+    table->entries = calloc(table->capacity, sizeof(dedup_entry_t));
+    if(table->entries == NULL){
+        perror("dedup init, malloc failed!");
+        return 1;
+    }
+    if(pthread_mutex_init(&table->lock, NULL)){
+        perror("lock init failed");
+        return 1;
+    }
+    return 0;
+}
+
+void destroy_dedup(dedup_table_t *table){
+    free(table->entries);
+    pthread_mutex_destroy(&table->lock);
+}
+
+/**
+ * purpose: whether the open file fd holds the same size bytes as the file at
+ * path, read HASHBUF bytes at a time. A file that cannot be read differs.
+ */
+int sameBytes(int fd, const char *path, off_t size){
+    int other = open(path, O_RDONLY, 0);
+    if(other == -1) return 0;
+    unsigned char *buf = malloc(HASHBUF);
+    unsigned char *theirs = buf + HASHBUF / 2;
+    int same = 1;
+    for(off_t done = 0; done < size && same; done += HASHBUF / 2){
+        size_t want = (size - done < HASHBUF / 2) ? (size_t) (size - done) : HASHBUF / 2;
+        same = pread(fd, buf, want, done) == (ssize_t) want && pread(other, theirs, want, done) == (ssize_t) want
+               && memcmp(buf, theirs, want) == 0;
+    }
+    free(buf);
+    close(other);
+    return same;
+}
+
+/**
+ * purpose: find the first document with this content, or make fal that
+ * document. A candidate with the same size and hash is compared with the
+ * open file fd outside the lock. Returns the earlier document, or NULL if
+ * fal is the first or only shares the hash of another.
+ */
+FileAndList *claimContent(dedup_table_t *table, uint64_t hash, off_t size, FileAndList *fal, int fd){
+    pthread_mutex_lock(&table->lock);
+
+    //grow once the table is half full
+    if(2 * (table->count + 1) > table->capacity){
+        size_t capacity = 2 * table->capacity;
+        dedup_entry_t *entries = calloc(capacity, sizeof(dedup_entry_t));
+        if(entries == NULL){
+            perror("dedup resize failed");
+            abort();
+        }
+        for(size_t i = 0; i < table->capacity; i++){
+            if(table->entries[i].owner == NULL) continue;
+            size_t slot = table->entries[i].hash & (capacity - 1);
+            while(entries[slot].owner != NULL) slot = (slot + 1) & (capacity - 1);
+            entries[slot] = table->entries[i];
+        }
+        free(table->entries);
+        table->entries = entries;
+        table->capacity = capacity;
+    }
+
+    size_t mask = table->capacity - 1;
+    size_t slot = hash & mask;
+    while(table->entries[slot].owner != NULL){
+        dedup_entry_t *entry = &table->entries[slot];
+        if(entry->hash == hash && entry->size == size){
+            FileAndList *owner = entry->owner;
+            pthread_mutex_unlock(&table->lock);
+            if(!sameBytes(fd, owner->filepath, size)) return NULL;
+            pthread_mutex_lock(&table->lock);
+            table->duplicates++;
+            pthread_mutex_unlock(&table->lock);
+            return owner;
+        }
+        slot = (slot + 1) & mask;
+    }
+    table->entries[slot].hash = hash;
+    table->entries[slot].size = size;
+    table->entries[slot].owner = fal;
+    table->count++;
+
+    pthread_mutex_unlock(&table->lock);
+    return NULL;
+}
+
+/**
+ * purpose: once every file is read, point each duplicate at the words of the
+ * document it is identical to.
+ */
+void shareDuplicates(repository *repos){
+    for(int i = 0; i < repos->nextIndex; i++){
+        FileAndList *fal = repos->fal[i];
+        if(fal->same == NULL) continue;
+        fal->list = fal->same->list;
+        fal->vec = fal->same->vec;
+        fal->summary = fal->same->summary;
+    }
+}
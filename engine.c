@@ -0,0 +1,576 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "jsd.h"
+#include "repo.c"
+#include "vector.c"
+#include "chunk.c"
+#include "compressed.c"
+#include "ngram.c"
+#include "snapshot.c"
+#include "index.c"
+#include "vptree.c"
+
+//---------------------------------------------------------------------
+// Loading documents
+//---------------------------------------------------------------------
+
+/**
+ * purpose: sort and summarize a freshly counted list and store it in a
+ * document, swapping it for a compact vector when vocab is given.
+ */
+void finishDocument(FileAndList *fal, List *listOne, vocabulary_t *vocab){
+    listOne = sortList(listOne);
+    summarizeList(listOne, &fal->summary);
+    fal->vec = NULL;
+    fal->same = NULL;
+    if (vocab != NULL){
+        //swap the list for its compact vector
+        fal->vec = vectorFromList(listOne, vocab);
+        destroy_list(&listOne);
+    }
+    fal->list = listOne;
+}
+
+/**
+ * purpose: read an open file into a document's list (or vector), then sort
+ * and summarize it for the analysis phase. Words are read with the given
+ * tokenizer rules. Files over CHUNKBYTES are split into ranges counted by up
+ * to chunkThreads threads, and gzip files are decompressed as they are read
+ * (see compressed.c). With ngram > 1 the document holds the vector of its
+ * n-grams instead (see ngram.c). The file is not closed.
+ * Returns -1 with errno set if the file cannot be decoded; the document is
+ * then finished empty.
+ */
+int readDocument(FileAndList *fal, int file, vocabulary_t *vocab, int chunkThreads, int rules, int ngram){
+    if (ngram > 1){
+        return readNgramDocument(fal, file, chunkThreads, rules, ngram);
+    }
+
+    List * listOne = NULL;
+    int err = 0;
+
+    struct stat fileData;
+    int compression = compressionOf(file);
+    if (compression == COMPRESSION_GZIP){
+        err = fillListGzip(&listOne, file, rules);
+    } else if (fstat(file, &fileData) == 0 && S_ISREG(fileData.st_mode) && fileData.st_size > CHUNKBYTES){
+        fillListChunked(&listOne, file, fileData.st_size, chunkThreads, rules);
+    } else {
+        fillList(&listOne, file, rules);
+    }
+
+    //a document is all of its file or nothing
+    if (err){
+        int saved = errno;
+        destroy_list(&listOne);
+        errno = saved;
+    }
+    finishDocument(fal, listOne, vocab);
+    return err;
+}
+
+/**
+ * purpose: readDocument by path.
+ * Returns -1 if the file could not be opened or decoded, leaving the
+ * document empty (and, if it was opened, finished).
+ */
+int loadDocument(FileAndList *fal, vocabulary_t *vocab, int chunkThreads, int rules, int ngram){
+    fal->list = NULL;
+    fal->vec = NULL;
+    fal->same = NULL;
+    summarizeList(NULL, &fal->summary);
+
+    int file = open(fal->filepath, O_RDONLY, 0);
+    if(file == -1){
+        return -1;
+    }
+    int err = readDocument(fal, file, vocab, chunkThreads, rules, ngram);
+    int saved = errno;
+    close(file);
+    errno = saved;
+    return err;
+}
+
+/**
+ * purpose: read a file to compare against the corpus without adding it:
+ * its words are looked up in the vocabulary but never interned.
+ * Returns NULL if the file could not be read.
+ */
+DocVector *loadQueryVector(char *path, vocabulary_t *vocab, int chunkThreads, int rules){
+    FileAndList query;
+    query.filepath = path;
+    if(loadDocument(&query, NULL, chunkThreads, rules, 1)){
+        destroy_list(&query.list);
+        return NULL;
+    }
+    DocVector *vec = vectorLookupList(query.list, vocab);
+    destroy_list(&query.list);
+    return vec;
+}
+
+//---------------------------------------------------------------------
+// Thread pool
+//---------------------------------------------------------------------
+
+/*
+ * A batch is a task function run once for every index in [0, numTasks).
+ * Batches queue up in order and the caller of pool_run sleeps until every
+ * task of its own batch is done, so several threads can share one pool.
+ */
+typedef struct pool_batch {
+    void (*task)(void *ctx, int index);
+    void *ctx;
+    int numTasks;
+    int nextTask;
+    int doneTasks;
+    struct pool_batch *next;
+} pool_batch_t;
+
+typedef struct {
+    pthread_t *tids;
+    int numThreads;
+    pool_batch_t *head;
+    pool_batch_t *tail;
+    int open;
+    pthread_mutex_t lock;
+    pthread_cond_t work_ready;
+    pthread_cond_t batch_done;
+} pool_t;
+
+void* poolThreadTask(void* arg){
+    pool_t *pool = arg;
+
+    pthread_mutex_lock(&pool->lock);
+    while(1){
+        while(pool->head == NULL && pool->open){
+            pthread_cond_wait(&pool->work_ready, &pool->lock);
+        }
+        if(pool->head == NULL){
+            break;
+        }
+
+        //claim the next task, retiring the batch once every task is handed out
+        pool_batch_t *batch = pool->head;
+        int index = batch->nextTask++;
+        if(batch->nextTask == batch->numTasks){
+            pool->head = batch->next;
+            if(pool->head == NULL) pool->tail = NULL;
+        }
+        pthread_mutex_unlock(&pool->lock);
+
+        batch->task(batch->ctx, index);
+
+        pthread_mutex_lock(&pool->lock);
+        batch->doneTasks++;
+        if(batch->doneTasks == batch->numTasks){
+            pthread_cond_broadcast(&pool->batch_done);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
+
+int init_pool(pool_t *pool, int numThreads){
+    pool->numThreads = numThreads;
+    pool->head = NULL;
+    pool->tail = NULL;
+    pool->open = 1;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_ready, NULL);
+    pthread_cond_init(&pool->batch_done, NULL);
+    pool->tids = malloc(sizeof(pthread_t) * numThreads);
+    for(int i = 0; i < numThreads; i++){
+        if(pthread_create(&pool->tids[i], NULL, poolThreadTask, pool)){
+            perror("pool thread creation failed");
+            abort();
+        }
+    }
+    return 0;
+}
+
+int destroy_pool(pool_t *pool){
+    pthread_mutex_lock(&pool->lock);
+    pool->open = 0;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+    for(int i = 0; i < pool->numThreads; i++){
+        pthread_join(pool->tids[i], NULL);
+    }
+    free(pool->tids);
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->work_ready);
+    pthread_cond_destroy(&pool->batch_done);
+    return 0;
+}
+
+/**
+ * purpose: run task(ctx, i) for every i in [0, numTasks) on the pool and
+ * wait for all of them.
+ */
+void pool_run(pool_t *pool, void (*task)(void *ctx, int index), void *ctx, int numTasks){
+    if(numTasks <= 0) return;
+
+    pool_batch_t batch;
+    batch.task = task;
+    batch.ctx = ctx;
+    batch.numTasks = numTasks;
+    batch.nextTask = 0;
+    batch.doneTasks = 0;
+    batch.next = NULL;
+
+    pthread_mutex_lock(&pool->lock);
+    if(pool->tail != NULL){
+        pool->tail->next = &batch;
+    } else {
+        pool->head = &batch;
+    }
+    pool->tail = &batch;
+    pthread_cond_broadcast(&pool->work_ready);
+    while(batch.doneTasks < batch.numTasks){
+        pthread_cond_wait(&pool->batch_done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+//---------------------------------------------------------------------
+// Engine
+//---------------------------------------------------------------------
+
+#ifndef QUERY_BATCH
+#define QUERY_BATCH 16      //most queries sharing one walk of the index
+#endif
+
+struct jsd_engine {
+    pool_t pool;
+    repository repos;
+    vocabulary_t vocab;
+    inverted_index_t index;
+    int indexedDocs;            //documents in the index, -1 before it is first built
+    char *removed;              //removed[id] is set once document id was removed
+    int removedCapacity;
+    int numRemoved;
+    int rules;                  //tokenizer rules every document and query is read with
+    int ngram;                  //words per n-gram, 1 for plain words
+    pthread_rwlock_t lock;      //exclusive to change repos or the index, shared to read them
+};
+
+jsd_engine *jsd_engine_create(int threads){
+    return jsd_engine_create_with(threads, NULL);
+}
+
+jsd_engine *jsd_engine_create_with(int threads, const jsd_options *options){
+    if(threads < 1) threads = 1;
+    int rules = RULES_DEFAULT;
+    int ngram = 1;
+    if(options != NULL && options->rules != NULL && (rules = findTokenRules(options->rules)) < 0) return NULL;
+    if(options != NULL && options->ngram > 1) ngram = options->ngram;
+    if(ngram > NGRAM_MAX) return NULL;
+
+    jsd_engine *engine = malloc(sizeof(jsd_engine));
+    if(engine == NULL) return NULL;
+    engine->rules = rules;
+    engine->ngram = ngram;
+    if(init_repository(&engine->repos, 1) || init_vocabulary(&engine->vocab)){
+        free(engine);
+        return NULL;
+    }
+    engine->indexedDocs = -1;
+    engine->removed = NULL;
+    engine->removedCapacity = 0;
+    engine->numRemoved = 0;
+    pthread_rwlock_init(&engine->lock, NULL);
+    init_pool(&engine->pool, threads);
+    return engine;
+}
+
+void jsd_engine_destroy(jsd_engine *engine){
+    if(engine == NULL) return;
+    destroy_pool(&engine->pool);
+    if(engine->indexedDocs >= 0) destroy_index(&engine->index);
+    destroy_repository(&engine->repos);
+    destroy_vocabulary(&engine->vocab);
+    free(engine->removed);
+    pthread_rwlock_destroy(&engine->lock);
+    free(engine);
+}
+
+int jsd_engine_count(jsd_engine *engine){
+    pthread_rwlock_rdlock(&engine->lock);
+    int count = engine->repos.nextIndex - engine->numRemoved;
+    pthread_rwlock_unlock(&engine->lock);
+    return count;
+}
+
+/**
+ * purpose: grow the removed flags to cover every document ID.
+ * Called with the engine's write lock held.
+ */
+void growRemoved(jsd_engine *engine){
+    if(engine->removedCapacity >= engine->repos.size) return;
+    char *removed = realloc(engine->removed, engine->repos.size);
+    if(removed == NULL){
+        perror("engine resize failed");
+        abort();
+    }
+    memset(removed + engine->removedCapacity, 0, engine->repos.size - engine->removedCapacity);
+    engine->removed = removed;
+    engine->removedCapacity = engine->repos.size;
+}
+
+/**
+ * purpose: append a loaded document and return its ID.
+ */
+int engineAppend(jsd_engine *engine, FileAndList *fal){
+    pthread_rwlock_wrlock(&engine->lock);
+    append_repository(&engine->repos, fal);
+    growRemoved(engine);
+    int id = engine->repos.nextIndex - 1;
+    pthread_rwlock_unlock(&engine->lock);
+    return id;
+}
+
+/**
+ * purpose: adopt documents placed straight into the engine's repository
+ * (by a collection phase or a snapshot) before the engine is shared.
+ */
+void engineAdopt(jsd_engine *engine){
+    growRemoved(engine);
+}
+
+int jsd_engine_remove(jsd_engine *engine, int id){
+    int err = -1;
+    pthread_rwlock_wrlock(&engine->lock);
+    if(id >= 0 && id < engine->repos.nextIndex && !engine->removed[id]){
+        //keep the slot so IDs stay stable, but drop the words
+        FileAndList *fal = engine->repos.fal[id];
+        if(id >= engine->repos.mappedDocs){
+            destroy_list(&fal->list);
+            if(fal->vec != NULL) free(fal->vec->data);
+        }
+        if(fal->vec != NULL){
+            fal->vec->data = NULL;
+            fal->vec->bytes = 0;
+            fal->vec->length = 0;
+            fal->vec->total = 0;
+        }
+        fal->list = NULL;
+        summarizeList(NULL, &fal->summary);
+        engine->removed[id] = 1;
+        engine->numRemoved++;
+        err = 0;
+    }
+    pthread_rwlock_unlock(&engine->lock);
+    return err;
+}
+
+int jsd_engine_add_path(jsd_engine *engine, const char *path){
+    FileAndList *fal = malloc(sizeof(FileAndList));
+    fal->filepath = malloc(strlen(path) + 1);
+    strcpy(fal->filepath, path);
+
+    //tokenizing happens outside the engine lock
+    if(loadDocument(fal, &engine->vocab, engine->pool.numThreads, engine->rules, engine->ngram)){
+        destroy_list(&fal->list);
+        destroy_vector(fal->vec);
+        free(fal->filepath);
+        free(fal);
+        return -1;
+    }
+    return engineAppend(engine, fal);
+}
+
+int jsd_engine_add_buffer(jsd_engine *engine, const char *name, const char *data, size_t length){
+    FileAndList *fal = malloc(sizeof(FileAndList));
+    fal->filepath = malloc(strlen(name) + 1);
+    strcpy(fal->filepath, name);
+    if(engine->ngram > 1){
+        ngramDocumentFromBuffer(fal, data, length, engine->rules, engine->ngram);
+    } else {
+        finishDocument(fal, listFromBuffer(data, length, engine->rules), &engine->vocab);
+    }
+    return engineAppend(engine, fal);
+}
+
+double jsd_engine_pair(jsd_engine *engine, int id1, int id2){
+    double jsd = -1;
+    int wordCount;
+    pthread_rwlock_rdlock(&engine->lock);
+    if(id1 >= 0 && id2 >= 0 && id1 < engine->repos.nextIndex && id2 < engine->repos.nextIndex
+       && !engine->removed[id1] && !engine->removed[id2]){
+        jsd = documentJSD(engine->repos.fal[id1], engine->repos.fal[id2], &wordCount);
+    }
+    pthread_rwlock_unlock(&engine->lock);
+    return jsd;
+}
+
+/**
+ * purpose: rebuild the inverted index if documents were added since it was
+ * built. Called and returns with the engine's read lock held.
+ */
+void refreshIndex(jsd_engine *engine){
+    while(engine->indexedDocs != engine->repos.nextIndex){
+        //trade the read lock for the write lock, then look again
+        pthread_rwlock_unlock(&engine->lock);
+        pthread_rwlock_wrlock(&engine->lock);
+        if(engine->indexedDocs != engine->repos.nextIndex){
+            if(engine->indexedDocs >= 0) destroy_index(&engine->index);
+            pthread_mutex_lock(&engine->vocab.lock);
+            uint64_t numWords = engine->vocab.count;
+            pthread_mutex_unlock(&engine->vocab.lock);
+            init_index(&engine->index, engine->repos.fal, engine->repos.nextIndex, numWords);
+            engine->indexedDocs = engine->repos.nextIndex;
+        }
+        pthread_rwlock_unlock(&engine->lock);
+        pthread_rwlock_rdlock(&engine->lock);
+    }
+}
+
+typedef struct {
+    jsd_engine *engine;
+    const char **data;
+    const size_t *lengths;
+    DocVector **queries;
+    int numQueries;
+    int groupSize;
+    int k;
+    index_match_t *best;
+    int *found;
+} query_ctx_t;
+
+void tokenizeQueryTask(void *arg, int index){
+    query_ctx_t *ctx = arg;
+    List *list = sortList(listFromBuffer(ctx->data[index], ctx->lengths[index], ctx->engine->rules));
+    ctx->queries[index] = vectorLookupList(list, &ctx->engine->vocab);
+    destroy_list(&list);
+}
+
+void queryGroupTask(void *arg, int index){
+    query_ctx_t *ctx = arg;
+    int first = index * ctx->groupSize;
+    int count = (ctx->numQueries - first < ctx->groupSize) ? ctx->numQueries - first : ctx->groupSize;
+    query_index_batch(&ctx->engine->index, ctx->queries + first, count, ctx->k, ctx->engine->removed,
+                      ctx->best + (size_t) first * ctx->k, ctx->found + first);
+}
+
+int jsd_engine_query_batch(jsd_engine *engine, const char **data, const size_t *lengths, int numQueries,
+                           jsd_match *matches, int k, int *found){
+    if(numQueries <= 0) return 0;
+    if(engine->ngram > 1){
+        memset(found, 0, sizeof(int) * numQueries);
+        return -1;
+    }
+    if(k <= 0){
+        memset(found, 0, sizeof(int) * numQueries);
+        return 0;
+    }
+
+    query_ctx_t ctx;
+    ctx.engine = engine;
+    ctx.data = data;
+    ctx.lengths = lengths;
+    ctx.numQueries = numQueries;
+    ctx.k = k;
+    ctx.queries = malloc(sizeof(DocVector *) * numQueries);
+    ctx.best = malloc(sizeof(index_match_t) * numQueries * k);
+    ctx.found = found;
+
+    //one group of queries per pool thread, each group sharing its index scans
+    ctx.groupSize = (numQueries + engine->pool.numThreads - 1) / engine->pool.numThreads;
+    if(ctx.groupSize > QUERY_BATCH) ctx.groupSize = QUERY_BATCH;
+    int numGroups = (numQueries + ctx.groupSize - 1) / ctx.groupSize;
+
+    pool_run(&engine->pool, tokenizeQueryTask, &ctx, numQueries);
+
+    pthread_rwlock_rdlock(&engine->lock);
+    refreshIndex(engine);
+    pool_run(&engine->pool, queryGroupTask, &ctx, numGroups);
+
+    int total = 0;
+    for(int q = 0; q < numQueries; q++){
+        for(int i = 0; i < found[q]; i++){
+            index_match_t *match = &ctx.best[(size_t) q * k + i];
+            matches[(size_t) q * k + i].id = match->doc;
+            matches[(size_t) q * k + i].name = engine->repos.fal[match->doc]->filepath;
+            matches[(size_t) q * k + i].jsd = match->JSD;
+        }
+        total += found[q];
+    }
+    pthread_rwlock_unlock(&engine->lock);
+
+    for(int q = 0; q < numQueries; q++){
+        destroy_vector(ctx.queries[q]);
+    }
+    free(ctx.queries);
+    free(ctx.best);
+    return total;
+}
+
+int jsd_engine_query(jsd_engine *engine, const char *data, size_t length, jsd_match *matches, int k){
+    int found = 0;
+    if(jsd_engine_query_batch(engine, &data, &length, 1, matches, k, &found) < 0) return -1;
+    return found;
+}
+
+typedef struct {
+    jsd_engine *engine;
+    pair_tile_t *tiles;
+    jsd_pair_callback callback;
+    void *userCtx;
+    long made;                  //callbacks made, under callbackLock
+    pthread_mutex_t callbackLock;
+} pairs_ctx_t;
+
+void pairsTask(void *arg, int index){
+    pairs_ctx_t *ctx = arg;
+    pair_tile_t *tile = &ctx->tiles[index];
+    FileAndList **docs = ctx->engine->repos.fal;
+
+    for(int i = tile->rowStart; i < tile->rowEnd; i++){
+        int j = (tile->colStart > i + 1) ? tile->colStart : i + 1;
+        for(; j < tile->colEnd; j++){
+            if(ctx->engine->removed[i] || ctx->engine->removed[j]) continue;
+            jsd_pair pair;
+            pair.id1 = i;
+            pair.id2 = j;
+            pair.name1 = docs[i]->filepath;
+            pair.name2 = docs[j]->filepath;
+            pair.jsd = documentJSD(docs[i], docs[j], &pair.totalWords);
+
+            pthread_mutex_lock(&ctx->callbackLock);
+            ctx->callback(&pair, ctx->userCtx);
+            ctx->made++;
+            pthread_mutex_unlock(&ctx->callbackLock);
+        }
+    }
+}
+
+long jsd_engine_all_pairs(jsd_engine *engine, jsd_pair_callback callback, void *ctx){
+    pthread_rwlock_rdlock(&engine->lock);
+
+    pairs_ctx_t pairs;
+    int capacity = 0;
+    long numPairs = 0;
+    int numDocs = engine->repos.nextIndex;
+    pairs.engine = engine;
+    pairs.tiles = NULL;
+    pairs.callback = callback;
+    pairs.userCtx = ctx;
+    pairs.made = 0;
+    pthread_mutex_init(&pairs.callbackLock, NULL);
+    int numTiles = addTiles(&pairs.tiles, 0, &capacity, 0, numDocs, 0, numDocs, TILESIZE, &numPairs);
+
+    pool_run(&engine->pool, pairsTask, &pairs, numTiles);
+
+    pthread_rwlock_unlock(&engine->lock);
+
+    pthread_mutex_destroy(&pairs.callbackLock);
+    free(pairs.tiles);
+    return pairs.made;
+}
@@ -0,0 +1,160 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ucdranges.h"
+
+//---------------------------------------------------------------------
+// Build time generator of the tokenizer tables, see token.c
+//---------------------------------------------------------------------
+
+/*
+ * make runs this program and writes its output to tokentables.h. Every rule
+ * set gets a 256 entry table that says what each byte is:
+ *
+ *     TOKEN_SEPARATOR   ends the current word
+ *     TOKEN_DROP        belongs to the word but is not kept ("don't" -> "dont")
+ *     TOKEN_MULTIBYTE   starts or continues a UTF-8 sequence (utf8 rules only)
+ *     anything else     the byte to keep, already case folded
+ *
+ * The utf8 rules also get tokenFold2, the same information for every two
+ * byte sequence (U+0080 to U+07FF): the folded code point, 0 to drop it or
+ * TOKEN_FOLD_SEPARATOR. Longer sequences are looked up in tokenRanges, sorted
+ * ranges of spaces and of letters, digits and marks to fold; a code point in
+ * no range is dropped. Both come from ucdranges.h, which ucdranges.py writes
+ * from the Unicode Character Database.
+ *
+ * The tables only depend on this file and ucdranges.h, never on the locale of
+ * the build or of the run.
+ */
+
+#define TOKEN_SEPARATOR -1
+#define TOKEN_DROP 0
+#define TOKEN_MULTIBYTE -2
+#define TOKEN_WORD 1
+#define TOKEN_FOLD_SEPARATOR 0xFFFF
+
+enum { RULES_DEFAULT, RULES_ALNUM, RULES_UTF8, NUM_RULES };
+static const char *ruleNames[NUM_RULES] = { "default", "alnum", "utf8" };
+
+int isAsciiSpace(int c){
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+int isAsciiAlpha(int c){
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+int isAsciiDigit(int c){
+    return c >= '0' && c <= '9';
+}
+
+int asciiLower(int c){
+    return (c >= 'A' && c <= 'Z') ? c + 32 : c;
+}
+
+int byteRule(int rules, int c){
+    switch(rules){
+    case RULES_ALNUM:
+        //letters and digits; every other byte splits words
+        if(isAsciiAlpha(c)) return asciiLower(c);
+        if(isAsciiDigit(c)) return c;
+        return TOKEN_SEPARATOR;
+
+    case RULES_UTF8:
+        if(c >= 0x80) return TOKEN_MULTIBYTE;
+        //fall through: ASCII as in the default rules
+
+    default:
+        //the original rules of fillList in the C locale
+        if(isAsciiSpace(c)) return TOKEN_SEPARATOR;
+        if(isAsciiAlpha(c)) return asciiLower(c);
+        if(isAsciiDigit(c) || c == '-') return c;
+        return TOKEN_DROP;
+    }
+}
+
+/**
+ * purpose: what a code point from U+0080 up becomes under the utf8 rules: its
+ * folded code point, TOKEN_FOLD_SEPARATOR or TOKEN_DROP.
+ */
+int foldRule(int cp){
+    for(int i = 0; i < NUM_UCD_RANGES && ucdRanges[i][0] <= cp; i++){
+        if(cp > ucdRanges[i][1]) continue;
+        if(ucdRanges[i][2] == TOKEN_SEPARATOR) return TOKEN_FOLD_SEPARATOR;
+        return ucdRanges[i][3] + (cp - ucdRanges[i][0]);
+    }
+    return TOKEN_DROP;
+}
+
+typedef struct {
+    int first;
+    int last;
+    int kind;               //TOKEN_SEPARATOR or TOKEN_WORD
+    int fold;               //what first folds to, for a kept range
+} range_t;
+
+range_t ranges[NUM_UCD_RANGES];
+int numRanges = 0;
+
+/**
+ * purpose: the ranges of ucdranges.h from U+0800 up, checked to be sorted.
+ */
+void buildRanges(void){
+    for(int i = 0; i < NUM_UCD_RANGES; i++){
+        if(ucdRanges[i][1] < 0x800) continue;
+        range_t r = { ucdRanges[i][0], ucdRanges[i][1], ucdRanges[i][2], ucdRanges[i][3] };
+        if(r.first < 0x800){
+            r.fold += 0x800 - r.first;
+            r.first = 0x800;
+        }
+        if(numRanges > 0 && r.first <= ranges[numRanges - 1].last){
+            fprintf(stderr, "gentables: ranges at U+%04X overlap\n", r.first);
+            exit(1);
+        }
+        ranges[numRanges++] = r;
+    }
+}
+
+int main(void){
+    printf("//generated by gentables.c, do not edit\n\n");
+    printf("#define TOKEN_SEPARATOR %d\n", TOKEN_SEPARATOR);
+    printf("#define TOKEN_DROP %d\n", TOKEN_DROP);
+    printf("#define TOKEN_MULTIBYTE %d\n", TOKEN_MULTIBYTE);
+    printf("#define TOKEN_WORD %d\n", TOKEN_WORD);
+    printf("#define TOKEN_FOLD_SEPARATOR 0x%X\n\n", TOKEN_FOLD_SEPARATOR);
+
+    printf("enum { ");
+    for(int r = 0; r < NUM_RULES; r++) printf("RULES_%s, ", r == RULES_DEFAULT ? "DEFAULT" : r == RULES_ALNUM ? "ALNUM" : "UTF8");
+    printf("NUM_RULES };\n\n");
+
+    printf("static const char *tokenRuleNames[NUM_RULES] = { ");
+    for(int r = 0; r < NUM_RULES; r++) printf("\"%s\"%s", ruleNames[r], r + 1 < NUM_RULES ? ", " : " ");
+    printf("};\n\n");
+
+    printf("static const short tokenTable[NUM_RULES][256] = {\n");
+    for(int r = 0; r < NUM_RULES; r++){
+        printf("    { //%s", ruleNames[r]);
+        for(int c = 0; c < 256; c++){
+            printf("%s%d,", (c % 16 == 0) ? "\n        " : " ", byteRule(r, c));
+        }
+        printf("\n    },\n");
+    }
+    printf("};\n\n");
+
+    printf("static const unsigned short tokenFold2[0x800] = {");
+    for(int cp = 0; cp < 0x800; cp++){
+        printf("%s0x%X,", (cp % 12 == 0) ? "\n    " : " ", cp < 0x80 ? 0 : foldRule(cp));
+    }
+    printf("\n};\n\n");
+
+    buildRanges();
+    printf("typedef struct {\n    unsigned int first;\n    unsigned int last;\n    int kind;\n    unsigned int fold;\n} token_range_t;\n\n");
+    printf("#define NUM_TOKEN_RANGES %d\n\n", numRanges);
+    printf("static const token_range_t tokenRanges[NUM_TOKEN_RANGES] = {\n");
+    for(int i = 0; i < numRanges; i++){
+        printf("    { 0x%X, 0x%X, %d, 0x%X },\n", ranges[i].first, ranges[i].last, ranges[i].kind, ranges[i].fold);
+    }
+    printf("};\n");
+
+    return 0;
+}
@@ -0,0 +1,314 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+//---------------------------------------------------------------------
+// Inverted index: word ID -> postings of (document, WFD)
+//---------------------------------------------------------------------
+
+/*
+ * For a query q and a document p that share the words S, the JS divergence
+ * splits into the shared terms and the mass each side has outside S (a word
+ * only one side has contributes its WFD, as in vectorJSD):
+ *
+ *     JS = 1/2 (sum over S of q log2(q/m) + p log2(p/m))
+ *        + 1/2 (mass(q) - q(S)) + 1/2 (mass(p) - p(S))
+ *
+ * so walking the postings of the query's words is enough to score every
+ * document that shares a word with it. Documents that share nothing are at
+ * distance 1 (sqrt(0.5) when one side is empty), like calculateJSD.
+ */
+
+typedef struct {
+    int doc;
+    double WFD;
+} posting_t;
+
+typedef struct {
+    uint64_t numWords;
+    long *offsets;          //postings of word w are [offsets[w], offsets[w + 1])
+    posting_t *postings;
+    int numDocs;
+    double *mass;           //1 for a non-empty document, 0 otherwise
+    int *emptyDocs;         //documents without words, which no posting points to
+    int numEmpty;
+} inverted_index_t;
+
+typedef struct {
+    int doc;
+    double JSD;
+} index_match_t;
+
+/**
+ * purpose: build the index of docs[0..numDocs), which must hold compact
+ * vectors whose IDs are below numWords.
+ */
+int init_index(inverted_index_t *index, FileAndList **docs, int numDocs, uint64_t numWords){
+    index->numWords = numWords;
+    index->numDocs = numDocs;
+    index->offsets = calloc(numWords + 1, sizeof(long));
+    index->mass = malloc(sizeof(double) * (numDocs + 1));
+    index->emptyDocs = malloc(sizeof(int) * (numDocs + 1));
+    index->numEmpty = 0;
+
+    //first pass counts the postings of every word
+    long total = 0;
+    for(int d = 0; d < numDocs; d++){
+        DocVector *vec = docs[d]->vec;
+        const unsigned char *p = vec->data;
+        uint64_t id = 0;
+        for(int i = 0; i < vec->length; i++){
+            id += getVarint(&p);
+            getVarint(&p);
+            index->offsets[id + 1]++;
+        }
+        total += vec->length;
+        index->mass[d] = (vec->length > 0) ? 1 : 0;
+        if(vec->length == 0){
+            index->emptyDocs[index->numEmpty++] = d;
+        }
+    }
+    for(uint64_t w = 0; w < numWords; w++){
+        index->offsets[w + 1] += index->offsets[w];
+    }
+
+    //second pass fills them in, in document order
+    index->postings = malloc(sizeof(posting_t) * (total + 1));
+    long *next = malloc(sizeof(long) * (numWords + 1));
+    memcpy(next, index->offsets, sizeof(long) * (numWords + 1));
+    for(int d = 0; d < numDocs; d++){
+        DocVector *vec = docs[d]->vec;
+        const unsigned char *p = vec->data;
+        uint64_t id = 0;
+        for(int i = 0; i < vec->length; i++){
+            id += getVarint(&p);
+            posting_t *posting = &index->postings[next[id]++];
+            posting->doc = d;
+            posting->WFD = (double) getVarint(&p) / vec->total;
+        }
+    }
+    free(next);
+    return 0;
+}
+
+void destroy_index(inverted_index_t *index){
+    free(index->offsets);
+    free(index->postings);
+    free(index->mass);
+    free(index->emptyDocs);
+}
+
+int compareIndexMatches(const void *a, const void *b){
+    const index_match_t *x = a;
+    const index_match_t *y = b;
+    if(x->JSD != y->JSD) return (x->JSD > y->JSD) - (x->JSD < y->JSD);
+    return (x->doc > y->doc) - (x->doc < y->doc);
+}
+
+/**
+ * purpose: keep the k best matches in a sorted array of *count entries.
+ */
+void offerIndexMatch(index_match_t *best, int *count, int k, int doc, double JSD){
+    index_match_t candidate = { doc, JSD };
+    if(*count == k && compareIndexMatches(&candidate, &best[k - 1]) >= 0){
+        return;
+    }
+    int pos = (*count < k) ? (*count)++ : k - 1;
+    while(pos > 0 && compareIndexMatches(&candidate, &best[pos - 1]) < 0){
+        best[pos] = best[pos - 1];
+        pos--;
+    }
+    best[pos] = candidate;
+}
+
+//one query's word, while a batch of queries walks the postings together
+typedef struct {
+    uint64_t id;
+    int query;
+    double WFD;
+} query_term_t;
+
+int compareQueryTerms(const void *a, const void *b){
+    const query_term_t *x = a;
+    const query_term_t *y = b;
+    if(x->id != y->id) return (x->id > y->id) - (x->id < y->id);
+    return (x->query > y->query) - (x->query < y->query);
+}
+
+//a document's sums over the words it shares with a query
+typedef struct {
+    int doc;                //-1 marks an empty slot
+    double shared;          //the query's WFD on shared words
+    double docShared;       //the document's WFD on shared words
+    double terms;
+} doc_sums_t;
+
+//the documents one query has touched, by open addressing on the document, so
+//a query costs the postings it reads rather than the size of the corpus
+typedef struct {
+    doc_sums_t *slots;
+    unsigned capacity;      //a power of two, kept at least twice used
+    unsigned used;
+} doc_accumulator_t;
+
+void init_accumulator(doc_accumulator_t *acc){
+    acc->capacity = 64;
+    acc->used = 0;
+    acc->slots = malloc(sizeof(doc_sums_t) * acc->capacity);
+    for(unsigned i = 0; i < acc->capacity; i++){
+        acc->slots[i].doc = -1;
+    }
+}
+
+void destroy_accumulator(doc_accumulator_t *acc){
+    free(acc->slots);
+}
+
+static inline unsigned accumulatorHome(const doc_accumulator_t *acc, int doc){
+    return (unsigned) (((uint64_t) doc * 0x9E3779B97F4A7C15ULL) >> 32) & (acc->capacity - 1);
+}
+
+//the sums of doc, or NULL if the query has not touched it
+doc_sums_t *findSums(const doc_accumulator_t *acc, int doc){
+    for(unsigned i = accumulatorHome(acc, doc); ; i = (i + 1) & (acc->capacity - 1)){
+        if(acc->slots[i].doc == doc) return &acc->slots[i];
+        if(acc->slots[i].doc < 0) return NULL;
+    }
+}
+
+//the sums of doc, starting at zero the first time it is touched
+doc_sums_t *touchSums(doc_accumulator_t *acc, int doc){
+    if(2 * (acc->used + 1) > acc->capacity){
+        doc_sums_t *old = acc->slots;
+        unsigned oldCapacity = acc->capacity;
+        acc->capacity *= 2;
+        acc->slots = malloc(sizeof(doc_sums_t) * acc->capacity);
+        for(unsigned i = 0; i < acc->capacity; i++){
+            acc->slots[i].doc = -1;
+        }
+        for(unsigned i = 0; i < oldCapacity; i++){
+            if(old[i].doc < 0) continue;
+            unsigned j = accumulatorHome(acc, old[i].doc);
+            while(acc->slots[j].doc >= 0) j = (j + 1) & (acc->capacity - 1);
+            acc->slots[j] = old[i];
+        }
+        free(old);
+    }
+
+    unsigned i = accumulatorHome(acc, doc);
+    while(acc->slots[i].doc >= 0 && acc->slots[i].doc != doc){
+        i = (i + 1) & (acc->capacity - 1);
+    }
+    if(acc->slots[i].doc < 0){
+        acc->slots[i].doc = doc;
+        acc->slots[i].shared = 0;
+        acc->slots[i].docShared = 0;
+        acc->slots[i].terms = 0;
+        acc->used++;
+    }
+    return &acc->slots[i];
+}
+
+/**
+ * purpose: the k documents closest to each of numQueries query vectors,
+ * closest first with ties to the lower document. skip (may be NULL) flags
+ * documents to leave out. The matches of query q go to best[q * k ...] and
+ * their number to found[q].
+ *
+ * The postings of a word are read once for the whole batch, however many of
+ * the queries contain it. The partial sums live in one accumulator per query
+ * holding only the documents that share a word with it.
+ */
+void query_index_batch(inverted_index_t *index, DocVector **queries, int numQueries, int k,
+                       const char *skip, index_match_t *best, int *found){
+    doc_accumulator_t *sums = malloc(sizeof(doc_accumulator_t) * (numQueries + 1));
+    for(int q = 0; q < numQueries; q++){
+        init_accumulator(&sums[q]);
+    }
+
+    //gather the words of every query, grouped by word ID
+    int numTerms = 0;
+    for(int q = 0; q < numQueries; q++){
+        numTerms += queries[q]->length;
+    }
+    query_term_t *batch = malloc(sizeof(query_term_t) * (numTerms + 1));
+    numTerms = 0;
+    for(int q = 0; q < numQueries; q++){
+        const unsigned char *p = queries[q]->data;
+        uint64_t id = 0;
+        for(int i = 0; i < queries[q]->length; i++){
+            id += getVarint(&p);
+            double WFD = (double) getVarint(&p) / queries[q]->total;
+            if(id >= index->numWords) continue;
+            batch[numTerms].id = id;
+            batch[numTerms].query = q;
+            batch[numTerms].WFD = WFD;
+            numTerms++;
+        }
+    }
+    qsort(batch, numTerms, sizeof(query_term_t), compareQueryTerms);
+
+    //only the postings of the queries' words are read, each list once
+    for(int t = 0; t < numTerms; ){
+        int end = t;
+        while(end < numTerms && batch[end].id == batch[t].id) end++;
+
+        uint64_t id = batch[t].id;
+        for(long n = index->offsets[id]; n < index->offsets[id + 1]; n++){
+            posting_t *posting = &index->postings[n];
+            for(int b = t; b < end; b++){
+                doc_sums_t *cell = touchSums(&sums[batch[b].query], posting->doc);
+                double mean = (batch[b].WFD + posting->WFD) / 2;
+                cell->shared += batch[b].WFD;
+                cell->docShared += posting->WFD;
+                cell->terms += batch[b].WFD * log2(batch[b].WFD / mean) + posting->WFD * log2(posting->WFD / mean);
+            }
+        }
+        t = end;
+    }
+
+    for(int q = 0; q < numQueries; q++){
+        index_match_t *top = &best[(size_t) q * k];
+        doc_accumulator_t *acc = &sums[q];
+        double queryMass = (queries[q]->length > 0) ? 1 : 0;
+        found[q] = 0;
+
+        for(unsigned i = 0; i < acc->capacity; i++){
+            doc_sums_t *cell = &acc->slots[i];
+            int d = cell->doc;
+            if(d < 0 || (skip != NULL && skip[d])) continue;
+            double divergence = 0.5 * (cell->terms + (queryMass - cell->shared) + (index->mass[d] - cell->docShared));
+            offerIndexMatch(top, &found[q], k, d, sqrt(divergence > 0 ? divergence : 0));
+        }
+
+        //empty documents are sqrt(0.5) from any non-empty query
+        for(int e = 0; e < index->numEmpty; e++){
+            int d = index->emptyDocs[e];
+            if(skip != NULL && skip[d]) continue;
+            offerIndexMatch(top, &found[q], k, d, sqrt(0.5 * queryMass));
+        }
+
+        //documents sharing no word with the query are only scanned to fill up the k
+        double outside = sqrt(0.5 * queryMass + 0.5);
+        for(int d = 0; d < index->numDocs && (found[q] < k || outside < top[k - 1].JSD); d++){
+            if(index->mass[d] == 0 || (skip != NULL && skip[d]) || findSums(acc, d) != NULL) continue;
+            offerIndexMatch(top, &found[q], k, d, outside);
+        }
+        destroy_accumulator(acc);
+    }
+
+    free(batch);
+    free(sums);
+}
+
+/**
+ * purpose: the k documents closest to one query vector, see query_index_batch.
+ * Returns the number of matches written to best.
+ */
+int query_index(inverted_index_t *index, DocVector *query, int k, const char *skip, index_match_t *best){
+    int found;
+    query_index_batch(index, &query, 1, k, skip, best, &found);
+    return found;
+}
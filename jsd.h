@@ -0,0 +1,123 @@
+#ifndef JSD_H
+#define JSD_H
+
+#include <stddef.h>
+
+/*
+ * Embeddable Jensen-Shannon distance engine.
+ *
+ * An engine keeps a thread pool, the interned vocabulary and a compact vector
+ * per document for as long as it lives, so a long running process pays for
+ * tokenizing a document once and reuses it across every query.
+ *
+ * Every function is safe to call from several threads at once. Adding
+ * documents takes a short exclusive lock; queries and all-pairs runs share
+ * the corpus.
+ *
+ *     jsd_engine *engine = jsd_engine_create(8);
+ *     jsd_engine_add_path(engine, "corpus/a.txt");
+ *     jsd_engine_add_buffer(engine, "inline", text, strlen(text));
+ *     jsd_match best[10];
+ *     int found = jsd_engine_query(engine, text, strlen(text), best, 10);
+ *     jsd_engine_destroy(engine);
+ *
+ * Paths may name gzip files, which are decompressed as they are read. Link
+ * with -lz -lm -pthread. libjsd.a exports only the functions of this header.
+ */
+
+#define JSD_API __attribute__((visibility("default")))
+
+typedef struct jsd_engine jsd_engine;
+
+//how an engine reads text; every engine has its own
+typedef struct {
+    const char *rules;  //tokenizer rules as compare's --rules: "default" (or NULL), "alnum" or "utf8"
+    int ngram;          //words per n-gram as compare's -n, 1 (or 0) for plain words
+} jsd_options;
+
+typedef struct {
+    int id;             //document ID, as returned when it was added
+    const char *name;   //owned by the engine
+    double jsd;
+} jsd_match;
+
+typedef struct {
+    int id1;
+    int id2;
+    const char *name1;
+    const char *name2;
+    int totalWords;     //distinct words of both documents, the sort key of compare
+    double jsd;
+} jsd_pair;
+
+//called once per pair, from pool threads but never two at a time
+typedef void (*jsd_pair_callback)(const jsd_pair *pair, void *ctx);
+
+/**
+ * purpose: create an engine with a pool of threads workers (at least one).
+ * Returns NULL on failure.
+ */
+JSD_API jsd_engine *jsd_engine_create(int threads);
+
+/**
+ * purpose: jsd_engine_create reading text with options instead of the
+ * default rules and plain words. An engine of n-grams answers no queries.
+ * Returns NULL on failure or unknown options.
+ */
+JSD_API jsd_engine *jsd_engine_create_with(int threads, const jsd_options *options);
+
+JSD_API void jsd_engine_destroy(jsd_engine *engine);
+
+/**
+ * purpose: tokenize a file and add it to the corpus.
+ * Returns the new document's ID, or -1 if the file could not be read.
+ */
+JSD_API int jsd_engine_add_path(jsd_engine *engine, const char *path);
+
+/**
+ * purpose: tokenize length bytes of text and add them to the corpus under name.
+ * Returns the new document's ID, or -1 on failure.
+ */
+JSD_API int jsd_engine_add_buffer(jsd_engine *engine, const char *name, const char *data, size_t length);
+
+/**
+ * purpose: remove a document from the corpus. Its ID is never reused, and
+ * queries, pairs and all-pairs runs no longer see it.
+ * Returns -1 if the ID is unknown or already removed.
+ */
+JSD_API int jsd_engine_remove(jsd_engine *engine, int id);
+
+//number of documents in the corpus, not counting removed ones
+JSD_API int jsd_engine_count(jsd_engine *engine);
+
+/**
+ * purpose: find the k documents closest to a text that is not in the corpus.
+ * Fills matches with up to k results, closest first (ties by lower ID), and
+ * returns how many were written, or -1 for an engine of n-grams. Queries go
+ * through an inverted index that is rebuilt on the first query after
+ * documents were added.
+ */
+JSD_API int jsd_engine_query(jsd_engine *engine, const char *data, size_t length, jsd_match *matches, int k);
+
+/**
+ * purpose: run numQueries queries together, sharing the reads of the index.
+ * The matches of query q go to matches[q * k ...] and their number to
+ * found[q]. Returns the total number of matches, or -1 for an engine of n-grams.
+ */
+JSD_API int jsd_engine_query_batch(jsd_engine *engine, const char **data, const size_t *lengths, int numQueries,
+                           jsd_match *matches, int k, int *found);
+
+/**
+ * purpose: JSD of two documents already in the corpus.
+ * Returns -1 if either ID is unknown.
+ */
+JSD_API double jsd_engine_pair(jsd_engine *engine, int id1, int id2);
+
+/**
+ * purpose: compute every pair of the corpus on the pool, in tiles, and hand
+ * each result to callback. Returns the number of pairs, which is the number
+ * of callbacks made: pairs of removed documents are not counted.
+ */
+JSD_API long jsd_engine_all_pairs(jsd_engine *engine, jsd_pair_callback callback, void *ctx);
+
+#endif
@@ -0,0 +1,245 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/types.h>
+
+#ifndef MEMFACTOR
+#define MEMFACTOR 8         //bytes the words of a file may take while it is read, per byte of the file
+#endif
+
+#ifndef SPILLSHARE
+#define SPILLSHARE 2        //resident vectors may fill 1/SPILLSHARE of the budget
+#endif
+
+//---------------------------------------------------------------------
+// Memory budget: admission control and spilling for the collection phase
+//---------------------------------------------------------------------
+
+/*
+ * --max-memory MB charges everything the collection phase keeps or is
+ * working on against one budget:
+ *
+ *     paths         every path while it is queued, and the file paths the
+ *                   documents keep afterwards
+ *     reading       an estimate for each file a file thread is reading:
+ *                   its buffers plus MEMFACTOR bytes per byte of the file
+ *                   for its word list, held until the vector is finished
+ *     documents     the handles and vector of every finished document
+ *     vocabulary    the interned words and tables, see vocabulary_t.bytes;
+ *                   before a list is interned the most its words can add
+ *                   is charged, and what they did not add is given back
+ *
+ * A file thread only starts a file once its estimate fits; until then it
+ * waits for other files to finish (a throttle). A file that does not fit
+ * even with no other file being read is read alone: the other file threads
+ * wait until it is finished, and only then is the budget exceeded. Vectors stay
+ * resident while they fill at most 1/SPILLSHARE of the budget; every later
+ * one is appended to an unlinked temporary file and freed, and is read back
+ * through a vector cache (vcache.c) during the analysis. Only the reading
+ * estimate is not measured, so a word list larger than MEMFACTOR bytes per
+ * byte of its file goes over.
+ */
+
+typedef struct {
+    uint64_t limit;
+    uint64_t held;              //everything charged right now
+    uint64_t peak;
+    uint64_t vectors;           //bytes of resident vectors
+    int reading;                //files admitted and not finished
+    int alone;                  //the one file being read does not fit the budget
+    int interning;              //files waiting to charge their words to the vocabulary
+    long throttled;             //files that had to wait
+    double waited;              //seconds they waited
+    long oversized;             //files read alone
+    long spilled;
+    uint64_t spilledBytes;
+    FILE *store;                //spilled vectors, created by the first spill
+    uint64_t storeEnd;
+    pthread_mutex_t lock;
+    pthread_cond_t released;
+} memory_budget_t;
+
+int init_memory_budget(memory_budget_t *budget, uint64_t limit){
+    memset(budget, 0, sizeof(*budget));
+    budget->limit = limit;
+    if(pthread_mutex_init(&budget->lock, NULL) || pthread_cond_init(&budget->released, NULL)){
+        perror("memory budget lock init error");
+        abort();
+    }
+    return 0;
+}
+
+void destroy_memory_budget(memory_budget_t *budget){
+    if(budget->store != NULL) fclose(budget->store);
+    pthread_mutex_destroy(&budget->lock);
+    pthread_cond_destroy(&budget->released);
+}
+
+//bytes a path takes in a queue and in its document
+uint64_t pathCost(const char *path){
+    return strlen(path) + 1 + MALLOC_OVERHEAD;
+}
+
+//bytes a finished document holds besides its vector
+uint64_t documentCost(void){
+    return sizeof(FileAndList) + sizeof(DocVector) + 2 * MALLOC_OVERHEAD + 2 * sizeof(FileAndList *);
+}
+
+uint64_t fileEstimate(off_t size){
+    return TOKENBUF + HASHBUF + 2 * MALLOC_OVERHEAD + (uint64_t) size * MEMFACTOR;
+}
+
+void chargeMemory(memory_budget_t *budget, uint64_t bytes){
+    if(budget == NULL) return;
+    pthread_mutex_lock(&budget->lock);
+    budget->held += bytes;
+    if(budget->held > budget->peak) budget->peak = budget->held;
+    pthread_mutex_unlock(&budget->lock);
+}
+
+void releaseMemory(memory_budget_t *budget, uint64_t bytes){
+    if(budget == NULL) return;
+    pthread_mutex_lock(&budget->lock);
+    budget->held -= bytes;
+    pthread_cond_broadcast(&budget->released);
+    pthread_mutex_unlock(&budget->lock);
+}
+
+/**
+ * purpose: reserve estimate bytes for a file about to be read, waiting
+ * while other files are being read and it does not fit, or while a file
+ * too large for the budget is read alone. A file that does not fit even
+ * with no other file being read is then admitted alone.
+ */
+void admitFile(memory_budget_t *budget, uint64_t estimate){
+    pthread_mutex_lock(&budget->lock);
+    if(budget->alone || (budget->held + estimate > budget->limit && budget->reading > 0)){
+        budget->throttled++;
+        double start = monotonicSeconds();
+        while(budget->alone || (budget->held + estimate > budget->limit && budget->reading > 0)){
+            pthread_cond_wait(&budget->released, &budget->lock);
+        }
+        budget->waited += monotonicSeconds() - start;
+    }
+    if(budget->held + estimate > budget->limit){
+        budget->alone = 1;
+        budget->oversized++;
+    }
+    budget->held += estimate;
+    budget->reading++;
+    if(budget->held > budget->peak) budget->peak = budget->held;
+    pthread_mutex_unlock(&budget->lock);
+}
+
+//a file that was admitted but is not kept
+void cancelFile(memory_budget_t *budget, uint64_t estimate){
+    pthread_mutex_lock(&budget->lock);
+    budget->held -= estimate;
+    if(--budget->reading == 0) budget->alone = 0;
+    pthread_cond_broadcast(&budget->released);
+    pthread_mutex_unlock(&budget->lock);
+}
+
+/**
+ * purpose: charge bytes a file being read is about to add, waiting while
+ * they do not fit and another file being read can still give memory back.
+ */
+static void reserveMemory(memory_budget_t *budget, uint64_t bytes){
+    pthread_mutex_lock(&budget->lock);
+    budget->interning++;
+    pthread_cond_broadcast(&budget->released);
+    while(budget->held + bytes > budget->limit && budget->reading > budget->interning){
+        pthread_cond_wait(&budget->released, &budget->lock);
+    }
+    budget->interning--;
+    budget->held += bytes;
+    if(budget->held > budget->peak) budget->peak = budget->held;
+    pthread_mutex_unlock(&budget->lock);
+}
+
+/**
+ * purpose: swap a read document's list for its compact vector. The most
+ * its words can add to the vocabulary is charged before they are interned,
+ * and what they did not add is given back afterwards.
+ */
+void internDocument(memory_budget_t *budget, FileAndList *fal, vocabulary_t *vocab){
+    if(fal->vec != NULL || fal->same != NULL) return;
+
+    size_t reserved = 0;
+    size_t bytes;
+    DocVector *vec;
+    while((vec = vectorFromListWithin(fal->list, vocab, reserved, &bytes)) == NULL){
+        reserveMemory(budget, bytes - reserved);
+        reserved = bytes;
+    }
+    destroy_list(&fal->list);
+    fal->vec = vec;
+
+    pthread_mutex_lock(&budget->lock);
+    budget->held -= reserved - bytes;
+    pthread_cond_broadcast(&budget->released);
+    pthread_mutex_unlock(&budget->lock);
+}
+
+/**
+ * purpose: trade a read file's estimate for what its document keeps,
+ * spilling the vector if the resident ones have their share of the budget.
+ * Returns -1 if the spill could not be written; the vector then stays.
+ */
+int finishFile(memory_budget_t *budget, FileAndList *fal, uint64_t estimate){
+    DocVector *vec = (fal->same == NULL) ? fal->vec : NULL;
+    int err = 0;
+
+    pthread_mutex_lock(&budget->lock);
+    int spill = vec != NULL && vec->bytes > 0
+                && budget->vectors + vec->bytes > budget->limit / SPILLSHARE;
+    uint64_t offset = budget->storeEnd;
+    if(spill && budget->store == NULL && (budget->store = tmpfile()) == NULL){
+        perror("ERROR: cannot create a file for spilled vectors");
+        spill = 0;
+        err = -1;
+    }
+    if(spill) budget->storeEnd += vec->bytes;
+    pthread_mutex_unlock(&budget->lock);
+
+    //the estimate still covers the vector while it is written
+    if(spill && pwrite(fileno(budget->store), vec->data, vec->bytes, offset) != (ssize_t) vec->bytes){
+        perror("ERROR: cannot spill a vector");
+        spill = 0;
+        err = -1;
+    }
+    if(spill){
+        free(vec->data);
+        vec->data = NULL;
+        vec->offset = offset;
+    }
+
+    pthread_mutex_lock(&budget->lock);
+    if(spill){
+        budget->spilled++;
+        budget->spilledBytes += vec->bytes;
+    } else if(vec != NULL){
+        budget->vectors += vec->bytes + MALLOC_OVERHEAD;
+        budget->held += vec->bytes + MALLOC_OVERHEAD;
+    }
+    budget->held += documentCost();
+    budget->held -= estimate;
+    if(budget->held > budget->peak) budget->peak = budget->held;
+    if(--budget->reading == 0) budget->alone = 0;
+    pthread_cond_broadcast(&budget->released);
+    pthread_mutex_unlock(&budget->lock);
+    return err;
+}
+
+void reportMemoryBudget(memory_budget_t *budget){
+    double mb = 1024.0 * 1024.0;
+    fprintf(stderr, "memory: peak %.2f MB of a %.2f MB budget, %ld files throttled (%.2f s waiting), %ld read alone\n",
+            budget->peak / mb, budget->limit / mb, budget->throttled, budget->waited, budget->oversized);
+    if(budget->spilled > 0){
+        fprintf(stderr, "memory: %ld vectors spilled to disk (%.2f MB)\n", budget->spilled, budget->spilledBytes / mb);
+    }
+}
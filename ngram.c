@@ -0,0 +1,406 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifndef NGRAM_MAX
+#define NGRAM_MAX 8
+#endif
+#define NGRAM_BASE 0x9E3779B97F4A7C15ULL    //odd, and 5 mod 8
+
+//---------------------------------------------------------------------
+// Word n-grams: distributions of runs of words, counted by hash
+//---------------------------------------------------------------------
+
+/*
+ * With -n<k> a document is the distribution of its runs of k consecutive
+ * words instead of its words. No n-gram is ever spelled out: each word is
+ * reduced to hashWord(word), the 64-bit FNV-1a the vocabulary and the word
+ * tables use, and the last k of those are combined by a polynomial rolling
+ * hash mod 2^64 (one multiply and add per word, one more to drop the word
+ * leaving the window). A bijective finalizer turns that into the n-gram's
+ * ID. ngramtable_t counts IDs in 16 byte slots with no strings, and the
+ * counts become an ordinary DocVector keyed by ID, so pruning, --metrics,
+ * shards, dedup and snapshots work on it unchanged.
+ *
+ * Collisions: two different n-grams are counted as one n-gram exactly when
+ * their IDs are equal, either because two of their words have the same FNV
+ * hash or because the rolling hash of two different runs is the same. With
+ * m distinct n-grams in the whole corpus the chance that any two collide is
+ * about m^2 / 2^65 (1 in 3600 for 10^8 of them). A collision only merges
+ * the counts of the two n-grams, which moves the JSD of a pair holding one
+ * of them on each side towards 0 by at most their WFD; pairs where neither
+ * document holds either are unchanged. Runs that differ only in the order of
+ * two words collide only if the two word hashes agree in their low 60 bits:
+ * NGRAM_BASE is 5 mod 8, so NGRAM_BASE^d - 1 has at most four factors of two
+ * for the distances d < NGRAM_MAX.
+ *
+ * A file with fewer than k words has no n-grams and is compared as an empty
+ * file. N-grams run across every separator, line breaks included.
+ *
+ * Files over CHUNKBYTES are cut into the ranges of chunk.c, counted on the
+ * chunk pool. Each range counts the n-grams lying wholly in it, adds them to
+ * its thread's table and keeps only its first and last k - 1 word hashes;
+ * the n-grams across the boundaries are counted from those once every range
+ * is done, in file order.
+ */
+
+//an n-gram's ID from its rolling hash (the splitmix64 finalizer, a bijection)
+static inline uint64_t ngramID(uint64_t hash){
+    hash ^= hash >> 30;
+    hash *= 0xbf58476d1ce4e5b9ULL;
+    hash ^= hash >> 27;
+    hash *= 0x94d049bb133111ebULL;
+    hash ^= hash >> 31;
+    return hash;
+}
+
+typedef struct {
+    uint64_t id;
+    uint64_t count;     //0 marks an empty slot
+} ngramEntry;
+
+typedef struct {
+    ngramEntry *entries;
+    size_t used;
+    size_t capacity;    //always a power of two
+} ngramtable_t;
+
+int init_ngramtable(ngramtable_t *table){
+    table->used = 0;
+    table->capacity = 1024;
+    table->entries = calloc(table->capacity, sizeof(ngramEntry));
+    return (table->entries == NULL);
+}
+
+void destroy_ngramtable(ngramtable_t *table){
+    free(table->entries);
+}
+
+/**
+ * purpose: add count occurrences of the n-gram id.
+ */
+void ngramtable_add(ngramtable_t *table, uint64_t id, uint64_t count){
+    if(2 * (table->used + 1) > table->capacity){
+        size_t capacity = 2 * table->capacity;
+        ngramEntry *entries = calloc(capacity, sizeof(ngramEntry));
+        if(entries == NULL){
+            perror("n-gram table resize failed");
+            abort();
+        }
+        for(size_t i = 0; i < table->capacity; i++){
+            if(table->entries[i].count == 0) continue;
+            size_t slot = table->entries[i].id & (capacity - 1);
+            while(entries[slot].count != 0) slot = (slot + 1) & (capacity - 1);
+            entries[slot] = table->entries[i];
+        }
+        free(table->entries);
+        table->entries = entries;
+        table->capacity = capacity;
+    }
+
+    size_t mask = table->capacity - 1;
+    size_t slot = id & mask;
+    while(table->entries[slot].count != 0){
+        if(table->entries[slot].id == id){
+            table->entries[slot].count += count;
+            return;
+        }
+        slot = (slot + 1) & mask;
+    }
+    table->entries[slot].id = id;
+    table->entries[slot].count = count;
+    table->used++;
+}
+
+//---------------------------------------------------------------------
+// Counting the n-grams of a word stream
+//---------------------------------------------------------------------
+
+typedef struct {
+    ngramtable_t table;
+    uint64_t total;                 //n-grams counted
+    int n;
+    int rules;                      //the tokenizer rules the words are read with
+    uint64_t power;                 //NGRAM_BASE^(n-1), to take the oldest word out of the hash
+    uint64_t hash;                  //rolling hash of the last n words
+    uint64_t window[NGRAM_MAX];     //their word hashes, word w in slot w % n
+    uint64_t first[NGRAM_MAX];      //the first n - 1 word hashes
+    long words;
+} ngram_counter_t;
+
+int init_ngram_counter(ngram_counter_t *counter, int n, int rules){
+    counter->total = 0;
+    counter->n = n;
+    counter->rules = rules;
+    counter->power = 1;
+    for(int i = 1; i < n; i++){
+        counter->power *= NGRAM_BASE;
+    }
+    counter->hash = 0;
+    counter->words = 0;
+    return init_ngramtable(&counter->table);
+}
+
+void destroy_ngram_counter(ngram_counter_t *counter){
+    destroy_ngramtable(&counter->table);
+}
+
+//start a new word stream, keeping what was counted
+void restartNgrams(ngram_counter_t *counter){
+    counter->hash = 0;
+    counter->words = 0;
+}
+
+void pushWordHash(ngram_counter_t *counter, uint64_t word){
+    int slot = counter->words % counter->n;
+    if(counter->words >= counter->n){
+        counter->hash -= counter->window[slot] * counter->power;
+    }
+    counter->hash = counter->hash * NGRAM_BASE + word;
+    counter->window[slot] = word;
+    if(counter->words < counter->n - 1){
+        counter->first[counter->words] = word;
+    }
+    counter->words++;
+
+    if(counter->words >= counter->n){
+        ngramtable_add(&counter->table, ngramID(counter->hash), 1);
+        counter->total++;
+    }
+}
+
+//a tokenizer's emit: count the n-gram the word completes
+void countNgram(void *ctx, char *word){
+    pushWordHash(ctx, hashWord(word));
+}
+
+/**
+ * purpose: copy the last (up to n - 1) word hashes of a counter's stream
+ * into out, oldest first. Returns how many.
+ */
+int lastWordHashes(ngram_counter_t *counter, uint64_t *out){
+    long from = (counter->words > counter->n - 1) ? counter->words - (counter->n - 1) : 0;
+    int count = 0;
+    for(long w = from; w < counter->words; w++){
+        out[count++] = counter->window[w % counter->n];
+    }
+    return count;
+}
+
+//---------------------------------------------------------------------
+// Reading a file's n-grams
+//---------------------------------------------------------------------
+
+typedef struct {
+    chunked_file_t *file;
+    ngram_counter_t *counters;      //one per range, for the words around its boundaries
+    ngramtable_t *tables;           //one per slot, where the ranges' n-grams are added up
+} ngramChunks;
+
+void countNgramChunk(chunk_job_t *job, int slot, int chunk){
+    ngramChunks *chunks = job->ctx;
+    ngram_counter_t *range = &chunks->counters[chunk];
+    off_t start, end;
+    chunkBounds(chunks->file, chunk, &start, &end);
+    tokenizeRange(chunks->file->fd, start, end, chunks->file->size, range->rules, countNgram, range);
+
+    //only the range's first and last words are kept past this point
+    ngramtable_t *into = &chunks->tables[slot];
+    if(into->entries == NULL) init_ngramtable(into);
+    for(size_t i = 0; i < range->table.capacity; i++){
+        if(range->table.entries[i].count == 0) continue;
+        ngramtable_add(into, range->table.entries[i].id, range->table.entries[i].count);
+    }
+    destroy_ngramtable(&range->table);
+    range->table.entries = NULL;
+}
+
+/**
+ * purpose: count the n-grams of a regular file into counter, its ranges on
+ * up to threads threads (the calling thread and chunk pool workers).
+ */
+void countNgramsChunked(ngram_counter_t *counter, int fd, off_t size, int threads){
+    chunked_file_t file;
+    file.fd = fd;
+    file.size = size;
+    file.rules = counter->rules;
+    file.numChunks = (size > 0) ? (int) ((size + CHUNKBYTES - 1) / CHUNKBYTES) : 1;
+    if(threads > file.numChunks) threads = file.numChunks;
+    if(threads < 1) threads = 1;
+
+    ngram_counter_t *counters = malloc(sizeof(ngram_counter_t) * file.numChunks);
+    for(int c = 0; c < file.numChunks; c++){
+        init_ngram_counter(&counters[c], counter->n, counter->rules);
+    }
+    ngramChunks chunks = { &file, counters, calloc(threads, sizeof(ngramtable_t)) };
+    chunk_job_t job;
+    job.numChunks = file.numChunks;
+    job.run = countNgramChunk;
+    job.ctx = &chunks;
+    runChunkJob(&job, threads);
+
+    //the n-grams across a boundary: the last n - 1 words before it, then the first ones after it
+    uint64_t carry[2 * NGRAM_MAX];
+    int carried = 0;
+    for(int c = 0; c < file.numChunks; c++){
+        ngram_counter_t *range = &counters[c];
+        if(c > 0){
+            restartNgrams(counter);
+            for(int i = 0; i < carried; i++){
+                pushWordHash(counter, carry[i]);
+            }
+            int firstWords = (range->words < range->n - 1) ? (int) range->words : range->n - 1;
+            for(int i = 0; i < firstWords; i++){
+                pushWordHash(counter, range->first[i]);
+            }
+            if(range->words < range->n - 1){
+                //a range this short leaves some of the words before it for the next boundary
+                carried = lastWordHashes(counter, carry);
+            }
+        }
+        if(c == 0 || range->words >= range->n - 1){
+            carried = lastWordHashes(range, carry);
+        }
+        counter->total += range->total;
+    }
+
+    for(int i = 0; i < threads; i++){
+        if(chunks.tables[i].entries == NULL) continue;
+        for(size_t e = 0; e < chunks.tables[i].capacity; e++){
+            if(chunks.tables[i].entries[e].count == 0) continue;
+            ngramtable_add(&counter->table, chunks.tables[i].entries[e].id, chunks.tables[i].entries[e].count);
+        }
+        destroy_ngramtable(&chunks.tables[i]);
+    }
+
+    free(chunks.tables);
+    free(counters);
+}
+
+/**
+ * purpose: count the n-grams of a file that cannot be read by range.
+ */
+void countNgramsStream(ngram_counter_t *counter, int fd){
+    unsigned char *buf = malloc(TOKENBUF);
+    tokenizer_t tok;
+    init_tokenizer(&tok, counter->rules, countNgram, counter);
+    size_t have = 0;
+    int atEnd = 0;
+
+    while(!atEnd || have > 0){
+        if(!atEnd){
+            ssize_t bytes_read = read(fd, buf + have, TOKENBUF - have);
+            if(bytes_read <= 0){
+                atEnd = 1;
+            } else {
+                have += bytes_read;
+            }
+        }
+        size_t used = tokenize(&tok, buf, have, atEnd);
+        memmove(buf, buf + used, have - used);
+        have -= used;
+    }
+    tokenEndWord(&tok);
+
+    destroy_tokenizer(&tok);
+    free(buf);
+}
+
+/**
+ * purpose: summarizeList for the (id, count) entries of a document.
+ */
+void summarizeEntries(vectorEntry *entries, int length, uint64_t total, DocSummary *summary){
+    double top[TOPK];
+    int kept = 0;
+
+    summary->vocabSize = length;
+    summary->mass = (length == 0) ? 0 : 1;
+
+    for(int i = 0; i < length; i++){
+        double wfd = (double) entries[i].frequency / total;
+        int pos = (kept < TOPK) ? kept++ : TOPK;
+        while(pos > 0 && top[pos - 1] < wfd){
+            if(pos < TOPK) top[pos] = top[pos - 1];
+            pos--;
+        }
+        if(pos < TOPK) top[pos] = wfd;
+    }
+
+    double running = 0;
+    for(int k = 0; k < TOPK; k++){
+        running = (k < kept) ? running + top[k] : summary->mass;
+        summary->topMass[k] = running;
+    }
+}
+
+/**
+ * purpose: store what counter counted in a document as a compact vector and
+ * summarize it; a document that failed to read (err set) is finished empty.
+ */
+void finishNgramDocument(FileAndList *fal, ngram_counter_t *counter, int err){
+    int length = 0;
+    vectorEntry *entries = malloc(sizeof(vectorEntry) * (counter->table.used + 1));
+    for(size_t i = 0; i < counter->table.capacity && !err; i++){
+        if(counter->table.entries[i].count == 0) continue;
+        entries[length].id = counter->table.entries[i].id;
+        entries[length].frequency = counter->table.entries[i].count;
+        length++;
+    }
+    summarizeEntries(entries, length, counter->total, &fal->summary);
+    fal->vec = vectorFromEntries(entries, length);
+    fal->list = NULL;
+    fal->same = NULL;
+    free(entries);
+}
+
+/**
+ * purpose: readDocument under -n: count the n-grams of an open file straight
+ * into a compact vector and summarize it. Returns -1 with errno set if the
+ * file cannot be decoded; the document is then finished empty.
+ */
+int readNgramDocument(FileAndList *fal, int file, int chunkThreads, int rules, int n){
+    ngram_counter_t counter;
+    init_ngram_counter(&counter, n, rules);
+    int err = 0;
+
+    struct stat fileData;
+    int compression = compressionOf(file);
+    if (compression == COMPRESSION_GZIP){
+        err = tokenizeGzip(file, rules, countNgram, &counter);
+    } else if (fstat(file, &fileData) == 0 && S_ISREG(fileData.st_mode)){
+        countNgramsChunked(&counter, file, fileData.st_size, chunkThreads);
+    } else {
+        countNgramsStream(&counter, file);
+    }
+    int saved = errno;
+
+    //a document is all of its file or nothing
+    finishNgramDocument(fal, &counter, err);
+
+    destroy_ngram_counter(&counter);
+    errno = saved;
+    return err;
+}
+
+/**
+ * purpose: readNgramDocument for text already in memory.
+ */
+void ngramDocumentFromBuffer(FileAndList *fal, const char *data, size_t length, int rules, int n){
+    ngram_counter_t counter;
+    tokenizer_t tok;
+    init_ngram_counter(&counter, n, rules);
+    init_tokenizer(&tok, rules, countNgram, &counter);
+
+    tokenize(&tok, (const unsigned char *) data, length, 1);
+    tokenEndWord(&tok);
+    finishNgramDocument(fal, &counter, 0);
+
+    destroy_tokenizer(&tok);
+    destroy_ngram_counter(&counter);
+}
@@ -0,0 +1,294 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <pthread.h>
+#include <sched.h>
+
+#ifndef NUMA_SYSFS
+#define NUMA_SYSFS "/sys/devices/system/node"
+#endif
+
+//---------------------------------------------------------------------
+// NUMA placement: documents and analysis threads on the same node
+//---------------------------------------------------------------------
+
+/*
+ * With --numa the sorted documents are cut into one contiguous range per
+ * node. A thread pinned to each node copies the words of its range into
+ * memory it touches first, which the kernel places on that node. The tiles
+ * are split the same way: a tile whose rows and columns are on one node goes
+ * to that node, and the blocks between two nodes alternate between them.
+ * Analysis threads are spread over the nodes and pinned there; a thread
+ * works through its own node's tiles and then takes tiles from the node with
+ * the most left, so no node idles while another has work.
+ *
+ * The nodes and their CPUs come from sysfs. A machine without it, or with a
+ * single node that has CPUs, runs exactly as without --numa.
+ */
+
+typedef struct {
+    int numNodes;
+    int *ids;               //sysfs node number of each node
+    cpu_set_t *cpus;        //the CPUs of each node we are allowed to run on
+} numa_topology_t;
+
+typedef struct {
+    pair_tile_t *tiles;
+    int count;
+    int next;
+} numa_tiles_t;
+
+typedef struct {
+    numa_tiles_t *nodes;
+    int numNodes;
+    pthread_mutex_t lock;
+} numa_schedule_t;
+
+/**
+ * purpose: parse a sysfs list such as "0-3,8-11". Calls add(ctx, n) for
+ * every number. Returns -1 if the text is not a list.
+ */
+int parseNumaList(const char *text, void (*add)(void *ctx, int n), void *ctx){
+    const char *p = text;
+    while(*p != '\0' && *p != '\n'){
+        if(!isdigit((unsigned char) *p)) return -1;
+        int first = (int) strtol(p, (char **) &p, 10);
+        int last = first;
+        if(*p == '-'){
+            p++;
+            if(!isdigit((unsigned char) *p)) return -1;
+            last = (int) strtol(p, (char **) &p, 10);
+        }
+        for(int n = first; n <= last; n++) add(ctx, n);
+        if(*p == ',') p++;
+    }
+    return 0;
+}
+
+int readNumaFile(const char *path, char *buf, size_t size){
+    FILE *in = fopen(path, "r");
+    if(in == NULL) return -1;
+    size_t n = fread(buf, 1, size - 1, in);
+    fclose(in);
+    buf[n] = '\0';
+    return 0;
+}
+
+void addNumaCpu(void *ctx, int cpu){
+    if(cpu < CPU_SETSIZE) CPU_SET(cpu, (cpu_set_t *) ctx);
+}
+
+typedef struct {
+    int *ids;
+    int count;
+} numa_ids_t;
+
+void addNumaNode(void *ctx, int node){
+    numa_ids_t *nodes = ctx;
+    nodes->ids = realloc(nodes->ids, sizeof(int) * (nodes->count + 1));
+    nodes->ids[nodes->count++] = node;
+}
+
+/**
+ * purpose: find the nodes that have CPUs this process may use.
+ * Falls back to a single node holding every allowed CPU.
+ */
+void detectNuma(numa_topology_t *topo){
+    cpu_set_t allowed;
+    if(sched_getaffinity(0, sizeof(allowed), &allowed)){
+        CPU_ZERO(&allowed);
+        for(int cpu = 0; cpu < CPU_SETSIZE; cpu++) CPU_SET(cpu, &allowed);
+    }
+
+    topo->numNodes = 0;
+    topo->ids = NULL;
+    topo->cpus = NULL;
+
+    char buf[4096];
+    numa_ids_t online = { NULL, 0 };
+    if(readNumaFile(NUMA_SYSFS "/online", buf, sizeof(buf)) == 0){
+        parseNumaList(buf, addNumaNode, &online);
+    }
+
+    for(int i = 0; i < online.count; i++){
+        char path[256];
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        snprintf(path, sizeof(path), NUMA_SYSFS "/node%d/cpulist", online.ids[i]);
+        if(readNumaFile(path, buf, sizeof(buf)) || parseNumaList(buf, addNumaCpu, &cpus)) continue;
+
+        //memory only nodes and nodes we may not run on get no threads
+        CPU_AND(&cpus, &cpus, &allowed);
+        if(CPU_COUNT(&cpus) == 0) continue;
+
+        topo->ids = realloc(topo->ids, sizeof(int) * (topo->numNodes + 1));
+        topo->cpus = realloc(topo->cpus, sizeof(cpu_set_t) * (topo->numNodes + 1));
+        topo->ids[topo->numNodes] = online.ids[i];
+        topo->cpus[topo->numNodes] = cpus;
+        topo->numNodes++;
+    }
+    free(online.ids);
+
+    if(topo->numNodes == 0){
+        topo->ids = malloc(sizeof(int));
+        topo->cpus = malloc(sizeof(cpu_set_t));
+        topo->ids[0] = 0;
+        topo->cpus[0] = allowed;
+        topo->numNodes = 1;
+    }
+}
+
+void destroy_numa(numa_topology_t *topo){
+    free(topo->ids);
+    free(topo->cpus);
+}
+
+void pinToNode(numa_topology_t *topo, int node){
+    if(pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &topo->cpus[node])){
+        fprintf(stderr, "WARNING: could not pin a thread to NUMA node %d\n", topo->ids[node]);
+    }
+}
+
+//the node holding document doc when numDocs are cut into numNodes ranges
+int numaHome(int doc, int numDocs, int numNodes){
+    return (int) ((long) doc * numNodes / numDocs);
+}
+
+/**
+ * purpose: split the tiles between the nodes by where their documents live.
+ */
+void init_numa_schedule(numa_schedule_t *schedule, pair_tile_t *tiles, int numTiles, int numDocs, int numNodes){
+    schedule->numNodes = numNodes;
+    schedule->nodes = calloc(numNodes, sizeof(numa_tiles_t));
+    int *home = malloc(sizeof(int) * (numTiles + 1));
+    for(int t = 0; t < numTiles; t++){
+        int a = numaHome(tiles[t].rowStart, numDocs, numNodes);
+        int b = numaHome(tiles[t].colStart, numDocs, numNodes);
+        home[t] = (a == b || (a + b) % 2) ? a : b;
+        schedule->nodes[home[t]].count++;
+    }
+    for(int n = 0; n < numNodes; n++){
+        schedule->nodes[n].tiles = malloc(sizeof(pair_tile_t) * (schedule->nodes[n].count + 1));
+        schedule->nodes[n].count = 0;
+        schedule->nodes[n].next = 0;
+    }
+    for(int t = 0; t < numTiles; t++){
+        numa_tiles_t *node = &schedule->nodes[home[t]];
+        node->tiles[node->count++] = tiles[t];
+    }
+    free(home);
+    pthread_mutex_init(&schedule->lock, NULL);
+}
+
+void destroy_numa_schedule(numa_schedule_t *schedule){
+    for(int n = 0; n < schedule->numNodes; n++){
+        free(schedule->nodes[n].tiles);
+    }
+    free(schedule->nodes);
+    pthread_mutex_destroy(&schedule->lock);
+}
+
+/**
+ * purpose: the next tile for a thread of node home: its own node's while
+ * there are any, then the last tile of the node with the most left.
+ * Returns -1 once every tile is taken.
+ */
+int nextNumaTile(numa_schedule_t *schedule, int home, pair_tile_t *tile){
+    pthread_mutex_lock(&schedule->lock);
+    numa_tiles_t *own = &schedule->nodes[home];
+    if(own->next < own->count){
+        *tile = own->tiles[own->next++];
+        pthread_mutex_unlock(&schedule->lock);
+        return 0;
+    }
+
+    numa_tiles_t *victim = NULL;
+    for(int n = 0; n < schedule->numNodes; n++){
+        numa_tiles_t *other = &schedule->nodes[n];
+        if(other->count - other->next > 0 && (victim == NULL || other->count - other->next > victim->count - victim->next)){
+            victim = other;
+        }
+    }
+    if(victim == NULL){
+        pthread_mutex_unlock(&schedule->lock);
+        return -1;
+    }
+    *tile = victim->tiles[--victim->count];
+    pthread_mutex_unlock(&schedule->lock);
+    return 0;
+}
+
+typedef struct {
+    numa_topology_t *topo;
+    FileAndList **docs;
+    int numDocs;
+    int node;
+} numaPlaceArgs;
+
+/**
+ * purpose: copy a list node by node, so the copy is allocated by the caller.
+ */
+List *copyList(List *list){
+    List *head = NULL;
+    List **tail = &head;
+    for(; list != NULL; list = list->next){
+        List *node = malloc(sizeof(List));
+        node->word = malloc(strlen(list->word) + 1);
+        strcpy(node->word, list->word);
+        node->frequency = list->frequency;
+        node->WFD = list->WFD;
+        node->next = NULL;
+        *tail = node;
+        tail = &node->next;
+    }
+    return head;
+}
+
+void* numaPlaceThreadTask(void* arg){
+    numaPlaceArgs *args = arg;
+    pinToNode(args->topo, args->node);
+
+    for(int d = 0; d < args->numDocs; d++){
+        if(numaHome(d, args->numDocs, args->topo->numNodes) != args->node) continue;
+
+        //a copy of another file moves the words it borrows (see shareDuplicates)
+        FileAndList *fal = args->docs[d]->same ? args->docs[d]->same : args->docs[d];
+
+        //first touch from this node places the new copy here
+        if(fal->vec != NULL){
+            unsigned char *data = malloc(fal->vec->bytes + 1);
+            memcpy(data, fal->vec->data, fal->vec->bytes);
+            free(fal->vec->data);
+            fal->vec->data = data;
+        } else if(fal->list != NULL){
+            List *list = copyList(fal->list);
+            destroy_list(&fal->list);
+            fal->list = list;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * purpose: move the words of every document to the node of its range, one
+ * pinned thread per node. docs must own their words (not a mapped snapshot)
+ * and hold each content once; call shareDuplicates afterwards.
+ */
+void placeDocuments(numa_topology_t *topo, FileAndList **docs, int numDocs){
+    pthread_t *tids = malloc(sizeof(pthread_t) * topo->numNodes);
+    numaPlaceArgs *args = malloc(sizeof(numaPlaceArgs) * topo->numNodes);
+    for(int n = 0; n < topo->numNodes; n++){
+        args[n].topo = topo;
+        args[n].docs = docs;
+        args[n].numDocs = numDocs;
+        args[n].node = n;
+        pthread_create(&tids[n], NULL, numaPlaceThreadTask, &args[n]);
+    }
+    for(int n = 0; n < topo->numNodes; n++){
+        pthread_join(tids[n], NULL);
+    }
+    free(tids);
+    free(args);
+}
@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <ctype.h>
@@ -15,23 +16,63 @@
 #define AQSIZE 20
 #endif
 #define SIZE 8
+#ifndef TOPK
+#define TOPK 8
+#endif
+#ifndef TILESIZE
+#define TILESIZE 32
+#endif
+#include "token.c"
 
 typedef struct List{
 	char* word;
 	struct List *next;
-	int frequency;
+	uint64_t frequency;
 	double WFD;
 }List;
 
+//cheap per-document summary used to lower bound the JSD of a pair
+typedef struct {
+    int vocabSize;
+    double mass;            //1 for a non-empty document, 0 otherwise
+    double topMass[TOPK];   //topMass[k] = combined WFD of the k+1 most frequent words
+} DocSummary;
+
+//what a pair can be measured by, see --metrics; the JSD is always computed
+enum { METRIC_JSD = 1, METRIC_COSINE = 2, METRIC_HELLINGER = 4, METRIC_JACCARD = 8, METRIC_SHARED = 16 };
+#define METRIC_ALL 31
+
 typedef struct {
+    double JSD;
+    double cosine;          //of the two WFD vectors
+    double hellinger;
+    int shared;             //words in both documents, which with totalWords gives the Jaccard index
+    int totalWords;         //distinct words of the two documents added up
+} pair_metrics_t;
+
+//compact form of a list, see vector.c
+struct DocVector;
+void destroy_vector(struct DocVector *vec);
+
+typedef struct FileAndList {
     char *filepath;
     List *list;
+    struct DocVector *vec;  //replaces list when compact vectors are enabled
+    DocSummary summary;
+    struct FileAndList *same;   //a byte-identical document whose list and vector this one borrows
 } FileAndList;
 
+//a mapped corpus snapshot, see snapshot.c
+struct snapshot_t;
+void close_snapshot(struct snapshot_t *snap);
+
 typedef struct {
     FileAndList **fal;
     int size;
     int nextIndex;
+    struct snapshot_t *snapshot;    //set when the documents live in a mapped snapshot
+    int mappedDocs;                 //fal[0..mappedDocs) belong to the snapshot
+    int storeFd;                    //the file vectors that are not resident are read from, or -1
     pthread_mutex_t arrayLock;
 } repository;
 
@@ -76,7 +117,7 @@ int destroy_list(List **node){
 void printList(List *list){
     List *temp = list;
     while (temp != NULL){
-        printf("%s: %d %f\n", temp->word, temp->frequency, temp->WFD);
+        printf("%s: %llu %f\n", temp->word, (unsigned long long) temp->frequency, temp->WFD);
         temp = temp->next;
     }
 }
@@ -140,7 +181,7 @@ void insert(List **head_ref, char * new_word){
 
 }
 
-void computeWFD(List *list, int word_count){
+void computeWFD(List *list, uint64_t word_count){
     List *temp = list;
     while (temp != NULL){
         temp->WFD = (double) temp->frequency / word_count;
@@ -171,7 +212,7 @@ void bubbleSort(List *sortlist){
             for (ptr = temp->next; ptr != NULL; ptr = ptr->next){
                 if (strcmp(temp->word, ptr->word) > 0){
                     char *temp_word = temp->word;
-                    int temp_frequency = temp->frequency;
+                    uint64_t temp_frequency = temp->frequency;
                     double temp_WFD = temp->WFD;
                     temp->word = ptr->word;
                     temp->frequency = ptr->frequency;
@@ -190,6 +231,128 @@ void bubbleSort(List *sortlist){
 
 }
 
+/**
+ * purpose: sort a list by word using a merge sort, returning the new head.
+ * calculateJSD walks both lists in lexicographic order so every list has to
+ * go through here before analysis.
+ */
+List *sortList(List *list){
+    if(list == NULL || list->next == NULL){
+        return list;
+    }
+
+    //split the list in half
+    List *slow = list;
+    List *fast = list->next;
+    while(fast != NULL && fast->next != NULL){
+        slow = slow->next;
+        fast = fast->next->next;
+    }
+    List *second = slow->next;
+    slow->next = NULL;
+
+    List *left = sortList(list);
+    List *right = sortList(second);
+
+    //merge the two halves back together
+    List head;
+    List *tail = &head;
+    while(left != NULL && right != NULL){
+        if(strcmp(left->word, right->word) <= 0){
+            tail->next = left;
+            left = left->next;
+        } else {
+            tail->next = right;
+            right = right->next;
+        }
+        tail = tail->next;
+    }
+    tail->next = (left != NULL) ? left : right;
+
+    return head.next;
+}
+
+//---------------------------------------------------------------------
+// Pair pruning: summaries and lower bounds
+//---------------------------------------------------------------------
+
+/**
+ * purpose: fill in the summary of a list whose WFD has been computed.
+ */
+void summarizeList(List *list, DocSummary *summary){
+    double top[TOPK];
+    int kept = 0;
+
+    summary->vocabSize = 0;
+    summary->mass = (list == NULL) ? 0 : 1;
+
+    //keep the TOPK largest WFD values in descending order
+    for(List *temp = list; temp != NULL; temp = temp->next){
+        summary->vocabSize++;
+        int pos = (kept < TOPK) ? kept++ : TOPK;
+        while(pos > 0 && top[pos - 1] < temp->WFD){
+            if(pos < TOPK) top[pos] = top[pos - 1];
+            pos--;
+        }
+        if(pos < TOPK) top[pos] = temp->WFD;
+    }
+
+    double running = 0;
+    for(int k = 0; k < TOPK; k++){
+        if(k < kept){
+            running += top[k];
+        } else {
+            //fewer than TOPK words: the remaining prefixes hold all of the mass
+            running = summary->mass;
+        }
+        summary->topMass[k] = running;
+    }
+}
+
+/**
+ * purpose: upper bound on the mass any k words can hold in a document.
+ * Past TOPK every extra word holds at most as much as the TOPK-th largest.
+ */
+double topMassBound(DocSummary *s, int k){
+    if(k <= 0) return 0;
+    if(k >= s->vocabSize) return s->mass;
+    if(k <= TOPK) return s->topMass[k - 1];
+
+    double kth = (TOPK > 1) ? s->topMass[TOPK - 1] - s->topMass[TOPK - 2] : s->topMass[0];
+    double bound = s->topMass[TOPK - 1] + (k - TOPK) * kth;
+    return (bound < s->mass) ? bound : s->mass;
+}
+
+/**
+ * purpose: a provable lower bound on the (squared) JS divergence of a pair,
+ * using only the two document summaries.
+ *
+ * Two bounds are combined:
+ *  - words outside the shared support contribute WFD/2 each, and the shared
+ *    support holds at most the other document's vocabulary size worth of words.
+ *  - Pinsker: JS >= L^2 / (8 ln 2) where L is the L1 distance, and
+ *    L >= 2 |topMass_a(k) - topMass_b(k)| for every k.
+ */
+double jsdLowerBound(DocSummary *a, DocSummary *b){
+    double outside = 0.5 * (a->mass - topMassBound(a, b->vocabSize))
+                   + 0.5 * (b->mass - topMassBound(b, a->vocabSize));
+
+    //calculateJSD treats an empty document as sqrt(0.5) away from everything,
+    //which the outside mass bound already matches exactly
+    if(a->mass == 0 || b->mass == 0){
+        return outside;
+    }
+
+    double l1 = 0;
+    for(int k = 0; k < TOPK; k++){
+        double diff = 2 * fabs(a->topMass[k] - b->topMass[k]);
+        if(diff > l1) l1 = diff;
+    }
+    double pinsker = (l1 * l1) / (8 * log(2));
+
+    return (outside > pinsker) ? outside : pinsker;
+}
+
 //---------------------------------------------------------------------
 // WFD repository basic use functions
 //---------------------------------------------------------------------
@@ -216,6 +379,9 @@ int init_repository(repository * repos, int startSize){
     } 
     repos->size = startSize;
     repos->nextIndex = 0;
+    repos->snapshot = NULL;
+    repos->mappedDocs = 0;
+    repos->storeFd = -1;
     if(pthread_mutex_init(&repos->arrayLock, NULL)){
         perror("lock init failed");
         return 1;
@@ -225,11 +391,17 @@ int init_repository(repository * repos, int startSize){
 }
 
 int destroy_repository(repository * repos){
-    
-    for(int i = 0; i < repos->nextIndex; i++){
-        destroy_list(&repos->fal[i]->list);
-        free(&repos->fal[i]->filepath);
+
+    //a snapshot owns its documents, paths and vectors; later appends are ours
+    for(int i = repos->mappedDocs; i < repos->nextIndex; i++){
+        if(repos->fal[i]->same == NULL){
+            destroy_list(&repos->fal[i]->list);
+            destroy_vector(repos->fal[i]->vec);
+        }
+        free(repos->fal[i]->filepath);
+        free(repos->fal[i]);
     }
+    close_snapshot(repos->snapshot);
     
     free(repos->fal); 
     pthread_mutex_destroy(&repos->arrayLock);
@@ -267,69 +439,54 @@ int append_repository(repository * repos, FileAndList *fal){
 // Linked list application functions
 //---------------------------------------------------------------------
 
-void fillList(List **listOne, int fd){
-
-    char * buf = malloc(SIZE);
-    strbuf_t sb;
-    strbuf_init(&sb, SIZE);
-    int word_count = 0;
-
-    //read from file
-    int bytes_read = read(fd, buf, SIZE);
-    while (bytes_read > 0){
+typedef struct {
+    List **list;
+    uint64_t word_count;
+} listWords;
+
+void insertWord(void *ctx, char *word){
+    listWords *words = ctx;
+    insert(words->list, word);
+    words->word_count++;
+}
 
-        for (int i = 0; i < bytes_read; i++){
+void fillList(List **listOne, int fd, int rules){
 
-            if (!isspace(buf[i])){
+    unsigned char * buf = malloc(TOKENBUF);
+    listWords words = { listOne, 0 };
+    tokenizer_t tok;
+    init_tokenizer(&tok, rules, insertWord, &words);
+    size_t have = 0;
+    int atEnd = 0;
 
-                //Uppercase/Lowercase alphabet
-                if (isalpha(buf[i])){
-                    strbuf_append(&sb, tolower(buf[i]));
-                }
-                //Digits
-                if (isdigit(buf[i])){
-                    strbuf_append(&sb, buf[i]);
-                }
-                //Hyphen
-                if (buf[i]==45){
-                    strbuf_append(&sb, buf[i]);
-                }
+    //read from file, keeping a character cut off at the end of the buffer for the next read
+    while (!atEnd || have > 0){
 
+        if (!atEnd){
+            ssize_t bytes_read = read(fd, buf + have, TOKENBUF - have);
+            if (bytes_read <= 0){
+                atEnd = 1;
             } else {
-
-                //Insert only if sb is not empty
-                if (sb.used != 0){
-                    insert(listOne, sb.data);
-                    //clear the strbuf
-                    sb.used = 0;
-                    sb.data[0] = '\0';
-                    word_count++;
-                }
-
-                continue;
-
+                have += bytes_read;
             }
         }
 
-        bytes_read = read(fd, buf, SIZE);
+        size_t used = tokenize(&tok, buf, have, atEnd);
+        memmove(buf, buf + used, have - used);
+        have -= used;
 
     }
 
-    //Insert only if sb is not empty
-    if (sb.used != 0){
-        insert(listOne, sb.data);
-        //clear the strbuf
-        sb.used = 0;
-        sb.data[0] = '\0';
-        word_count++;
-    }
+    //Insert the last word, if any
+    tokenEndWord(&tok);
+    uint64_t word_count = words.word_count;
 
     //compute WFD
     computeWFD(*listOne, word_count);
 
     //deallocate local resources
     free(buf);
-    strbuf_destroy(&sb);
+    destroy_tokenizer(&tok);
 
     return;
 
@@ -479,25 +636,331 @@ double calculateJSD(List* listOne, List* listTwo, int *countAddress){
     return JSD;
 }
 
+/**
+ * purpose: the metrics of a pair with an empty document: two empty ones are
+ * identical, and one is as far as possible from any other.
+ */
+void emptyMetrics(int empty1, int empty2, pair_metrics_t *out){
+    int same = empty1 && empty2;
+    out->JSD = same ? 0 : sqrt(0.5);
+    out->cosine = same ? 1 : 0;
+    out->hellinger = same ? 0 : 1;
+    out->shared = 0;
+}
+
+/**
+ * purpose: every metric of two lists in one merge walk over the shared
+ * support, without building the mean distribution calculateJSD builds.
+ * The JSD is summed as vectorJSD sums it, so it can differ from
+ * calculateJSD's in the last bits.
+ */
+void listMetrics(List *listOne, List *listTwo, pair_metrics_t *out){
+    out->totalWords = countLength(listOne) + countLength(listTwo);
+    if(listOne == NULL || listTwo == NULL){
+        emptyMetrics(listOne == NULL, listTwo == NULL, out);
+        return;
+    }
+
+    double KLD1 = 0.0, KLD2 = 0.0;
+    double dot = 0.0, norm1 = 0.0, norm2 = 0.0, bc = 0.0;
+    int shared = 0;
+    List *temp1 = listOne;
+    List *temp2 = listTwo;
+    while(temp1 != NULL || temp2 != NULL){
+        int cmp = (temp1 == NULL) ? 1 : (temp2 == NULL) ? -1 : strcmp(temp1->word, temp2->word);
+        if(cmp == 0){
+            double wfd1 = temp1->WFD, wfd2 = temp2->WFD;
+            double mean = (wfd1 + wfd2) / 2;
+            KLD1 += wfd1 * log2(wfd1 / mean);
+            KLD2 += wfd2 * log2(wfd2 / mean);
+            dot += wfd1 * wfd2;
+            bc += sqrt(wfd1 * wfd2);
+            norm1 += wfd1 * wfd1;
+            norm2 += wfd2 * wfd2;
+            shared++;
+            temp1 = temp1->next;
+            temp2 = temp2->next;
+        } else if(cmp < 0){
+            KLD1 += temp1->WFD;
+            norm1 += temp1->WFD * temp1->WFD;
+            temp1 = temp1->next;
+        } else {
+            KLD2 += temp2->WFD;
+            norm2 += temp2->WFD * temp2->WFD;
+            temp2 = temp2->next;
+        }
+    }
+
+    out->JSD = sqrt((0.5*KLD1) + (0.5*KLD2));
+    out->cosine = dot / sqrt(norm1 * norm2);
+    out->hellinger = (bc < 1) ? sqrt(1 - bc) : 0;
+    out->shared = shared;
+}
+
+//---------------------------------------------------------------------
+// Pair tiles and results
+//---------------------------------------------------------------------
+
+/*
+ * The documents are sorted by path once collection is done, so a pair (i, j)
+ * with i < j has the same index in every process: pairs are numbered row by
+ * row, exactly in the order of the old "for i ... for j = i+1" loop.
+ *
+ * A tile is a block of pairs: rows [rowStart, rowEnd) against columns
+ * [colStart, colEnd), keeping only j > i. Analysis threads take whole tiles
+ * so both blocks of documents stay in cache while the tile is computed.
+ * Results for a tile are written starting at fs[base].
+ *
+ * A bipartite run (--against) holds its two sets one after the other, each
+ * sorted on its own, and only pairs rows [0, split) with columns
+ * [split, numDocs); its pairs are numbered row by row over that rectangle.
+ */
+typedef struct {
+    int rowStart;
+    int rowEnd;
+    int colStart;
+    int colEnd;
+    long base;
+    int id;             //position in the array addTiles built
+} pair_tile_t;
+
+typedef struct {
+    char *filepath1;
+    char *filepath2;
+    long pairIndex;
+    double JSD;
+    int totalWords;
+    int pruned;
+    int shared;             //these three are only filled in when --metrics asks for more than the JSD
+    double cosine;
+    double hellinger;
+} final_struct;
+
+long pairIndex(int i, int j, int numDocs){
+    return (long) i * numDocs - ((long) i * (i + 1)) / 2 + (j - i - 1);
+}
+
+//the index of pair (i, j) in a run over all pairs (split 0) or a bipartite one
+long runPairIndex(int i, int j, int numDocs, int split){
+    if(split > 0) return (long) i * (numDocs - split) + (j - split);
+    return pairIndex(i, j, numDocs);
+}
+
+long tilePairs(pair_tile_t *tile){
+    long count = 0;
+    for(int i = tile->rowStart; i < tile->rowEnd; i++){
+        int j = (tile->colStart > i + 1) ? tile->colStart : i + 1;
+        if(j < tile->colEnd) count += tile->colEnd - j;
+    }
+    return count;
+}
+
+//set reached[d] for every document d that is in one of the tile's pairs
+void markTileDocuments(pair_tile_t *tile, char *reached){
+    for(int i = tile->rowStart; i < tile->rowEnd; i++){
+        int j = (tile->colStart > i + 1) ? tile->colStart : i + 1;
+        if(j >= tile->colEnd) continue;
+        reached[i] = 1;
+        for(; j < tile->colEnd; j++) reached[j] = 1;
+    }
+}
+
+/**
+ * purpose: split rows [rowStart, rowEnd) x columns [colStart, colEnd) into
+ * tiles of at most tileSize documents a side and append them to *tiles.
+ * *base is the next free index of the results array and is advanced past
+ * every pair added. Returns the new tile count.
+ */
+int addTiles(pair_tile_t **tiles, int count, int *capacity, int rowStart, int rowEnd,
+             int colStart, int colEnd, int tileSize, long *base){
+
+    for(int r = rowStart; r < rowEnd; r += tileSize){
+        for(int c = colStart; c < colEnd; c += tileSize){
+            pair_tile_t tile;
+            tile.rowStart = r;
+            tile.rowEnd = (r + tileSize < rowEnd) ? r + tileSize : rowEnd;
+            tile.colStart = c;
+            tile.colEnd = (c + tileSize < colEnd) ? c + tileSize : colEnd;
+            tile.base = *base;
+            tile.id = count;
+
+            long pairs = tilePairs(&tile);
+            if(pairs == 0) continue;
+
+            if(count == *capacity){
+                *capacity = (*capacity == 0) ? 16 : 2 * *capacity;
+                pair_tile_t *temp = realloc(*tiles, sizeof(pair_tile_t) * *capacity);
+                if(temp == NULL){
+                    perror("tile realloc failed");
+                    abort();
+                }
+                *tiles = temp;
+            }
+            (*tiles)[count++] = tile;
+            *base += pairs;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * purpose: the tiles of a bipartite run. A block of the larger side is listed
+ * with all its tiles in a row, so it is read once while the smaller side,
+ * which stays in cache, is swept against it.
+ */
+int addCrossTiles(pair_tile_t **tiles, int count, int *capacity, int split, int numDocs, int tileSize, long *base){
+    if(split >= numDocs - split){
+        return addTiles(tiles, count, capacity, 0, split, split, numDocs, tileSize, base);
+    }
+    for(int c = split; c < numDocs; c += tileSize){
+        int colEnd = (c + tileSize < numDocs) ? c + tileSize : numDocs;
+        count = addTiles(tiles, count, capacity, 0, split, c, colEnd, tileSize, base);
+    }
+    return count;
+}
+
+/**
+ * purpose: order results by combined word count, largest first. Ties go to
+ * the lower pair index so the order never depends on thread timing.
+ */
+int compareResults(const void *a, const void *b){
+    const final_struct *x = a;
+    const final_struct *y = b;
+    if(x->totalWords != y->totalWords){
+        return (x->totalWords < y->totalWords) ? 1 : -1;
+    }
+    return (x->pairIndex > y->pairIndex) - (x->pairIndex < y->pairIndex);
+}
+
+void sortStruct(final_struct *fs, long size){
+    qsort(fs, size, sizeof(final_struct), compareResults);
+}
+
+static const char *metricNames[] = { "jsd", "cosine", "hellinger", "jaccard", "shared" };
+
+/**
+ * purpose: the metrics named in a comma separated list ("all" for every
+ * one), or -1 if a name is unknown.
+ */
+int parseMetrics(const char *names){
+    int metrics = 0;
+    const char *name = names;
+    while(*name != '\0'){
+        size_t length = strcspn(name, ",");
+        int found = (length == 3 && strncmp(name, "all", 3) == 0) ? METRIC_ALL : 0;
+        for(int m = 0; m < (int) (sizeof(metricNames) / sizeof(metricNames[0])) && !found; m++){
+            if(strlen(metricNames[m]) == length && strncmp(name, metricNames[m], length) == 0) found = 1 << m;
+        }
+        if(!found) return -1;
+        metrics |= found;
+        name += length + (name[length] == ',');
+    }
+    return (metrics == 0) ? -1 : metrics;
+}
+
+/**
+ * purpose: print one result line: the chosen metrics in the order of
+ * metricNames, then the two paths. With only the JSD this is the line
+ * compare has always printed. Returns what fprintf returns.
+ */
+int printResult(FILE *out, final_struct *pair, int metrics){
+    if(metrics == METRIC_JSD){
+        return fprintf(out, "%f     %s     %s\n", pair->JSD, pair->filepath1, pair->filepath2);
+    }
+
+    char columns[128];
+    int used = 0;
+    int either = pair->totalWords - pair->shared;     //words in either document
+    double jaccard = (either > 0) ? (double) pair->shared / either : 1.0;
+    if(metrics & METRIC_JSD) used += sprintf(columns + used, "%f     ", pair->JSD);
+    if(metrics & METRIC_COSINE) used += sprintf(columns + used, "%f     ", pair->cosine);
+    if(metrics & METRIC_HELLINGER) used += sprintf(columns + used, "%f     ", pair->hellinger);
+    if(metrics & METRIC_JACCARD) used += sprintf(columns + used, "%f     ", jaccard);
+    if(metrics & METRIC_SHARED) used += sprintf(columns + used, "%d     ", pair->shared);
+    return fprintf(out, "%s%s     %s\n", columns, pair->filepath1, pair->filepath2);
+}
+
+int compareDocuments(const void *a, const void *b){
+    const FileAndList *x = *(FileAndList * const *) a;
+    const FileAndList *y = *(FileAndList * const *) b;
+    return strcmp(x->filepath, y->filepath);
+}
+
+/**
+ * purpose: give the documents a fixed order so pair indices are reproducible.
+ */
+void sortRepository(repository *repos){
+    qsort(repos->fal, repos->nextIndex, sizeof(FileAndList *), compareDocuments);
+}
+
+typedef struct {
+    FileAndList *owner;
+    int index;
+} owner_index_t;
+
+int compareOwners(const void *a, const void *b){
+    const owner_index_t *x = a;
+    const owner_index_t *y = b;
+    if(x->owner != y->owner) return (x->owner > y->owner) - (x->owner < y->owner);
+    return (x->index > y->index) - (x->index < y->index);
+}
+
+/**
+ * purpose: number each document's content after the repository is sorted:
+ * group[i] is the index of the first document identical to document i, so
+ * the distinct documents are exactly those with group[i] == i.
+ */
+void contentGroups(repository *repos, int *group){
+    int numDocs = repos->nextIndex;
+    owner_index_t *owners = malloc(sizeof(owner_index_t) * (numDocs + 1));
+    for(int i = 0; i < numDocs; i++){
+        owners[i].owner = repos->fal[i]->same ? repos->fal[i]->same : repos->fal[i];
+        owners[i].index = i;
+    }
+    qsort(owners, numDocs, sizeof(owner_index_t), compareOwners);
+
+    for(int i = 0; i < numDocs; i++){
+        int first = (i > 0 && owners[i].owner == owners[i - 1].owner) ? group[owners[i - 1].index] : owners[i].index;
+        group[owners[i].index] = first;
+    }
+    free(owners);
+}
+
+/**
+ * purpose: keep the content groups of a bipartite run on one side: a column
+ * document identical to a row document joins the first column document with
+ * that content instead, so both sides keep a copy to pair.
+ */
+void splitContentGroups(int *group, int numDocs, int split){
+    int *firstColumn = malloc(sizeof(int) * (split + 1));
+    for(int i = 0; i < split; i++){
+        firstColumn[i] = -1;
+    }
+    for(int i = split; i < numDocs; i++){
+        int first = group[i];
+        if(first >= split) continue;
+        if(firstColumn[first] < 0) firstColumn[first] = i;
+        group[i] = firstColumn[first];
+    }
+    free(firstColumn);
+}
+
 //---------------------------------------------------------------------
 // Analysis Queue Functions
 //---------------------------------------------------------------------
 
 typedef struct {
-    FileAndList** falOne;
-    FileAndList** falTwo;
+    pair_tile_t tiles[AQSIZE];
     unsigned count;
     unsigned head;
     int open;
-    int fsIndex[AQSIZE];
     pthread_mutex_t lock;
     pthread_cond_t read_ready;
     pthread_cond_t write_ready;
 } analysis_queue_t;
 
 int init_analysis(analysis_queue_t *q){
-    q->falOne = malloc(sizeof(FileAndList*) * AQSIZE);
-    q->falTwo = malloc(sizeof(FileAndList*) * AQSIZE);
     q->count = 0;
     q->head = 0;
     q->open = 1;
@@ -511,15 +974,13 @@ int init_analysis(analysis_queue_t *q){
 }
 
 int destory_analysis(analysis_queue_t *q){
-    free(q->falOne);
-    free(q->falTwo);
     pthread_mutex_destroy(&q->lock);
     pthread_cond_destroy(&q->read_ready);
     pthread_cond_destroy(&q->write_ready);
     return 0;
 }
 
-int enqueue_analysis(analysis_queue_t *q, FileAndList* l1, FileAndList* l2, int writeIndex){
+int enqueue_analysis(analysis_queue_t *q, pair_tile_t *tile){
 
     if(pthread_mutex_lock(&q->lock)){
         perror("lock error");
@@ -538,9 +999,7 @@ int enqueue_analysis(analysis_queue_t *q, FileAndList* l1, FileAndList* l2, int
     unsigned i = q->head + q->count;
     if(i >= AQSIZE) i -= AQSIZE;
 
-    q->falOne[i] = l1;
-    q->falTwo[i] = l2;
-    q->fsIndex[i] = writeIndex;
+    q->tiles[i] = *tile;
     q->count++;
 
     pthread_cond_signal(&q->read_ready);
@@ -551,7 +1010,7 @@ int enqueue_analysis(analysis_queue_t *q, FileAndList* l1, FileAndList* l2, int
 
 }
 
-int dequeue_analysis(analysis_queue_t *q, FileAndList** l1_address, FileAndList** l2_address, int* indexAddress){
+int dequeue_analysis(analysis_queue_t *q, pair_tile_t *tile){
 
     if(pthread_mutex_lock(&q->lock)){
         perror("lock failed");
@@ -567,9 +1026,7 @@ int dequeue_analysis(analysis_queue_t *q, FileAndList** l1_address, FileAndList*
 		return -1;
 	}
 
-	*l1_address = q->falOne[q->head];
-    *l2_address = q->falTwo[q->head];
-    *indexAddress = q->fsIndex[q->head];
+	*tile = q->tiles[q->head];
 	--q->count;
 	++q->head;
 	if (q->head == AQSIZE) q->head = 0;
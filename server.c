@@ -0,0 +1,541 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#define SERVE_MAX_PAYLOAD (64 << 20)
+#define SERVE_READ_SIZE 65536
+#define SERVE_MAX_BACKLOG (64 * SERVE_READ_SIZE)   //unsent reply bytes past which a client is not read
+
+//---------------------------------------------------------------------
+// Resident server: one engine answering requests on a Unix socket
+//---------------------------------------------------------------------
+
+/*
+ * compare --serve path tokenizes (or --load-corpus maps) the corpus once and
+ * then answers requests on the Unix stream socket at path until SIGINT or
+ * SIGTERM. A request is a serve_request_t followed by length payload bytes:
+ *
+ *     SERVE_ADD_PATH   payload is a path to read; reply id
+ *     SERVE_ADD_TEXT   arg1 name bytes then the text; reply id
+ *     SERVE_REMOVE     arg1 is the document ID
+ *     SERVE_QUERY      arg1 is k, the payload is the text; reply count, then
+ *                      count serve_match_t each followed by its name bytes
+ *     SERVE_PAIR       arg1 and arg2 are document IDs; reply jsd
+ *
+ * Every request gets exactly one serve_reply_t (status 0, or -1 on failure),
+ * in the order the client sent them. Numbers are in host byte order.
+ *
+ * All requests that arrived by the time the server wakes up are handled as
+ * one round: queries between two adds or removes run as one batch, so they
+ * share the reads of the inverted index, and the replies are only queued
+ * once the whole round is done.
+ *
+ * The poll loop never waits on a client or on the engine. Sockets are non
+ * blocking and every client has its own queue of reply bytes, written as
+ * the socket takes them (POLLOUT); a client that stops reading is not read
+ * from either once SERVE_MAX_BACKLOG bytes wait for it, so only it stalls.
+ * A round runs on a worker thread (an add may tokenize a whole file) while
+ * the loop keeps writing replies and accepting clients; nothing new is read
+ * until the round is done, since its payloads point into the read buffers.
+ */
+
+enum { SERVE_ADD_PATH = 1, SERVE_ADD_TEXT, SERVE_REMOVE, SERVE_QUERY, SERVE_PAIR };
+
+typedef struct {
+    uint32_t op;
+    int32_t arg1;
+    int32_t arg2;
+    uint32_t length;
+} serve_request_t;
+
+typedef struct {
+    int32_t status;
+    int32_t id;
+    uint32_t count;
+    uint32_t reserved;
+    double jsd;
+} serve_reply_t;
+
+typedef struct {
+    int32_t id;
+    uint32_t nameLength;
+    double jsd;
+} serve_match_t;
+
+typedef struct {
+    int fd;
+    char *in;               //bytes received and not yet handled
+    size_t inUsed;
+    size_t inCapacity;
+    size_t handled;         //bytes of in taken by the requests of the current round
+    char *out;              //replies not yet taken by the socket, from outSent on
+    size_t outSent;
+    size_t outUsed;
+    size_t outCapacity;
+    int closed;
+} serve_client_t;
+
+//one complete request of the current round, its payload still in the client's buffer
+typedef struct {
+    serve_client_t *client;
+    serve_request_t request;
+    const char *payload;
+    serve_reply_t reply;
+    jsd_match *matches;
+} serve_pending_t;
+
+static volatile sig_atomic_t serveStop = 0;
+
+void serveSignal(int sig){
+    (void) sig;
+    serveStop = 1;
+}
+
+int reserveBytes(char **data, size_t *capacity, size_t needed){
+    if(needed <= *capacity) return 0;
+    size_t size = (*capacity > 0) ? *capacity : SERVE_READ_SIZE;
+    while(size < needed) size *= 2;
+    char *p = realloc(*data, size);
+    if(p == NULL) return 1;
+    *data = p;
+    *capacity = size;
+    return 0;
+}
+
+void appendReply(serve_client_t *client, const void *data, size_t n){
+    if(reserveBytes(&client->out, &client->outCapacity, client->outUsed + n)){
+        perror("server reply, malloc failed!");
+        abort();
+    }
+    memcpy(client->out + client->outUsed, data, n);
+    client->outUsed += n;
+}
+
+/**
+ * purpose: read whatever the client has sent without blocking.
+ * Marks the client closed on end of file or error.
+ */
+void receiveRequests(serve_client_t *client){
+    while(1){
+        if(reserveBytes(&client->in, &client->inCapacity, client->inUsed + SERVE_READ_SIZE)){
+            client->closed = 1;
+            return;
+        }
+        ssize_t n = recv(client->fd, client->in + client->inUsed, SERVE_READ_SIZE, MSG_DONTWAIT);
+        if(n > 0){
+            client->inUsed += n;
+        } else if(n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)){
+            client->closed = 1;
+            return;
+        } else {
+            return;
+        }
+    }
+}
+
+/**
+ * purpose: answer the queries pending[batch[0..numBatch)] as one batch.
+ */
+void flushQueries(jsd_engine *engine, serve_pending_t *pending, int *batch, int numBatch){
+    if(numBatch <= 0) return;
+
+    //one k for the batch: the first k of a longer top list is the shorter top list
+    int k = 1;
+    const char **data = malloc(sizeof(char *) * numBatch);
+    size_t *lengths = malloc(sizeof(size_t) * numBatch);
+    int *found = malloc(sizeof(int) * numBatch);
+    for(int b = 0; b < numBatch; b++){
+        serve_pending_t *p = &pending[batch[b]];
+        data[b] = p->payload;
+        lengths[b] = p->request.length;
+        if(p->request.arg1 > k) k = p->request.arg1;
+    }
+    int numDocs = jsd_engine_count(engine) + engine->numRemoved;
+    if(k > numDocs) k = (numDocs > 0) ? numDocs : 1;
+
+    jsd_match *matches = malloc(sizeof(jsd_match) * (size_t) numBatch * k);
+    jsd_engine_query_batch(engine, data, lengths, numBatch, matches, k, found);
+
+    for(int b = 0; b < numBatch; b++){
+        serve_pending_t *p = &pending[batch[b]];
+        int count = (found[b] < p->request.arg1) ? found[b] : p->request.arg1;
+        p->matches = malloc(sizeof(jsd_match) * (count + 1));
+        memcpy(p->matches, matches + (size_t) b * k, sizeof(jsd_match) * count);
+        p->reply.count = count;
+    }
+
+    free(data);
+    free(lengths);
+    free(found);
+    free(matches);
+}
+
+/**
+ * purpose: run one round of requests in order, batching the queries that
+ * are not separated by an add or a remove.
+ */
+void runRound(jsd_engine *engine, serve_pending_t *pending, int numPending){
+    int *batch = malloc(sizeof(int) * (numPending + 1));
+    int numBatch = 0;
+
+    for(int i = 0; i < numPending; i++){
+        serve_pending_t *p = &pending[i];
+        serve_request_t *req = &p->request;
+        memset(&p->reply, 0, sizeof(serve_reply_t));
+        p->matches = NULL;
+
+        if(req->op == SERVE_QUERY){
+            if(req->arg1 < 1){
+                p->reply.status = -1;
+            } else {
+                batch[numBatch++] = i;
+            }
+            continue;
+        }
+        if(req->op == SERVE_PAIR){
+            //pairs do not change the corpus, so they need not wait for the batch
+            p->reply.jsd = jsd_engine_pair(engine, req->arg1, req->arg2);
+            p->reply.status = (p->reply.jsd < 0) ? -1 : 0;
+            continue;
+        }
+
+        //adds and removes change the corpus: the queries before them run first
+        flushQueries(engine, pending, batch, numBatch);
+        numBatch = 0;
+
+        if(req->op == SERVE_ADD_PATH || req->op == SERVE_ADD_TEXT){
+            size_t nameLength = (req->op == SERVE_ADD_PATH) ? req->length : (size_t) (uint32_t) req->arg1;
+            if(nameLength > req->length){
+                p->reply.status = -1;
+                continue;
+            }
+            char *name = malloc(nameLength + 1);
+            memcpy(name, p->payload, nameLength);
+            name[nameLength] = '\0';
+            if(req->op == SERVE_ADD_PATH){
+                p->reply.id = jsd_engine_add_path(engine, name);
+            } else {
+                p->reply.id = jsd_engine_add_buffer(engine, name, p->payload + nameLength, req->length - nameLength);
+            }
+            p->reply.status = (p->reply.id < 0) ? -1 : 0;
+            free(name);
+        } else if(req->op == SERVE_REMOVE){
+            p->reply.status = jsd_engine_remove(engine, req->arg1);
+        } else {
+            p->reply.status = -1;
+        }
+    }
+    flushQueries(engine, pending, batch, numBatch);
+
+    free(batch);
+}
+
+/**
+ * purpose: write as much of a client's queued replies as the socket takes
+ * without blocking. Marks the client closed on error.
+ */
+void sendReplies(serve_client_t *client){
+    while(client->outSent < client->outUsed && !client->closed){
+        ssize_t n = send(client->fd, client->out + client->outSent, client->outUsed - client->outSent,
+                         MSG_NOSIGNAL | MSG_DONTWAIT);
+        if(n < 0 && errno == EINTR) continue;
+        if(n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if(n <= 0){
+            client->closed = 1;
+            break;
+        }
+        client->outSent += n;
+    }
+
+    //keep the unsent tail at the front once most of the buffer has gone out
+    if(client->outSent == client->outUsed){
+        client->outSent = client->outUsed = 0;
+    } else if(client->outSent > client->outCapacity / 2){
+        memmove(client->out, client->out + client->outSent, client->outUsed - client->outSent);
+        client->outUsed -= client->outSent;
+        client->outSent = 0;
+    }
+}
+
+//a client with this many reply bytes waiting gets no more requests handled
+int backlogged(const serve_client_t *client){
+    return client->outUsed - client->outSent > SERVE_MAX_BACKLOG;
+}
+
+int setNonBlocking(int fd){
+    int flags = fcntl(fd, F_GETFL);
+    return (flags == -1 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) == -1) ? -1 : 0;
+}
+
+//the thread running rounds, so the poll loop never waits on the engine
+typedef struct {
+    jsd_engine *engine;
+    serve_pending_t *pending;
+    int numPending;
+    int busy;               //a round was handed over and is not done
+    int stop;
+    int wake;               //written once a round is done, read by the poll loop
+    pthread_mutex_t lock;
+    pthread_cond_t ready;
+} serve_worker_t;
+
+void* serveWorkerTask(void* arg){
+    serve_worker_t *worker = arg;
+
+    pthread_mutex_lock(&worker->lock);
+    while(1){
+        while(!worker->busy && !worker->stop){
+            pthread_cond_wait(&worker->ready, &worker->lock);
+        }
+        if(!worker->busy) break;
+        pthread_mutex_unlock(&worker->lock);
+
+        runRound(worker->engine, worker->pending, worker->numPending);
+
+        pthread_mutex_lock(&worker->lock);
+        worker->busy = 0;
+        char done = 1;
+        while(write(worker->wake, &done, 1) < 0 && errno == EINTR);
+    }
+    pthread_mutex_unlock(&worker->lock);
+    return NULL;
+}
+
+int openServerSocket(const char *path){
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if(strlen(path) >= sizeof(addr.sun_path)){
+        fprintf(stderr, "ERROR: socket path %s is too long\n", path);
+        return -1;
+    }
+    strcpy(addr.sun_path, path);
+
+    //a socket left behind by an earlier server is replaced, anything else is not
+    struct stat st;
+    if(lstat(path, &st) == 0 && S_ISSOCK(st.st_mode)){
+        unlink(path);
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(fd == -1 || bind(fd, (struct sockaddr *) &addr, sizeof(addr)) || listen(fd, 64)){
+        perror(path);
+        if(fd != -1) close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * purpose: answer requests on the socket at path until SIGINT or SIGTERM.
+ * The engine must hold the corpus already.
+ */
+int serveEngine(const char *path, jsd_engine *engine){
+    int listener = openServerSocket(path);
+    if(listener == -1){
+        return 1;
+    }
+    int wake[2];
+    if(setNonBlocking(listener) || pipe(wake)){
+        perror(path);
+        close(listener);
+        return 1;
+    }
+    setNonBlocking(wake[0]);
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = serveSignal;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    //the signals have to interrupt poll, so the worker never takes them
+    serve_worker_t worker;
+    memset(&worker, 0, sizeof(worker));
+    worker.engine = engine;
+    worker.wake = wake[1];
+    pthread_mutex_init(&worker.lock, NULL);
+    pthread_cond_init(&worker.ready, NULL);
+    sigset_t blocked, previous;
+    sigemptyset(&blocked);
+    sigaddset(&blocked, SIGINT);
+    sigaddset(&blocked, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &blocked, &previous);
+    pthread_t workerThread;
+    pthread_create(&workerThread, NULL, serveWorkerTask, &worker);
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+
+    fprintf(stderr, "serving %d documents on %s\n", jsd_engine_count(engine), path);
+
+    serve_client_t **clients = NULL;
+    int numClients = 0;
+    struct pollfd *fds = malloc(sizeof(struct pollfd) * 2);
+    serve_pending_t *pending = NULL;
+    int pendingCapacity = 0;
+    int numPending = 0;
+    int inFlight = 0;
+
+    while(!serveStop){
+        fds[0].fd = listener;
+        fds[0].events = POLLIN;
+        fds[1].fd = wake[0];
+        fds[1].events = POLLIN;
+        for(int c = 0; c < numClients; c++){
+            serve_client_t *client = clients[c];
+            fds[c + 2].fd = client->closed ? -1 : client->fd;
+            fds[c + 2].events = ((inFlight || backlogged(client)) ? 0 : POLLIN)
+                              | ((client->outSent < client->outUsed) ? POLLOUT : 0);
+            fds[c + 2].revents = 0;
+        }
+        if(poll(fds, numClients + 2, -1) < 0){
+            if(errno == EINTR) continue;
+            perror("poll");
+            break;
+        }
+
+        //a finished round: queue its replies in request order, then drop the handled bytes
+        if(fds[1].revents & POLLIN){
+            char done[64];
+            while(read(wake[0], done, sizeof(done)) > 0);
+            pthread_mutex_lock(&worker.lock);
+            inFlight = worker.busy;
+            pthread_mutex_unlock(&worker.lock);
+        }
+        if(!inFlight && numPending > 0){
+            for(int i = 0; i < numPending; i++){
+                serve_pending_t *p = &pending[i];
+                appendReply(p->client, &p->reply, sizeof(serve_reply_t));
+                for(uint32_t m = 0; m < p->reply.count; m++){
+                    serve_match_t match;
+                    match.id = p->matches[m].id;
+                    match.nameLength = strlen(p->matches[m].name);
+                    match.jsd = p->matches[m].jsd;
+                    appendReply(p->client, &match, sizeof(match));
+                    appendReply(p->client, p->matches[m].name, match.nameLength);
+                }
+                free(p->matches);
+            }
+            numPending = 0;
+            for(int c = 0; c < numClients; c++){
+                serve_client_t *client = clients[c];
+                if(client->handled == 0) continue;
+                memmove(client->in, client->in + client->handled, client->inUsed - client->handled);
+                client->inUsed -= client->handled;
+                client->handled = 0;
+            }
+        }
+
+        //write what the sockets take, read everything that arrived
+        for(int c = 0; c < numClients; c++){
+            serve_client_t *client = clients[c];
+            if(client->outSent < client->outUsed){
+                sendReplies(client);
+            }
+            if(!inFlight && (fds[c + 2].revents & (POLLIN | POLLHUP | POLLERR))){
+                receiveRequests(client);
+            } else if(fds[c + 2].revents & (POLLHUP | POLLERR)){
+                client->closed = 1;
+            }
+        }
+
+        //cut the buffers into complete requests, in client order, and hand them to the worker
+        for(int c = 0; c < numClients && !inFlight; c++){
+            serve_client_t *client = clients[c];
+            size_t pos = 0;
+            serve_request_t req;
+            while(!backlogged(client) && client->inUsed - pos >= sizeof(req)){
+                memcpy(&req, client->in + pos, sizeof(req));
+                if(req.length > SERVE_MAX_PAYLOAD){
+                    client->closed = 1;
+                    break;
+                }
+                if(client->inUsed - pos - sizeof(req) < req.length) break;
+                if(numPending == pendingCapacity){
+                    pendingCapacity = pendingCapacity ? 2 * pendingCapacity : 64;
+                    pending = realloc(pending, sizeof(serve_pending_t) * pendingCapacity);
+                }
+                pending[numPending].client = client;
+                pending[numPending].request = req;
+                pending[numPending].payload = client->in + pos + sizeof(req);
+                numPending++;
+                pos += sizeof(req) + req.length;
+            }
+            client->handled = pos;
+        }
+        if(!inFlight && numPending > 0){
+            pthread_mutex_lock(&worker.lock);
+            worker.pending = pending;
+            worker.numPending = numPending;
+            worker.busy = 1;
+            pthread_cond_signal(&worker.ready);
+            pthread_mutex_unlock(&worker.lock);
+            inFlight = 1;
+        }
+
+        //drop the clients that went away, once no round points into their buffers
+        int kept = 0;
+        for(int c = 0; c < numClients; c++){
+            if(clients[c]->closed && !inFlight){
+                close(clients[c]->fd);
+                free(clients[c]->in);
+                free(clients[c]->out);
+                free(clients[c]);
+            } else {
+                clients[kept++] = clients[c];
+            }
+        }
+        numClients = kept;
+
+        //new clients join the next round
+        if(fds[0].revents & POLLIN){
+            int fd = accept(listener, NULL, NULL);
+            if(fd != -1 && setNonBlocking(fd)){
+                close(fd);
+            } else if(fd != -1){
+                clients = realloc(clients, sizeof(serve_client_t *) * (numClients + 1));
+                fds = realloc(fds, sizeof(struct pollfd) * (numClients + 3));
+                serve_client_t *client = calloc(1, sizeof(serve_client_t));
+                client->fd = fd;
+                clients[numClients++] = client;
+            }
+        }
+    }
+
+    //a round still running is finished, and its replies are dropped
+    pthread_mutex_lock(&worker.lock);
+    worker.stop = 1;
+    pthread_cond_signal(&worker.ready);
+    pthread_mutex_unlock(&worker.lock);
+    pthread_join(workerThread, NULL);
+    for(int i = 0; i < numPending; i++){
+        free(pending[i].matches);
+    }
+    pthread_mutex_destroy(&worker.lock);
+    pthread_cond_destroy(&worker.ready);
+
+    for(int c = 0; c < numClients; c++){
+        close(clients[c]->fd);
+        free(clients[c]->in);
+        free(clients[c]->out);
+        free(clients[c]);
+    }
+    free(clients);
+    free(fds);
+    free(pending);
+    close(wake[0]);
+    close(wake[1]);
+    close(listener);
+    unlink(path);
+    return 0;
+}
@@ -0,0 +1,264 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#define SHARD_MAGIC "JSDS"
+#define SHARD_VERSION 2
+
+//---------------------------------------------------------------------
+// Sharded runs: splitting the pair matrix between processes
+//---------------------------------------------------------------------
+
+/*
+ * The sorted documents are cut into g groups, and the pair matrix into the
+ * g(g+1)/2 blocks "group a against group b" with a <= b. Block k goes to
+ * shard k % n, where g is the smallest group count with at least n blocks.
+ * A shard only reads the documents of the groups its blocks touch, about
+ * 2/g of the corpus when every shard gets one block.
+ *
+ * Every shard writes its results, already sorted, as a binary file:
+ *
+ *     header   "JSDS", uint32 version, uint32 shard index, uint32 shard count,
+ *              uint32 --metrics flags, uint32 unused, uint64 document count
+ *     records  int64 pair index, int32 total words, int32 shared words,
+ *              double JSD, double cosine, double Hellinger,
+ *              uint32 path 1 length, uint32 path 2 length, path bytes
+ *
+ * Numbers are in host byte order. "compare merge" k-way merges the records
+ * with the same ordering the single process run uses, so the merged output is
+ * the same text a single process would print.
+ */
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t shardIndex;
+    uint32_t shardCount;
+    uint32_t metrics;           //what the shards computed and merge prints
+    uint32_t unused;
+    uint64_t numDocs;
+} shard_header_t;
+
+typedef struct {
+    int64_t pairIndex;
+    int32_t totalWords;
+    int32_t shared;
+    double JSD;
+    double cosine;
+    double hellinger;
+    uint32_t length1;
+    uint32_t length2;
+} shard_record_t;
+
+int shardGroups(int shardCount){
+    int groups = 1;
+    while(groups * (groups + 1) / 2 < shardCount) groups++;
+    return groups;
+}
+
+int groupStart(int group, int groups, int numDocs){
+    return (int) (((long) group * numDocs) / groups);
+}
+
+/**
+ * purpose: build the tiles of one shard, and flag in needed[] every
+ * document those tiles read. Returns the number of tiles; *pairs is set
+ * to the number of pairs they hold.
+ */
+int shardTiles(int shardIndex, int shardCount, int numDocs, pair_tile_t **tiles, char *needed, long *pairs){
+    int groups = shardGroups(shardCount);
+    int count = 0;
+    int capacity = 0;
+    int block = 0;
+    *tiles = NULL;
+    *pairs = 0;
+    memset(needed, 0, numDocs);
+
+    for(int a = 0; a < groups; a++){
+        for(int b = a; b < groups; b++, block++){
+            if(block % shardCount != shardIndex) continue;
+
+            int rowStart = groupStart(a, groups, numDocs);
+            int rowEnd = groupStart(a + 1, groups, numDocs);
+            int colStart = groupStart(b, groups, numDocs);
+            int colEnd = groupStart(b + 1, groups, numDocs);
+            count = addTiles(tiles, count, &capacity, rowStart, rowEnd, colStart, colEnd, TILESIZE, pairs);
+
+            memset(needed + rowStart, 1, rowEnd - rowStart);
+            memset(needed + colStart, 1, colEnd - colStart);
+        }
+    }
+
+    return count;
+}
+
+/**
+ * purpose: write the (sorted) results of one shard.
+ */
+int writeShard(FILE *out, int shardIndex, int shardCount, int numDocs, final_struct *fs, long size, double threshold,
+               int metrics){
+    shard_header_t header;
+    memcpy(header.magic, SHARD_MAGIC, 4);
+    header.version = SHARD_VERSION;
+    header.shardIndex = shardIndex;
+    header.shardCount = shardCount;
+    header.metrics = metrics;
+    header.unused = 0;
+    header.numDocs = numDocs;
+    if(fwrite(&header, sizeof(header), 1, out) != 1) return -1;
+
+    for(long i = 0; i < size; i++){
+        if(threshold >= 0 && (fs[i].pruned || fs[i].JSD > threshold)){
+            continue;
+        }
+        shard_record_t record;
+        record.pairIndex = fs[i].pairIndex;
+        record.totalWords = fs[i].totalWords;
+        record.shared = fs[i].shared;
+        record.JSD = fs[i].JSD;
+        record.cosine = fs[i].cosine;
+        record.hellinger = fs[i].hellinger;
+        record.length1 = strlen(fs[i].filepath1);
+        record.length2 = strlen(fs[i].filepath2);
+        if(fwrite(&record, sizeof(record), 1, out) != 1
+           || fwrite(fs[i].filepath1, 1, record.length1, out) != record.length1
+           || fwrite(fs[i].filepath2, 1, record.length2, out) != record.length2){
+            return -1;
+        }
+    }
+
+    return fflush(out) ? -1 : 0;
+}
+
+typedef struct {
+    FILE *in;
+    char *name;
+    int live;
+    final_struct current;
+} shard_reader_t;
+
+/**
+ * purpose: read the next record of a shard into reader->current.
+ * Returns 0 on success, 1 at the end of the file and -1 on a short record.
+ */
+int readShardRecord(shard_reader_t *reader){
+    shard_record_t record;
+    size_t got = fread(&record, sizeof(record), 1, reader->in);
+    if(got != 1){
+        return feof(reader->in) ? 1 : -1;
+    }
+
+    free(reader->current.filepath1);
+    free(reader->current.filepath2);
+    reader->current.filepath1 = malloc(record.length1 + 1);
+    reader->current.filepath2 = malloc(record.length2 + 1);
+    if(fread(reader->current.filepath1, 1, record.length1, reader->in) != record.length1
+       || fread(reader->current.filepath2, 1, record.length2, reader->in) != record.length2){
+        return -1;
+    }
+    reader->current.filepath1[record.length1] = '\0';
+    reader->current.filepath2[record.length2] = '\0';
+    reader->current.pairIndex = record.pairIndex;
+    reader->current.totalWords = record.totalWords;
+    reader->current.shared = record.shared;
+    reader->current.JSD = record.JSD;
+    reader->current.cosine = record.cosine;
+    reader->current.hellinger = record.hellinger;
+    reader->current.pruned = 0;
+    return 0;
+}
+
+/**
+ * purpose: "compare merge shard..." combines the outputs of every shard of
+ * a run and prints them like a single process would.
+ */
+int mergeShards(int count, char **paths){
+    int status = EXIT_SUCCESS;
+    shard_reader_t *readers = calloc(count, sizeof(shard_reader_t));
+    char *seen = NULL;
+    shard_header_t first;
+    memset(&first, 0, sizeof(first));
+
+    for(int i = 0; i < count; i++){
+        shard_header_t header;
+        readers[i].name = paths[i];
+        readers[i].in = fopen(paths[i], "rb");
+        if(readers[i].in == NULL){
+            perror(paths[i]);
+            status = EXIT_FAILURE;
+            goto done;
+        }
+
+        if(fread(&header, sizeof(header), 1, readers[i].in) != 1
+           || memcmp(header.magic, SHARD_MAGIC, 4) != 0 || header.version != SHARD_VERSION){
+            fprintf(stderr, "ERROR: %s is not a shard file\n", paths[i]);
+            status = EXIT_FAILURE;
+            goto done;
+        }
+
+        //every shard has to come from the same run
+        if(i == 0){
+            first = header;
+            seen = calloc(header.shardCount, 1);
+        } else if(header.shardCount != first.shardCount || header.numDocs != first.numDocs
+                  || header.metrics != first.metrics){
+            fprintf(stderr, "ERROR: %s belongs to a different run\n", paths[i]);
+            status = EXIT_FAILURE;
+            goto done;
+        }
+        if(header.shardIndex >= header.shardCount || seen[header.shardIndex]){
+            fprintf(stderr, "ERROR: %s repeats shard %u\n", paths[i], header.shardIndex);
+            status = EXIT_FAILURE;
+            goto done;
+        }
+        seen[header.shardIndex] = 1;
+    }
+
+    if(count == 0 || (uint32_t) count != first.shardCount){
+        fprintf(stderr, "ERROR: expected %u shards, got %d\n", (count == 0) ? 0 : first.shardCount, count);
+        status = EXIT_FAILURE;
+        goto done;
+    }
+
+    for(int i = 0; i < count; i++){
+        int err = readShardRecord(&readers[i]);
+        if(err < 0){
+            fprintf(stderr, "ERROR: %s is truncated\n", readers[i].name);
+            status = EXIT_FAILURE;
+            goto done;
+        }
+        readers[i].live = (err == 0);
+    }
+
+    //k-way merge, the shard count is small so a linear scan is enough
+    while(1){
+        int best = -1;
+        for(int i = 0; i < count; i++){
+            if(readers[i].live && (best == -1 || compareResults(&readers[i].current, &readers[best].current) < 0)){
+                best = i;
+            }
+        }
+        if(best == -1) break;
+
+        printResult(stdout, &readers[best].current, first.metrics);
+
+        int err = readShardRecord(&readers[best]);
+        if(err < 0){
+            fprintf(stderr, "ERROR: %s is truncated\n", readers[best].name);
+            status = EXIT_FAILURE;
+            goto done;
+        }
+        readers[best].live = (err == 0);
+    }
+
+done:
+    for(int i = 0; i < count; i++){
+        if(readers[i].in != NULL) fclose(readers[i].in);
+        free(readers[i].current.filepath1);
+        free(readers[i].current.filepath2);
+    }
+    free(readers);
+    free(seen);
+    return status;
+}
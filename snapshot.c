@@ -0,0 +1,477 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define SNAPSHOT_MAGIC "JSDC"
+#define SNAPSHOT_VERSION 4
+#define SNAPSHOT_BYTE_ORDER 0x01020304
+#define SNAPSHOT_ALIGN 64
+
+//---------------------------------------------------------------------
+// Corpus snapshots: the whole repository in one mmap-able file
+//---------------------------------------------------------------------
+
+/*
+ * --save-corpus writes the sorted repository once collection is done, and
+ * --load-corpus maps it back read-only and goes straight to analysis. The
+ * file is laid out so nothing has to be parsed when it is loaded:
+ *
+ *     header        snapshot_header_t, padded to SNAPSHOT_ALIGN bytes
+ *     documents     numDocs snapshot_doc_t, in repository order
+ *     vocabulary    vocabCount uint64 file offsets, one per word ID
+ *     strings       NUL terminated paths and words
+ *     vectors       each DocVector's varint bytes, 8 byte aligned
+ *
+ * Byte-identical documents share one vector: a copy records the index of
+ * the first document with its content in same and points at its bytes.
+ *
+ * Offsets are from the start of the snapshot, which is the start of the file
+ * unless it is embedded in a checkpoint, and numbers are in host byte order;
+ * a file written on a host with another byte order or TOPK, or tokenized
+ * with other --rules or -n, is rejected. Under -n the vectors hold n-gram
+ * IDs (see ngram.c) and the vocabulary is empty.
+ */
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t topk;
+    uint32_t rules;             //the tokenRules the words were read with
+    uint32_t ngram;             //the -n the vectors were counted with, 0 (older files) for words
+    uint64_t numDocs;
+    uint64_t vocabCount;
+    uint64_t docsOffset;
+    uint64_t vocabOffset;
+    uint64_t fileSize;
+} snapshot_header_t;
+
+typedef struct {
+    uint64_t pathOffset;
+    uint64_t dataOffset;
+    uint64_t bytes;
+    int32_t length;
+    int32_t unused;
+    uint64_t total;
+    DocSummary summary;
+    int64_t same;               //index of the document whose vector this one shares, or -1
+} snapshot_doc_t;
+
+//the handles a loaded snapshot hands out, freed by destroy_repository (the
+//repository's own array of pointers to them can grow past the snapshot)
+typedef struct snapshot_t {
+    void *mapping;              //NULL when only the index was read, see loadSnapshotIndex
+    size_t size;
+    FileAndList *docs;
+    DocVector *vecs;
+    int fd;                     //without a mapping: the file, its vectors read on demand
+    uint64_t offset;            //where the snapshot starts in it
+    char *strings;              //the paths
+    size_t numDocs;
+} snapshot_t;
+
+uint64_t alignOffset(uint64_t offset, uint64_t align){
+    return (offset + align - 1) / align * align;
+}
+
+int writePadding(FILE *out, uint64_t *offset, uint64_t target){
+    static const char zeros[SNAPSHOT_ALIGN];
+    while(*offset < target){
+        size_t n = (target - *offset < SNAPSHOT_ALIGN) ? target - *offset : SNAPSHOT_ALIGN;
+        if(fwrite(zeros, 1, n, out) != n) return -1;
+        *offset += n;
+    }
+    return 0;
+}
+
+int writeBytes(FILE *out, uint64_t *offset, const void *data, size_t n){
+    if(n > 0 && fwrite(data, 1, n, out) != n) return -1;
+    *offset += n;
+    return 0;
+}
+
+/**
+ * purpose: write every document of the repository (which must hold compact
+ * vectors, read with the given rules and n-gram size) and the vocabulary to
+ * out, starting at its current position. Sets *size to the number of bytes
+ * written.
+ */
+int writeSnapshot(FILE *out, repository *repos, vocabulary_t *vocab, int rules, int ngram, uint64_t *size){
+    uint64_t numDocs = repos->nextIndex;
+    snapshot_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, 4);
+    header.version = SNAPSHOT_VERSION;
+    header.byteOrder = SNAPSHOT_BYTE_ORDER;
+    header.topk = TOPK;
+    header.rules = rules;
+    header.ngram = ngram;
+    header.numDocs = numDocs;
+    header.vocabCount = vocab->count;
+    header.docsOffset = SNAPSHOT_ALIGN;
+    header.vocabOffset = alignOffset(header.docsOffset + numDocs * sizeof(snapshot_doc_t), SNAPSHOT_ALIGN);
+
+    //lay out the strings, then the vectors
+    snapshot_doc_t *docs = calloc(numDocs + 1, sizeof(snapshot_doc_t));
+    uint64_t *words = malloc(sizeof(uint64_t) * (vocab->count + 1));
+    int *group = malloc(sizeof(int) * (numDocs + 1));
+    contentGroups(repos, group);
+    uint64_t offset = header.vocabOffset + vocab->count * sizeof(uint64_t);
+    for(uint64_t i = 0; i < numDocs; i++){
+        docs[i].pathOffset = offset;
+        offset += strlen(repos->fal[i]->filepath) + 1;
+    }
+    for(size_t i = 0; i < vocab->count; i++){
+        words[i] = offset;
+        offset += strlen(vocab->words[i]) + 1;
+    }
+    for(uint64_t i = 0; i < numDocs; i++){
+        DocVector *vec = repos->fal[i]->vec;
+        docs[i].bytes = vec->bytes;
+        docs[i].length = vec->length;
+        docs[i].unused = 0;
+        docs[i].total = vec->total;
+        docs[i].summary = repos->fal[i]->summary;
+        docs[i].same = -1;
+        if((uint64_t) group[i] != i){
+            //the first copy comes earlier, so its vector is placed already
+            docs[i].same = group[i];
+            docs[i].dataOffset = docs[group[i]].dataOffset;
+            continue;
+        }
+        offset = alignOffset(offset, 8);
+        docs[i].dataOffset = offset;
+        offset += vec->bytes;
+    }
+    header.fileSize = offset;
+
+    //write everything in the order it was laid out
+    int err = 0;
+    offset = 0;
+    err |= writeBytes(out, &offset, &header, sizeof(header));
+    err |= writePadding(out, &offset, header.docsOffset);
+    err |= writeBytes(out, &offset, docs, numDocs * sizeof(snapshot_doc_t));
+    err |= writePadding(out, &offset, header.vocabOffset);
+    err |= writeBytes(out, &offset, words, vocab->count * sizeof(uint64_t));
+    for(uint64_t i = 0; i < numDocs; i++){
+        err |= writeBytes(out, &offset, repos->fal[i]->filepath, strlen(repos->fal[i]->filepath) + 1);
+    }
+    for(size_t i = 0; i < vocab->count; i++){
+        err |= writeBytes(out, &offset, vocab->words[i], strlen(vocab->words[i]) + 1);
+    }
+    unsigned char *stored = NULL;
+    for(uint64_t i = 0; i < numDocs && !err; i++){
+        if(docs[i].same >= 0) continue;
+        err |= writePadding(out, &offset, docs[i].dataOffset);
+
+        //a vector that is not resident is copied from where it is stored
+        DocVector *vec = repos->fal[i]->vec;
+        const unsigned char *data = vec->data;
+        if(data == NULL && vec->bytes > 0){
+            stored = realloc(stored, vec->bytes);
+            err |= pread(repos->storeFd, stored, vec->bytes, vec->offset) != (ssize_t) vec->bytes;
+            data = stored;
+        }
+        err |= writeBytes(out, &offset, data, docs[i].bytes);
+    }
+    free(stored);
+    *size = offset;
+
+    free(docs);
+    free(words);
+    free(group);
+    return err;
+}
+
+/**
+ * purpose: write a snapshot of the repository to path. The file is written
+ * next to path and renamed over it, so a reader never sees half a snapshot.
+ */
+int saveSnapshot(const char *path, repository *repos, vocabulary_t *vocab, int rules, int ngram){
+    char *temp = malloc(strlen(path) + 5);
+    sprintf(temp, "%s.tmp", path);
+    FILE *out = fopen(temp, "wb");
+    if(out == NULL){
+        perror(temp);
+        free(temp);
+        return -1;
+    }
+
+    uint64_t size;
+    int err = writeSnapshot(out, repos, vocab, rules, ngram, &size);
+    if(fclose(out)) err = -1;
+    if(!err && rename(temp, path)) err = -1;
+    if(err){
+        perror(path);
+        unlink(temp);
+    }
+
+    free(temp);
+    return err ? -1 : 0;
+}
+
+/**
+ * purpose: map the snapshot that starts offset bytes into path (a multiple
+ * of the page size) read-only and fill an empty repository with documents
+ * that point straight into the mapping. The snapshot must have been read
+ * with the given rules and n-gram size.
+ */
+int loadSnapshotAt(const char *path, uint64_t offset, repository *repos, int rules, int ngram){
+    int fd = open(path, O_RDONLY);
+    if(fd == -1){
+        perror(path);
+        return -1;
+    }
+
+    struct stat st;
+    snapshot_header_t peek;
+    if(fstat(fd, &st) || pread(fd, &peek, sizeof(peek), offset) != (ssize_t) sizeof(peek)
+       || peek.fileSize < sizeof(peek) || offset + peek.fileSize > (uint64_t) st.st_size){
+        fprintf(stderr, "ERROR: %s is not a corpus snapshot\n", path);
+        close(fd);
+        return -1;
+    }
+
+    void *mapping = mmap(NULL, peek.fileSize, PROT_READ, MAP_PRIVATE, fd, offset);
+    close(fd);
+    if(mapping == MAP_FAILED){
+        perror(path);
+        return -1;
+    }
+
+    const char *base = mapping;
+    const snapshot_header_t *header = mapping;
+    if(memcmp(header->magic, SNAPSHOT_MAGIC, 4) != 0 || header->version != SNAPSHOT_VERSION
+       || header->byteOrder != SNAPSHOT_BYTE_ORDER || header->topk != TOPK
+       || header->docsOffset + header->numDocs * sizeof(snapshot_doc_t) > header->fileSize){
+        fprintf(stderr, "ERROR: %s is not a compatible corpus snapshot\n", path);
+        munmap(mapping, peek.fileSize);
+        return -1;
+    }
+    if(header->rules != (uint32_t) rules){
+        fprintf(stderr, "ERROR: %s was tokenized with --rules %s\n", path,
+                header->rules < NUM_RULES ? tokenRuleNames[header->rules] : "?");
+        munmap(mapping, peek.fileSize);
+        return -1;
+    }
+    if((header->ngram ? header->ngram : 1) != (uint32_t) ngram){
+        fprintf(stderr, "ERROR: %s was counted with -n%u\n", path, header->ngram ? header->ngram : 1);
+        munmap(mapping, peek.fileSize);
+        return -1;
+    }
+
+    //hand out one block of handles instead of a malloc per document
+    size_t numDocs = header->numDocs;
+    const snapshot_doc_t *docs = (const snapshot_doc_t *) (base + header->docsOffset);
+    snapshot_t *snap = calloc(1, sizeof(snapshot_t));
+    snap->mapping = mapping;
+    snap->size = peek.fileSize;
+    snap->fd = -1;
+    snap->docs = malloc(sizeof(FileAndList) * (numDocs + 1));
+    snap->vecs = malloc(sizeof(DocVector) * (numDocs + 1));
+    FileAndList **index = malloc(sizeof(FileAndList *) * (numDocs + 1));
+
+    for(size_t i = 0; i < numDocs; i++){
+        if(docs[i].pathOffset >= header->fileSize || docs[i].dataOffset + docs[i].bytes > header->fileSize
+           || docs[i].same >= (int64_t) i){
+            fprintf(stderr, "ERROR: %s is corrupt\n", path);
+            free(snap->docs);
+            free(snap->vecs);
+            free(snap);
+            free(index);
+            munmap(mapping, peek.fileSize);
+            return -1;
+        }
+        snap->vecs[i].length = docs[i].length;
+        snap->vecs[i].total = docs[i].total;
+        snap->vecs[i].bytes = docs[i].bytes;
+        snap->vecs[i].data = (unsigned char *) (base + docs[i].dataOffset);
+        snap->vecs[i].offset = -1;
+        snap->docs[i].filepath = (char *) (base + docs[i].pathOffset);
+        snap->docs[i].list = NULL;
+        snap->docs[i].vec = &snap->vecs[i];
+        snap->docs[i].summary = docs[i].summary;
+        snap->docs[i].same = (docs[i].same >= 0) ? &snap->docs[docs[i].same] : NULL;
+        index[i] = &snap->docs[i];
+    }
+
+    free(repos->fal);
+    repos->fal = index;
+    repos->size = numDocs + 1;
+    repos->nextIndex = numDocs;
+    repos->snapshot = snap;
+    repos->mappedDocs = numDocs;
+    return 0;
+}
+
+int loadSnapshot(const char *path, repository *repos, int rules, int ngram){
+    return loadSnapshotAt(path, 0, repos, rules, ngram);
+}
+
+/**
+ * purpose: intern a loaded snapshot's words into an empty vocabulary, so
+ * new text can be looked up against the corpus. The words keep their IDs.
+ */
+int loadSnapshotVocabulary(repository *repos, vocabulary_t *vocab){
+    snapshot_t *snap = repos->snapshot;
+    const char *base = snap->mapping;
+    const snapshot_header_t *header = snap->mapping;
+    const uint64_t *words = (const uint64_t *) (base + header->vocabOffset);
+
+    pthread_mutex_lock(&vocab->lock);
+    for(uint64_t i = 0; i < header->vocabCount; i++){
+        if(words[i] >= header->fileSize || intern_word(vocab, base + words[i]) != i){
+            pthread_mutex_unlock(&vocab->lock);
+            fprintf(stderr, "ERROR: corpus snapshot vocabulary is corrupt\n");
+            return -1;
+        }
+    }
+    pthread_mutex_unlock(&vocab->lock);
+    return 0;
+}
+
+/**
+ * purpose: like loadSnapshotAt, but read only the paths, summaries and
+ * where each vector is. The vectors' data stays NULL until a vector cache
+ * (vcache.c) reads it, so a corpus larger than memory can be analysed.
+ */
+int loadSnapshotIndex(const char *path, uint64_t offset, repository *repos, int rules, int ngram){
+    int fd = open(path, O_RDONLY);
+    if(fd == -1){
+        perror(path);
+        return -1;
+    }
+
+    struct stat st;
+    snapshot_header_t header;
+    if(fstat(fd, &st) || pread(fd, &header, sizeof(header), offset) != (ssize_t) sizeof(header)
+       || header.fileSize < sizeof(header) || offset + header.fileSize > (uint64_t) st.st_size || memcmp(header.magic, SNAPSHOT_MAGIC, 4) != 0
+       || header.version != SNAPSHOT_VERSION || header.byteOrder != SNAPSHOT_BYTE_ORDER || header.topk != TOPK
+       || header.docsOffset + header.numDocs * sizeof(snapshot_doc_t) > header.fileSize){
+        fprintf(stderr, "ERROR: %s is not a compatible corpus snapshot\n", path);
+        close(fd);
+        return -1;
+    }
+    if(header.rules != (uint32_t) rules){
+        fprintf(stderr, "ERROR: %s was tokenized with --rules %s\n", path,
+                header.rules < NUM_RULES ? tokenRuleNames[header.rules] : "?");
+        close(fd);
+        return -1;
+    }
+    if((header.ngram ? header.ngram : 1) != (uint32_t) ngram){
+        fprintf(stderr, "ERROR: %s was counted with -n%u\n", path, header.ngram ? header.ngram : 1);
+        close(fd);
+        return -1;
+    }
+
+    size_t numDocs = header.numDocs;
+    snapshot_doc_t *docs = malloc(sizeof(snapshot_doc_t) * (numDocs + 1));
+    snapshot_t *snap = calloc(1, sizeof(snapshot_t));
+    snap->size = header.fileSize;
+    snap->fd = fd;
+    snap->offset = offset;
+    snap->docs = malloc(sizeof(FileAndList) * (numDocs + 1));
+    snap->vecs = malloc(sizeof(DocVector) * (numDocs + 1));
+
+    //the paths are written one after the other, ahead of the words
+    uint64_t first = 0, last = 0;
+    uint64_t vocabEnd = header.vocabOffset + header.vocabCount * sizeof(uint64_t);
+    size_t docBytes = numDocs * sizeof(snapshot_doc_t);
+    int err = (docBytes > 0 && pread(fd, docs, docBytes, offset + header.docsOffset) != (ssize_t) docBytes);
+    if(!err && numDocs > 0){
+        first = docs[0].pathOffset;
+        last = header.fileSize;
+        if(header.vocabCount > 0){
+            err = (pread(fd, &last, sizeof(last), offset + header.vocabOffset) != (ssize_t) sizeof(last));
+        } else {
+            for(size_t i = 0; i < numDocs; i++){
+                if(docs[i].dataOffset < last) last = docs[i].dataOffset;
+            }
+        }
+        err = err || first < vocabEnd || last < first || last > header.fileSize;
+    }
+    if(err) first = last = 0;
+    snap->strings = malloc(last - first + 1);
+    if(!err && last > first){
+        err = (pread(fd, snap->strings, last - first, offset + first) != (ssize_t) (last - first));
+    }
+    snap->strings[last - first] = '\0';
+
+    FileAndList **index = malloc(sizeof(FileAndList *) * (numDocs + 1));
+    for(size_t i = 0; i < numDocs && !err; i++){
+        if(docs[i].pathOffset < first || docs[i].pathOffset >= last || docs[i].dataOffset + docs[i].bytes > header.fileSize
+           || docs[i].same >= (int64_t) i){
+            err = 1;
+            break;
+        }
+        snap->vecs[i].length = docs[i].length;
+        snap->vecs[i].total = docs[i].total;
+        snap->vecs[i].bytes = docs[i].bytes;
+        snap->vecs[i].data = NULL;
+        snap->vecs[i].offset = offset + docs[i].dataOffset;
+        snap->docs[i].filepath = snap->strings + (docs[i].pathOffset - first);
+        snap->docs[i].list = NULL;
+        snap->docs[i].vec = &snap->vecs[i];
+        snap->docs[i].summary = docs[i].summary;
+        snap->docs[i].same = (docs[i].same >= 0) ? &snap->docs[docs[i].same] : NULL;
+        index[i] = &snap->docs[i];
+    }
+    free(docs);
+
+    if(err){
+        fprintf(stderr, "ERROR: %s is corrupt\n", path);
+        free(index);
+        close_snapshot(snap);
+        return -1;
+    }
+
+    snap->numDocs = numDocs;
+    free(repos->fal);
+    repos->fal = index;
+    repos->size = numDocs + 1;
+    repos->nextIndex = numDocs;
+    repos->snapshot = snap;
+    repos->mappedDocs = numDocs;
+    repos->storeFd = fd;
+    return 0;
+}
+
+/**
+ * purpose: write the whole snapshot, mapped or not, to out.
+ */
+int copySnapshot(snapshot_t *snap, FILE *out){
+    if(snap->mapping != NULL){
+        return (snap->size > 0 && fwrite(snap->mapping, 1, snap->size, out) != snap->size) ? -1 : 0;
+    }
+    char *buf = malloc(1 << 20);
+    int err = 0;
+    for(uint64_t done = 0; done < snap->size && !err; ){
+        size_t n = (snap->size - done < (1 << 20)) ? snap->size - done : (1 << 20);
+        err = pread(snap->fd, buf, n, snap->offset + done) != (ssize_t) n || fwrite(buf, 1, n, out) != n;
+        done += n;
+    }
+    free(buf);
+    return err ? -1 : 0;
+}
+
+void close_snapshot(snapshot_t *snap){
+    if(snap == NULL) return;
+    if(snap->mapping != NULL){
+        munmap(snap->mapping, snap->size);
+    } else {
+        //whatever a vector cache read in is still ours
+        for(size_t i = 0; i < snap->numDocs; i++){
+            free(snap->vecs[i].data);
+        }
+        if(snap->fd != -1) close(snap->fd);
+    }
+    free(snap->docs);
+    free(snap->vecs);
+    free(snap->strings);
+    free(snap);
+}
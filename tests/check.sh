@@ -0,0 +1,285 @@
+#!/bin/sh
+# make check: run compare on the corpus of gencorpus.py and hold every line it
+# prints against jsdref.py, an exact reference keyed by the words themselves
+# (or by the word sequences themselves for -n).
+# compare-chunks is compare built with 4 KB chunks, so nearly every file goes
+# through the chunked tables and their range boundaries, and with tiles of 4
+# documents, so a run has enough tiles to be stopped between them.
+
+tests=$(dirname "$0")
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+python3 "$tests/gencorpus.py" "$work/corpus" || exit 1
+corpus=$(ls "$work"/corpus/*.txt)
+small=$(find "$work/corpus" -name '*.txt' -size -20k | sort)
+status=0
+
+# check NAME [-n N] [--metrics] -- COMMAND...: COMMAND's output against the
+# reference for the files it was given (the small ones if it was given
+# --files-from)
+check(){
+    name=$1
+    shift
+    ref=""
+    while [ "$1" != "--" ]; do ref="$ref $1"; shift; done
+    shift
+    files=$corpus
+    case "$*" in *--files-from*) files=$small ;; esac
+    if ! "$@" > "$work/out" 2> "$work/err"; then
+        echo "FAIL $name: exit status"
+        cat "$work/err"
+        status=1
+    elif python3 "$tests/jsdref.py" $ref $files < "$work/out" > "$work/result"; then
+        echo "ok   $name: $(tail -n 1 "$work/result")"
+    else
+        echo "FAIL $name:"
+        cat "$work/result"
+        status=1
+    fi
+}
+
+# pass NAME or fail NAME DETAIL: report a check that is not a jsdref.py comparison
+pass(){
+    echo "ok   $1"
+}
+fail(){
+    echo "FAIL $1: $2"
+    status=1
+}
+
+# stopped NAME PID: whether PID exits within 10 s of a SIGTERM (a background
+# job of a script ignores SIGINT), leaving its exit status in $code
+stopped(){
+    kill -TERM "$2"
+    for i in $(seq 20); do
+        kill -0 "$2" 2> /dev/null || break
+        sleep 0.5
+    done
+    if kill -0 "$2" 2> /dev/null; then
+        kill -KILL "$2"
+        wait "$2"
+        fail "$1" "still running 10 s after SIGTERM"
+        return 1
+    fi
+    wait "$2"
+    code=$?
+}
+
+# agrees NAME EXPECTED -- COMMAND...: whether COMMAND exits 0 and prints the
+# lines of EXPECTED in some order (failing NAME if not), leaving its stderr in
+# $work/err
+agrees(){
+    name=$1
+    expected=$2
+    shift 3
+    "$@" > "$work/out" 2> "$work/err"
+    code=$?
+    if [ $code -ne 0 ]; then
+        fail "$name" "exit status $code: $(head -c 300 "$work/err")"
+        return 1
+    fi
+    if ! sort "$work/out" | cmp -s - "$expected"; then
+        fail "$name" "$(sort "$work/out" | diff - "$expected" | head -n 5)"
+        return 1
+    fi
+}
+
+printf '%s\n' $small > "$work/small.list"
+./compare -q "$work/corpus" > "$work/single"
+sort "$work/single" > "$work/plain"
+
+# the list path is quadratic in the vocabulary, so it only gets the small files
+check "lists" -- ./compare --files-from "$work/small.list"
+check "compact vectors" -- ./compare -q "$work/corpus"
+check "chunked lists" -- tests/compare-chunks --files-from "$work/small.list" -f4
+check "chunked compact vectors" -- tests/compare-chunks -q -f4 "$work/corpus"
+
+# n-grams are hashed to 64 bits; the reference keys them by the words, so a
+# collision or a sequence lost across a chunk boundary shows up as a difference
+for n in 2 3 5; do
+    check "$n-grams" -n $n -- ./compare -q -n$n "$work/corpus"
+    check "chunked $n-grams" -n $n -- tests/compare-chunks -q -n$n -f4 "$work/corpus"
+done
+
+# every column of --metrics all, from the one merge walk over each pair
+check "list metrics" --metrics -- ./compare --files-from "$work/small.list" --metrics all
+check "metrics" --metrics -- ./compare -q --metrics all "$work/corpus"
+check "chunked 2-gram metrics" -n 2 --metrics -- tests/compare-chunks -q -n2 -f4 --metrics all "$work/corpus"
+
+# a budget smaller than the largest file reads it alone and throttles the
+# rest, and must not change a single line
+agrees "1 MB memory budget" "$work/plain" -- ./compare -q -f4 --max-memory 1 "$work/corpus" \
+    && pass "1 MB memory budget: $(grep -o '[0-9]* read alone' "$work/err")"
+
+# -t prints the lines of an unpruned run at or under the threshold, although
+# the summary bounds skip about half of the pairs
+awk '$1 <= 0.3' "$work/plain" > "$work/under"
+if agrees "pruning -t0.3" "$work/under" -- ./compare -q -t0.3 --verbose "$work/corpus"; then
+    if grep -q "pruned [1-9]" "$work/err"; then
+        pass "pruning -t0.3: $(grep -o 'pruned [0-9]* of [0-9]* pairs' "$work/err")"
+    else
+        fail "pruning -t0.3" "nothing pruned: $(cat "$work/err")"
+    fi
+fi
+
+# three shards merged print exactly what one process prints, in its order
+for i in 0 1 2; do
+    ./compare -q --shard $i/3 "$work/corpus" > "$work/part$i" || fail "3 shards merged" "shard $i failed"
+done
+if ./compare merge "$work/part0" "$work/part1" "$work/part2" > "$work/out" && cmp -s "$work/out" "$work/single"; then
+    pass "3 shards merged"
+else
+    fail "3 shards merged" "$(diff "$work/out" "$work/single" | head -n 5)"
+fi
+
+# a saved corpus loads back to the same lines, in the same order
+if ! ./compare -q --save-corpus "$work/snapshot" "$work/corpus" 2> "$work/err"; then
+    fail "corpus snapshot" "$(cat "$work/err")"
+elif ./compare --load-corpus "$work/snapshot" > "$work/out" && cmp -s "$work/out" "$work/single"; then
+    pass "corpus snapshot"
+else
+    fail "corpus snapshot" "$(diff "$work/out" "$work/single" | head -n 5)"
+fi
+
+# a corpus file as a --query with a k past the corpus size gets its own row
+# of the all-pairs results, and itself at 0, from the index and the vptree;
+# --radius keeps the part of it within the radius
+query="$work/corpus/near.txt"
+{ echo "0.000000 $query"; awk -v q="$query" '$2 == q { print $1, $3 } $3 == q { print $1, $2 }' "$work/single"; } \
+    | awk -v q="$query" '{ printf "%s     %s     %s\n", $1, q, $2 }' | sort > "$work/row"
+agrees "query against the all-pairs row" "$work/row" -- ./compare -q --query "$query" -k30 "$work/corpus" \
+    && pass "query against the all-pairs row"
+agrees "vptree query against the all-pairs row" "$work/row" -- ./compare -q --vptree --query "$query" -k30 "$work/corpus" \
+    && pass "vptree query against the all-pairs row"
+awk '$1 <= 0.33' "$work/row" > "$work/within"
+agrees "vptree --radius 0.33" "$work/within" -- ./compare -q --vptree --query "$query" --radius 0.33 "$work/corpus" \
+    && pass "vptree --radius 0.33: $(wc -l < "$work/within") files"
+
+# a --serve round trip: the query row over the socket, then a pair, an add
+# and a remove, and the server stops cleanly on SIGTERM
+./compare -q --serve "$work/socket" "$work/corpus" 2> "$work/serve.err" &
+pid=$!
+while [ ! -S "$work/socket" ] && kill -0 $pid 2> /dev/null; do sleep 0.2; done
+agrees "serve round trip" "$work/row" -- python3 "$tests/serveclient.py" "$work/socket" "$query"
+served=$?
+if stopped "serve round trip" $pid && [ $served -eq 0 ]; then
+    if [ $code -ne 0 ]; then
+        fail "serve round trip" "exit status $code after SIGTERM: $(cat "$work/serve.err")"
+    else
+        pass "serve round trip"
+    fi
+fi
+
+# copy.txt shares the words of the file it copies and changes no line, and
+# a run stopped before any tile finishes prints no pair of the two either
+if agrees "--no-dedup" "$work/plain" -- ./compare -q --no-dedup "$work/corpus"; then
+    ./compare -q --verbose "$work/corpus" > /dev/null 2> "$work/err"
+    if grep -q "^1 identical files share" "$work/err"; then
+        pass "--no-dedup and dedup agree"
+    else
+        fail "--no-dedup and dedup agree" "copy.txt not shared: $(cat "$work/err")"
+    fi
+fi
+./compare -q -a1 --time-budget 0.001 "$work/corpus" > "$work/out" 2> "$work/err"
+code=$?
+if [ $code -ne 2 ] || [ -s "$work/out" ]; then
+    fail "dedup of a stopped run" "exit status $code, $(wc -l < "$work/out") lines"
+else
+    pass "dedup of a stopped run"
+fi
+
+# a checkpointed run stopped by a time budget, continued with --resume under
+# ever larger budgets, ends with the lines of an uninterrupted run in order
+tests/compare-chunks -q -a1 --checkpoint "$work/ck" --time-budget 0.01 "$work/corpus" > /dev/null 2>&1
+code=$?
+steps=1
+partial=0
+for budget in $(seq 0.01 0.01 2); do
+    [ $code -eq 2 ] || break
+    tests/compare-chunks -q -a1 --resume "$work/ck" --checkpoint "$work/ck" --time-budget $budget \
+        > "$work/out" 2> "$work/err"
+    code=$?
+    steps=$((steps + 1))
+    grep -q "stopped: [1-9]" "$work/err" && partial=$((partial + 1))
+done
+if [ $code -ne 0 ]; then
+    fail "checkpoint and resume" "exit status $code after $steps steps: $(cat "$work/err")"
+elif ! cmp -s "$work/out" "$work/single"; then
+    fail "checkpoint and resume" "$(diff "$work/out" "$work/single" | head -n 5)"
+elif [ -e "$work/ck" ]; then
+    fail "checkpoint and resume" "the checkpoint of a finished run is left behind"
+else
+    pass "checkpoint and resume: $steps steps, $partial stopped between tiles"
+fi
+
+# --against pairs the s files with the others, the cross lines of the run
+# over all of them, with the s file first
+set --
+for f in $corpus; do
+    case "$f" in */s[0-9]*.txt) ;; *) set -- "$@" --against "$f" ;; esac
+done
+awk '{ one = ($2 ~ /\/s[0-9]+\.txt$/); two = ($3 ~ /\/s[0-9]+\.txt$/) }
+     one && !two { print } two && !one { printf "%s     %s     %s\n", $1, $3, $2 }' "$work/single" | sort > "$work/cross"
+agrees "--against" "$work/cross" -- ./compare -q "$work"/corpus/s[0-9]*.txt "$@" \
+    && pass "--against: $(wc -l < "$work/cross") cross pairs"
+
+# libjsd.a exports its API only, and every engine keeps its own settings
+exported=$(nm -g --defined-only libjsd.a | awk 'NF == 3 && $3 !~ /^jsd_/ { print $3 }')
+if [ -n "$exported" ]; then
+    fail "libjsd.a exports" "$(echo $exported | head -c 200)"
+elif ! tests/enginehost > "$work/out" 2>&1; then
+    fail "engine settings" "$(cat "$work/out")"
+elif ! printf '%s\n' "engine 0: 0.000000, 2 matches, 1 pairs" \
+        "engine 1: 0.652138, 2 matches, 1 pairs" "engine 2: 1.000000, -1 matches, 1 pairs" "unknown rules: refused" | cmp -s - "$work/out"; then
+    fail "engine settings" "$(cat "$work/out")"
+else
+    pass "libjsd.a exports only jsd_*, engines keep their settings"
+fi
+
+# --watch republishes what a fresh run prints once two documents grow, and
+# recomputes the pair of the two once: 23 + 23 - 1 pairs of 24 documents
+cp -r "$work/corpus" "$work/grown"
+./compare -q --watch "$work/watched" "$work/grown" 2> "$work/err" &
+pid=$!
+while [ ! -e "$work/watched" ] && kill -0 $pid 2> /dev/null; do sleep 0.2; done
+echo " words appended to the end" >> "$work/grown/s03.txt"
+echo " more words" >> "$work/grown/t02.txt"
+for i in $(seq 100); do
+    grep -q recomputed "$work/err" && break
+    sleep 0.2
+done
+if stopped "watch republishes" $pid; then
+    ./compare -q "$work/grown" | sort > "$work/fresh"
+    if ! grep -q ", 45 pairs recomputed" "$work/err"; then
+        fail "watch republishes" "$(tail -n 1 "$work/err")"
+    elif ! sort "$work/watched" | cmp -s - "$work/fresh"; then
+        fail "watch republishes" "results differ from a fresh run"
+    else
+        pass "watch republishes"
+    fi
+fi
+rm -f "$work/watched"
+
+# many small documents, so the first pass of --watch takes long enough to be
+# stopped in the middle
+mkdir "$work/many"
+python3 - "$work/many" $corpus <<'PY'
+import sys
+words = b' '.join(open(f, 'rb').read() for f in sys.argv[2:]).split()
+for i in range(600):
+    with open('%s/m%03d.txt' % (sys.argv[1], i), 'wb') as f:
+        f.write(b' '.join(words[i * 97:i * 97 + 3000]))
+PY
+
+./compare -q -a1 --watch "$work/watched" "$work/many" 2> "$work/err" &
+pid=$!
+sleep 4
+if stopped "watch stopped in its first pass" $pid; then
+    if [ $code -ne 0 ] || [ -e "$work/watched" ]; then
+        fail "watch stopped in its first pass" "exit status $code, results published: $(ls "$work" | grep -c watched)"
+    else
+        pass "watch stopped in its first pass"
+    fi
+fi
+
+exit $status
@@ -0,0 +1,60 @@
+#include <stdio.h>
+#include <string.h>
+#include "../jsd.h"
+
+//---------------------------------------------------------------------
+// A host program of libjsd.a (make check)
+//---------------------------------------------------------------------
+
+/*
+ * Defines some of the names the engine uses inside, which must not clash
+ * with the archive, and runs three engines with different settings side by
+ * side: the same two texts have the same words under the default rules,
+ * not under alnum (which splits "don't"), and share no 2-grams. A third
+ * document is removed again, so its pairs must not be counted.
+ */
+
+int tokenRules = 7;
+int ngramSize = 7;
+
+void insert(void){
+}
+
+int tokenize(int x){
+    return x;
+}
+
+static void countPair(const jsd_pair *pair, void *ctx){
+    (void) pair;
+    (void) ctx;
+}
+
+int main(void){
+    const char *a = "don't stop now";
+    const char *b = "now stop dont";
+
+    jsd_options alnum = { "alnum", 1 };
+    jsd_options bigrams = { NULL, 2 };
+    jsd_engine *engines[3] = { jsd_engine_create(2), jsd_engine_create_with(2, &alnum),
+                               jsd_engine_create_with(2, &bigrams) };
+    for(int e = 0; e < 3; e++){
+        if(engines[e] == NULL){
+            printf("engine %d: not created\n", e);
+            return 1;
+        }
+        int id1 = jsd_engine_add_buffer(engines[e], "a", a, strlen(a));
+        int id2 = jsd_engine_add_buffer(engines[e], "b", b, strlen(b));
+        int id3 = jsd_engine_add_buffer(engines[e], "c", a, strlen(a));
+        jsd_engine_remove(engines[e], id3);
+        jsd_match best[2];
+        printf("engine %d: %.6f, %d matches, %ld pairs\n", e, jsd_engine_pair(engines[e], id1, id2),
+               jsd_engine_query(engines[e], a, strlen(a), best, 2), jsd_engine_all_pairs(engines[e], countPair, NULL));
+    }
+    for(int e = 0; e < 3; e++){
+        jsd_engine_destroy(engines[e]);
+    }
+
+    jsd_options bad = { "klingon", 1 };
+    printf("unknown rules: %s\n", jsd_engine_create_with(1, &bad) == NULL ? "refused" : "created");
+    return tokenRules + ngramSize + tokenize(0) - 14;
+}
@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+"""Simulates the largest-first file queue of compare (boundedQ.c) to choose
+when its gate opens: the directory walk puts one path every --walk seconds
+(plus one --stall pause after --stall-at paths, as a slow network directory
+would), -f file threads read --rate bytes a second, and nothing is handed out
+until the gate holds N paths, the walk is over, or, with a stall timeout, no
+path has come for that long. Prints, per gate, when the first file is taken
+and when the last one is done, against an ideal of total bytes / threads.
+A file over the chunk size is shared the way chunk.c shares it.
+
+usage: gatesim.py [DIR] [-f THREADS] [--files N] [--seed S] ...
+Without DIR the sizes are a seeded log-normal draw plus three huge files, two
+found early and one last, the cases the largest-first order exists for.
+"""
+import argparse
+import heapq
+import math
+import os
+import random
+
+CAPACITY = 4096                 # BQHEAPSIZE
+CHUNK = 1 << 26                 # CHUNKBYTES
+
+
+def synthetic(count, seed):
+    rng = random.Random(seed)
+    sizes = [int(rng.lognormvariate(9, 1.5)) + 1 for _ in range(count)]
+    total = sum(sizes)
+    # huge files, past the chunk size: two among the first few thousand found, one last
+    for at in (1000, 3000, count + 2):
+        sizes.insert(min(at, len(sizes)), total // 3)
+    return sizes
+
+
+def walked(top):
+    sizes = []
+    for root, dirs, files in os.walk(top):
+        for name in files:
+            sizes.append(os.path.getsize(os.path.join(root, name)))
+    return sizes
+
+
+def simulate(sizes, args, gate, stallTimeout):
+    inf = float('inf')
+    free = [0.0] * args.threads
+    heap = []
+    queued = 0
+    gated = True
+    putAt = 0.0                 # when the walker puts its next path
+    lastPut = 0.0
+    firstTake = None
+    i = 0
+    while i < len(sizes) or heap:
+        put = putAt if i < len(sizes) and len(heap) < CAPACITY else inf
+        take = max(min(free), lastPut) if heap and not gated else inf
+        stall = lastPut + stallTimeout if heap and gated else inf
+        now = min(put, take, stall)
+        if now == put:
+            heapq.heappush(heap, -sizes[i])
+            queued += sizes[i]
+            i += 1
+            lastPut = now
+            putAt = now + args.walk + (args.stall if i == args.stall_at else 0)
+            if len(heap) >= gate or i == len(sizes):
+                gated = False
+        elif now == take:
+            size = -heapq.heappop(heap)
+            queued -= size
+            # a file over the chunk size is split between its share of the
+            # threads, counting the bytes still queued, and only idle ones help
+            share = math.ceil(args.threads * size / (queued + size)) if size > CHUNK else 1
+            idle = sorted(range(args.threads), key=lambda w: free[w])
+            helpers = [w for w in idle[1:share] if free[w] <= now]
+            done = now + size / args.rate / (1 + len(helpers))
+            for w in [idle[0]] + helpers:
+                free[w] = done
+            if firstTake is None:
+                firstTake = now
+            if i < len(sizes):
+                putAt = max(putAt, now)   # a walker blocked on a full queue
+        else:
+            gated = False
+    return firstTake, max(free)
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('dir', nargs='?')
+    parser.add_argument('-f', '--threads', type=int, default=8)
+    parser.add_argument('--files', type=int, default=20000)
+    parser.add_argument('--seed', type=int, default=1)
+    parser.add_argument('--walk', type=float, default=5e-6, help='seconds per path found')
+    parser.add_argument('--rate', type=float, default=50e6, help='bytes a thread reads a second')
+    parser.add_argument('--stall-at', type=int, default=300)
+    parser.add_argument('--stall', type=float, default=2.0)
+    args = parser.parse_args()
+
+    sizes = walked(args.dir) if args.dir else synthetic(args.files, args.seed)
+    ideal = sum(sizes) / args.rate / args.threads
+    print('%d files, %.1f MB, ideal %.3f s' % (len(sizes), sum(sizes) / 1e6, ideal))
+    print('%-6s %-8s %10s %10s %8s' % ('gate', 'timeout', 'first', 'done', 'x ideal'))
+    for gate in (1, 64, 256, 1024, CAPACITY):
+        for timeout in (math.inf, 0.02):
+            first, done = simulate(sizes, args, gate, timeout)
+            print('%-6d %-8s %10.3f %10.3f %8.2f' % (gate, 'none' if timeout == math.inf else '%g s' % timeout,
+                                                     first, done, done / ideal))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+"""Write the corpus make check runs compare on: a fixed, seeded mix of sizes
+from empty to a few hundred KB, Zipf-distributed words with case, digits,
+hyphens and punctuation attached, a long tail of one-off words (so the word
+ID gaps and frequencies of the compact vectors need several varint bytes),
+CRLF and tab separated files, an exact copy and a near copy.
+
+usage: gencorpus.py DIR [SEED]
+"""
+import os
+import random
+import sys
+
+LETTERS = 'abcdefghijklmnopqrstuvwxyz'
+
+
+def vocabulary(rng, size):
+    words = set()
+    while len(words) < size:
+        word = ''.join(rng.choice(LETTERS) for _ in range(rng.randint(1, 9)))
+        if rng.random() < 0.05:
+            word += str(rng.randint(0, 99))
+        if rng.random() < 0.03:
+            word += '-' + rng.choice(LETTERS) * 2
+        words.add(word)
+    return sorted(words)
+
+
+def text(rng, vocab, weights, count, separators=(' ',)):
+    out = []
+    for word in rng.choices(vocab, weights, k=count):
+        if rng.random() < 0.01:
+            word = ''.join(rng.choice(LETTERS) for _ in range(12))     # a one-off word
+        if rng.random() < 0.1:
+            word = word.capitalize() if rng.random() < 0.5 else word.upper()
+        if rng.random() < 0.08:
+            word += rng.choice(',.;:!?)"\'')
+        if rng.random() < 0.02:
+            word = '(' + word
+        out.append(word)
+        out.append(rng.choice(separators))
+    return ''.join(out)
+
+
+def main():
+    directory = sys.argv[1]
+    rng = random.Random(int(sys.argv[2]) if len(sys.argv) > 2 else 1)
+    os.makedirs(directory, exist_ok=True)
+
+    vocab = vocabulary(rng, 4000)
+    weights = [1.0 / (rank + 1) for rank in range(len(vocab))]
+    sizes = [0, 1, 2, 3, 7, 40, 150, 600, 2500, 9000, 30000, 60000, 90000]
+    files = {}
+    for i, size in enumerate(sizes):
+        files['s%02d.txt' % i] = text(rng, vocab, weights, size)
+    for i in range(6):
+        # a topic of its own: the same vocabulary ranked differently
+        shuffled = weights[:]
+        rng.shuffle(shuffled)
+        files['t%02d.txt' % i] = text(rng, vocab, shuffled, rng.randint(500, 20000))
+    files['crlf.txt'] = text(rng, vocab, weights, 5000, (' ', ' ', '\r\n'))
+    files['tabs.txt'] = text(rng, vocab, weights, 5000, ('\t', '  ', '\n\n'))
+    files['punct.txt'] = '... ,,, !!! -- ?? ;;\n'
+    files['copy.txt'] = files['s09.txt']
+    files['near.txt'] = files['s09.txt'] + ' tail'
+
+    for name, body in files.items():
+        with open(os.path.join(directory, name), 'w', newline='') as f:
+            f.write(body)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+"""Exact reference for compare's JSD lines: every document is a Counter keyed
+by its words (or by tuples of -n consecutive words, never hashed), tokenized
+by the default rules of token.c, and the JSD of every pair is summed in
+double precision. The compare output on stdin must hold every pair of the
+given files exactly once, each within the tolerance of the reference. With
+--metrics the lines are those of compare --metrics all, and the cosine,
+Hellinger distance, Jaccard index and shared count are checked as well.
+
+usage: jsdref.py [-n N] [--metrics] [--tolerance T] FILE... < compare-output
+"""
+import argparse
+import math
+import sys
+from collections import Counter
+
+KEEP = frozenset(b'abcdefghijklmnopqrstuvwxyz0123456789-')
+
+
+def words(path):
+    out = []
+    with open(path, 'rb') as f:
+        for raw in f.read().split():            # ASCII white space separates
+            word = bytes(c for c in raw.lower() if c in KEEP)
+            if word:
+                out.append(word)
+    return out
+
+
+def distribution(path, n):
+    seq = words(path)
+    counts = Counter(tuple(seq[i:i + n]) for i in range(len(seq) - n + 1))
+    total = sum(counts.values())
+    return {key: count / total for key, count in counts.items()}
+
+
+def jsd(p, q):
+    if not p or not q:
+        return 0.0 if not p and not q else math.sqrt(0.5)
+    divergence = 0.0
+    for key in p.keys() | q.keys():
+        a, b = p.get(key, 0.0), q.get(key, 0.0)
+        mean = (a + b) / 2
+        if a:
+            divergence += 0.5 * a * math.log2(a / mean)
+        if b:
+            divergence += 0.5 * b * math.log2(b / mean)
+    return math.sqrt(max(divergence, 0.0))
+
+
+def metrics(p, q):
+    """JSD, cosine, Hellinger, Jaccard and shared count of two distributions."""
+    if not p or not q:
+        same = not p and not q
+        return [jsd(p, q), float(same), 0.0 if same else 1.0, float(same), 0]
+    shared = p.keys() & q.keys()
+    dot = sum(p[key] * q[key] for key in shared)
+    norms = math.sqrt(sum(a * a for a in p.values()) * sum(b * b for b in q.values()))
+    overlap = sum(math.sqrt(p[key] * q[key]) for key in shared)
+    return [jsd(p, q), dot / norms, math.sqrt(max(1 - overlap, 0.0)),
+            len(shared) / len(p.keys() | q.keys()), len(shared)]
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('-n', type=int, default=1)
+    parser.add_argument('--metrics', action='store_true')
+    parser.add_argument('--tolerance', type=float, default=1.5e-6)
+    parser.add_argument('files', nargs='+')
+    args = parser.parse_args()
+
+    dists = {path: distribution(path, args.n) for path in args.files}
+    expected = {}
+    paths = sorted(dists)
+    for i, one in enumerate(paths):
+        for two in paths[i + 1:]:
+            if args.metrics:
+                expected[(one, two)] = metrics(dists[one], dists[two])
+            else:
+                expected[(one, two)] = [jsd(dists[one], dists[two])]
+
+    columns = 5 if args.metrics else 1
+    errors = []
+    seen = set()
+    worst = 0.0
+    for line in sys.stdin:
+        fields = line.split()
+        if len(fields) != columns + 2:
+            errors.append('malformed line: ' + line.rstrip())
+            continue
+        pair = tuple(sorted(fields[columns:]))
+        if pair not in expected or pair in seen:
+            errors.append('unexpected or repeated pair: ' + line.rstrip())
+            continue
+        seen.add(pair)
+        for value, reference in zip(fields, expected[pair]):
+            diff = abs(float(value) - reference)
+            worst = max(worst, diff)
+            if diff > args.tolerance:
+                errors.append('%s %s: %s, reference %.9f' % (pair[0], pair[1], value, reference))
+    errors += ['missing pair: %s %s' % pair for pair in sorted(expected.keys() - seen)]
+
+    for error in errors[:10]:
+        print(error)
+    print('%d pairs, largest difference %.2g' % (len(seen), worst))
+    return 1 if errors else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+"""A round trip through compare --serve (the protocol at the top of server.c).
+Queries the text of QUERY for up to 64 documents and prints them like
+compare --query does, then checks the other requests against that answer:
+the pair of QUERY's own document with the closest other one, an added copy
+of QUERY at JSD 0 from it, and a removed document no longer being paired.
+Exits with status 1 and a message on stderr if a reply is wrong.
+
+usage: serveclient.py SOCKET QUERY
+"""
+import socket
+import struct
+import sys
+
+ADD_PATH, ADD_TEXT, REMOVE, QUERY, PAIR = range(1, 6)
+
+
+def request(op, arg1=0, arg2=0, payload=b''):
+    return struct.pack('=IiiI', op, arg1, arg2, len(payload)) + payload
+
+
+def receive(sock, n):
+    data = b''
+    while len(data) < n:
+        chunk = sock.recv(n - len(data))
+        if not chunk:
+            sys.exit('serveclient.py: the server closed the connection')
+        data += chunk
+    return data
+
+
+def reply(sock):
+    """status, id, jsd and the (id, name, jsd) matches of one reply."""
+    status, doc, count, _, jsd = struct.unpack('=iiIId', receive(sock, 24))
+    matches = []
+    for _ in range(count):
+        match, length, distance = struct.unpack('=iId', receive(sock, 16))
+        matches.append((match, receive(sock, length).decode(), distance))
+    return status, doc, jsd, matches
+
+
+def ask(sock, *args):
+    sock.sendall(request(*args))
+    return reply(sock)
+
+
+def expect(what, ok):
+    if not ok:
+        sys.exit('serveclient.py: ' + what)
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__.rsplit('usage: ', 1)[1])
+    path, query = sys.argv[1], sys.argv[2]
+    text = open(query, 'rb').read()
+    sock = socket.socket(socket.AF_UNIX)
+    sock.connect(path)
+
+    status, _, _, matches = ask(sock, QUERY, 64, 0, text)
+    expect('query failed', status == 0 and matches)
+    for _, name, distance in matches:
+        print('%.6f     %s     %s' % (distance, query, name))
+
+    ids = {name: match for match, name, _ in matches}
+    expect('the query is not its own closest document', query in ids)
+    other, _, distance = next(m for m in matches if m[1] != query)
+    status, _, jsd, _ = ask(sock, PAIR, ids[query], other)
+    expect('pair %.6f, query %.6f' % (jsd, distance), status == 0 and abs(jsd - distance) < 1e-9)
+
+    name = b'copy of the query'
+    status, added, _, _ = ask(sock, ADD_TEXT, len(name), 0, name + text)
+    expect('add failed', status == 0)
+    status, _, jsd, _ = ask(sock, PAIR, added, ids[query])
+    expect('an added copy is at %.6f' % jsd, status == 0 and jsd == 0)
+    status, _, _, _ = ask(sock, REMOVE, added)
+    expect('remove failed', status == 0)
+    status, _, _, _ = ask(sock, PAIR, added, ids[query])
+    expect('a removed document is still paired', status == -1)
+
+
+if __name__ == '__main__':
+    main()
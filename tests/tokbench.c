@@ -0,0 +1,114 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#define SIZE 8
+
+#include "../strbuf.c"
+#include "../token.c"
+
+//---------------------------------------------------------------------
+// Tokenizer throughput on English and on mixed-script text (make bench)
+//---------------------------------------------------------------------
+
+/*
+ * Both texts are drawn from fixed word lists with a fixed seed, so every run
+ * tokenizes the same bytes. The mixed text takes its words from Latin with
+ * diacritics, Greek, Cyrillic, Devanagari, Arabic, Hebrew, CJK, Hangul and
+ * fullwidth letters, with punctuation, symbols and emoji between them, which
+ * sends most characters through the multibyte lookup. Built with
+ * -DTOKEN_NO_SIMD it measures the table path alone.
+ */
+
+#define TEXT_BYTES (32 << 20)
+#define ROUNDS 3
+
+static const char *english[] = {
+    "the", "of", "and", "to", "in", "is", "that", "for", "it", "as", "was", "with",
+    "be", "by", "on", "not", "he", "this", "are", "or", "his", "from", "at",
+    "which", "but", "have", "an", "had", "they", "you", "were", "their", "one",
+    "all", "we", "can", "her", "has", "there", "been", "if", "more", "when",
+    "will", "would", "who", "so", "no", "Divergence", "Jensen-Shannon", "1998,",
+    "corpus.", "\"words\"", "don't", "(text)"
+};
+
+static const char *mixed[] = {
+    "Straße", "naïve", "café", "Ærøskøbing", "Łódź", "Việt", "Σίσυφος", "ΚΌΣΜΟΣ",
+    "Москва", "ПРИВЕТ", "हिन्दी", "नमस्ते", "العربية", "مرحبا", "שלום", "東京都",
+    "漢字", "とうきょう", "カタカナ", "한국어", "ＡＢＣ", "ａｂｃ", "२०२६", "١٢٣",
+    "ქართული", "Ⅻ", "the", "and", "—", "“quoted”", "«", "»", "…", "€", "🙂",
+    "👍🏽", "¿", "¡", "·", "™", "①", "x²"
+};
+
+static unsigned long long words;
+
+static void countWord(void *ctx, char *word){
+    (void) ctx;
+    (void) word;
+    words++;
+}
+
+/**
+ * purpose: fill buf with length bytes of words drawn from list, separated by
+ * spaces and now and then a newline.
+ */
+static void generate(unsigned char *buf, size_t length, const char **list, size_t count){
+    unsigned int seed = 12345;
+    size_t used = 0;
+    while(1){
+        seed = seed * 1103515245 + 12345;
+        const char *word = list[(seed >> 16) % count];
+        size_t n = strlen(word);
+        if(used + n + 1 > length) break;
+        memcpy(buf + used, word, n);
+        used += n;
+        buf[used++] = ((seed >> 8) % 13 == 0) ? '\n' : ' ';
+    }
+    memset(buf + used, ' ', length - used);
+}
+
+static double seconds(void){
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+static void run(const char *name, const unsigned char *buf, size_t length, int rules){
+    double best = 0;
+    for(int round = 0; round < ROUNDS; round++){
+        tokenizer_t tok;
+        words = 0;
+        init_tokenizer(&tok, rules, countWord, NULL);
+        double start = seconds();
+        tokenize(&tok, buf, length, 1);
+        double elapsed = seconds() - start;
+        destroy_tokenizer(&tok);
+        if(round == 0 || elapsed < best) best = elapsed;
+    }
+    printf("%-8s --rules %-8s %8.1f MB/s %10llu words\n", name, tokenRuleNames[rules],
+           length / best / 1e6, words);
+}
+
+int main(void){
+    unsigned char *buf = malloc(TEXT_BYTES);
+    if(buf == NULL){
+        perror("text buffer");
+        return 1;
+    }
+#ifdef TOKEN_NO_SIMD
+    printf("table path only\n");
+#endif
+
+    generate(buf, TEXT_BYTES, english, sizeof(english) / sizeof(english[0]));
+    run("english", buf, TEXT_BYTES, RULES_DEFAULT);
+    run("english", buf, TEXT_BYTES, RULES_UTF8);
+
+    generate(buf, TEXT_BYTES, mixed, sizeof(mixed) / sizeof(mixed[0]));
+    run("mixed", buf, TEXT_BYTES, RULES_DEFAULT);
+    run("mixed", buf, TEXT_BYTES, RULES_UTF8);
+
+    free(buf);
+    return 0;
+}
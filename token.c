@@ -0,0 +1,384 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include "tokentables.h"
+
+#if defined(__SSE2__) && !defined(TOKEN_NO_SIMD)
+#include <emmintrin.h>
+#define TOKEN_SIMD 1
+#endif
+
+#define TOKENBUF (64 * 1024)
+
+//---------------------------------------------------------------------
+// Tokenizer rules: what is a word character, from generated tables
+//---------------------------------------------------------------------
+
+/*
+ * Every tokenizer (fillList, the chunked ranges and listFromBuffer) walks its
+ * text one character at a time with tokenChar. A character either separates
+ * words or belongs to one, and brings zero or more bytes to append to the
+ * word. The rules come from tokentables.h, which gentables.c writes at build
+ * time, so the result never depends on the locale:
+ *
+ *     default   ASCII letters (lowercased), digits and '-' are kept, the other
+ *               bytes are dropped, ASCII white space separates
+ *     alnum     ASCII letters (lowercased) and digits are kept, every other
+ *               byte separates
+ *     utf8      ASCII as in default; valid UTF-8 letters, digits and marks
+ *               (Alphabetic, Nd and M* in the Unicode data) are kept with
+ *               simple case folding, Unicode spaces separate and everything
+ *               else, including invalid bytes, is dropped
+ *
+ * For the two ASCII rule sets a character is always one byte and one table
+ * lookup. The utf8 rules decode a sequence only when a byte >= 0x80 shows up.
+ *
+ * tokenize drives a tokenizer_t over a buffer and hands every finished word
+ * to a callback. Where SSE2 is available it classifies 16 ASCII bytes at a
+ * time (lowercasing, kept and separator masks) and appends whole runs of kept
+ * bytes at once; a block with a byte >= 0x80 falls back to tokenChar from
+ * that byte on. The masks repeat the ASCII rules of gentables.c, and building
+ * with -DTOKEN_NO_SIMD gives the table-only path to compare against.
+ */
+
+
+typedef struct {
+    int kind;                   //TOKEN_SEPARATOR or TOKEN_WORD
+    int outLength;              //0 when the character is dropped
+    unsigned char out[4];
+} token_char_t;
+
+/**
+ * purpose: the rule set called name, or -1.
+ */
+int findTokenRules(const char *name){
+    for(int r = 0; r < NUM_RULES; r++){
+        if(strcmp(tokenRuleNames[r], name) == 0) return r;
+    }
+    return -1;
+}
+
+//the length of a valid UTF-8 sequence starting at p, or 0
+static inline int utf8Length(const unsigned char *p, size_t avail){
+    int length;
+    unsigned char lo = 0x80, hi = 0xBF;
+    if(p[0] >= 0xC2 && p[0] <= 0xDF) length = 2;
+    else if(p[0] >= 0xE0 && p[0] <= 0xEF) length = 3;
+    else if(p[0] >= 0xF0 && p[0] <= 0xF4) length = 4;
+    else return 0;
+
+    //no overlong forms, surrogates or code points past U+10FFFF
+    if(p[0] == 0xE0) lo = 0xA0;
+    else if(p[0] == 0xED) hi = 0x9F;
+    else if(p[0] == 0xF0) lo = 0x90;
+    else if(p[0] == 0xF4) hi = 0x8F;
+
+    if(avail < (size_t) length) return 0;
+    if(p[1] < lo || p[1] > hi) return 0;
+    for(int i = 2; i < length; i++){
+        if((p[i] & 0xC0) != 0x80) return 0;
+    }
+    return length;
+}
+
+//the range a code point from U+0800 up falls in, or NULL for a plain letter
+static inline const token_range_t *findTokenRange(unsigned int cp){
+    int lo = 0, hi = NUM_TOKEN_RANGES - 1;
+    while(lo <= hi){
+        int mid = (lo + hi) / 2;
+        if(cp < tokenRanges[mid].first) hi = mid - 1;
+        else if(cp > tokenRanges[mid].last) lo = mid + 1;
+        else return &tokenRanges[mid];
+    }
+    return NULL;
+}
+
+static inline int encodeUtf8(unsigned int cp, unsigned char *out){
+    if(cp < 0x80){
+        out[0] = cp;
+        return 1;
+    }
+    if(cp < 0x800){
+        out[0] = 0xC0 | (cp >> 6);
+        out[1] = 0x80 | (cp & 0x3F);
+        return 2;
+    }
+    if(cp < 0x10000){
+        out[0] = 0xE0 | (cp >> 12);
+        out[1] = 0x80 | ((cp >> 6) & 0x3F);
+        out[2] = 0x80 | (cp & 0x3F);
+        return 3;
+    }
+    out[0] = 0xF0 | (cp >> 18);
+    out[1] = 0x80 | ((cp >> 12) & 0x3F);
+    out[2] = 0x80 | ((cp >> 6) & 0x3F);
+    out[3] = 0x80 | (cp & 0x3F);
+    return 4;
+}
+
+/**
+ * purpose: decode a character of the utf8 rules that starts with a byte >= 0x80.
+ * An invalid byte is a dropped character of its own, so every tokenizer
+ * resynchronizes on the next byte the same way.
+ */
+size_t tokenMultibyte(const unsigned char *p, size_t avail, int atEnd, token_char_t *ch){
+    ch->kind = TOKEN_WORD;
+    ch->outLength = 0;
+
+    //wait for the rest of a sequence cut off by the end of the buffer
+    int expected = (p[0] >= 0xF0) ? 4 : (p[0] >= 0xE0) ? 3 : (p[0] >= 0xC0) ? 2 : 1;
+    if(avail < (size_t) expected && !atEnd) return 0;
+
+    int length = utf8Length(p, avail);
+    if(length == 0) return 1;
+
+    if(length == 2){
+        unsigned int fold = tokenFold2[((p[0] & 0x1F) << 6) | (p[1] & 0x3F)];
+        if(fold == TOKEN_FOLD_SEPARATOR){
+            ch->kind = TOKEN_SEPARATOR;
+        } else if(fold != TOKEN_DROP){
+            ch->outLength = encodeUtf8(fold, ch->out);
+        }
+        return 2;
+    }
+
+    unsigned int cp = p[0] & (length == 3 ? 0x0F : 0x07);
+    for(int i = 1; i < length; i++) cp = (cp << 6) | (p[i] & 0x3F);
+    const token_range_t *range = findTokenRange(cp);
+    if(range == NULL){
+        //dropped: punctuation, symbols, format and unassigned code points
+    } else if(range->kind == TOKEN_SEPARATOR){
+        ch->kind = TOKEN_SEPARATOR;
+    } else {
+        ch->outLength = encodeUtf8(range->fold + (cp - range->first), ch->out);
+    }
+    return length;
+}
+
+/**
+ * purpose: classify the character starting at p, with avail bytes left in
+ * the buffer. Returns its length in bytes, or 0 if the buffer ends in the
+ * middle of it and more text follows (atEnd not set).
+ */
+static inline size_t tokenChar(int rules, const unsigned char *p, size_t avail, int atEnd, token_char_t *ch){
+    short rule = tokenTable[rules][p[0]];
+    if(rule == TOKEN_MULTIBYTE){
+        return tokenMultibyte(p, avail, atEnd, ch);
+    }
+    if(rule == TOKEN_SEPARATOR){
+        ch->kind = TOKEN_SEPARATOR;
+        ch->outLength = 0;
+    } else {
+        ch->kind = TOKEN_WORD;
+        ch->out[0] = (unsigned char) rule;
+        ch->outLength = (rule != TOKEN_DROP);
+    }
+    return 1;
+}
+
+//make room for n more bytes and the terminator
+static inline void tokenReserve(strbuf_t *sb, size_t n){
+    if(sb->used + n + 1 > sb->length){
+        size_t size = sb->length * 2;
+        while(size < sb->used + n + 1) size *= 2;
+        char *p = realloc(sb->data, size);
+        if(p == NULL){
+            perror("word buffer resize failed");
+            abort();
+        }
+        sb->data = p;
+        sb->length = size;
+    }
+}
+
+static inline void tokenAppend(strbuf_t *sb, const token_char_t *ch){
+    tokenReserve(sb, 4);
+    memcpy(sb->data + sb->used, ch->out, 4);
+    sb->used += ch->outLength;
+    sb->data[sb->used] = '\0';
+}
+
+/**
+ * HOW TO: tokenizers
+ *
+ * declaration              tokenizer_t tok;
+ *
+ * initialization           init_tokenizer(&tok, rules, emit, ctx);
+ *                          (emit(ctx, word) is called once per word)
+ *
+ * reading text             size_t used = tokenize(&tok, buf, length, atEnd);
+ *                          (keep buf + used for the next call if atEnd is 0)
+ *
+ * the last word            tokenEndWord(&tok);
+ *
+ * deallocation             destroy_tokenizer(&tok);
+ */
+typedef struct {
+    int rules;
+    strbuf_t word;
+    int inWord;                 //a character that is not a separator came since the last one
+    void (*emit)(void *ctx, char *word);
+    void *ctx;
+} tokenizer_t;
+
+int init_tokenizer(tokenizer_t *tok, int rules, void (*emit)(void *ctx, char *word), void *ctx){
+    tok->rules = rules;
+    tok->inWord = 0;
+    tok->emit = emit;
+    tok->ctx = ctx;
+    return strbuf_init(&tok->word, SIZE);
+}
+
+void destroy_tokenizer(tokenizer_t *tok){
+    strbuf_destroy(&tok->word);
+}
+
+//a separator: hand over the word, if it kept any bytes
+static inline void tokenEndWord(tokenizer_t *tok){
+    if(tok->word.used != 0){
+        tok->emit(tok->ctx, tok->word.data);
+        tok->word.used = 0;
+        tok->word.data[0] = '\0';
+    }
+    tok->inWord = 0;
+}
+
+static inline void tokenTake(tokenizer_t *tok, const token_char_t *ch){
+    if(ch->kind == TOKEN_SEPARATOR){
+        tokenEndWord(tok);
+    } else {
+        tok->inWord = 1;
+        tokenAppend(&tok->word, ch);
+    }
+}
+
+#ifdef TOKEN_SIMD
+//bytes of v from lo to hi, as a mask of 0xFF bytes (v must be ASCII)
+static inline __m128i asciiRange(__m128i v, char lo, char hi){
+    return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(lo - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8(hi + 1)));
+}
+
+/**
+ * purpose: take the ASCII bytes at the start of the 16 at p. Returns how many
+ * that was, 0 if p starts with a byte >= 0x80.
+ */
+static inline int tokenAsciiBlock(tokenizer_t *tok, const unsigned char *p){
+    __m128i v = _mm_loadu_si128((const __m128i *) p);
+    unsigned int high = _mm_movemask_epi8(v);
+    int n = high ? __builtin_ctz(high) : 16;
+    if(n == 0) return 0;
+
+    __m128i upper = asciiRange(v, 'A', 'Z');
+    __m128i lower = _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+    __m128i keep = _mm_or_si128(asciiRange(lower, 'a', 'z'), asciiRange(v, '0', '9'));
+    unsigned int sep;
+    if(tok->rules == RULES_ALNUM){
+        sep = ~_mm_movemask_epi8(keep);
+    } else {
+        keep = _mm_or_si128(keep, _mm_cmpeq_epi8(v, _mm_set1_epi8('-')));
+        sep = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), asciiRange(v, '\t', '\r')));
+    }
+    unsigned int kept = _mm_movemask_epi8(keep);
+    unsigned char bytes[32];
+    _mm_storeu_si128((__m128i *) bytes, lower);
+
+    //walk the runs between separators
+    sep &= (1u << n) - 1;
+    int start = 0;
+    while(start < n){
+        int stop = sep ? __builtin_ctz(sep) : n;
+        if(stop > start){
+            tok->inWord = 1;
+            strbuf_t *sb = &tok->word;
+            tokenReserve(sb, 16);
+            unsigned int run = ((1u << stop) - 1) & ~((1u << start) - 1);
+            if((kept & run) == run){
+                //copy all 16 and keep the run; the rest is overwritten later
+                _mm_storeu_si128((__m128i *) (sb->data + sb->used), _mm_loadu_si128((const __m128i *) (bytes + start)));
+                sb->used += stop - start;
+            } else {
+                for(run &= kept; run; run &= run - 1) sb->data[sb->used++] = bytes[__builtin_ctz(run)];
+            }
+            sb->data[sb->used] = '\0';
+        }
+        if(stop == n) break;
+        tokenEndWord(tok);
+        sep &= sep - 1;
+        start = stop + 1;
+    }
+    return n;
+}
+#endif
+
+/**
+ * purpose: read the characters of p (avail bytes) into tok. Returns the bytes
+ * used, which is less than avail only when a character is cut off by the end
+ * of the buffer and atEnd is not set.
+ */
+size_t tokenize(tokenizer_t *tok, const unsigned char *p, size_t avail, int atEnd){
+    size_t i = 0;
+#ifdef TOKEN_SIMD
+    size_t scalarUntil = 0;
+#endif
+    while(i < avail){
+#ifdef TOKEN_SIMD
+        //after a block that started with a multibyte character, decode the rest of it singly
+        if(i >= scalarUntil && avail - i >= 16){
+            int n = tokenAsciiBlock(tok, p + i);
+            if(n > 0){
+                i += n;
+                continue;
+            }
+            scalarUntil = i + 16;
+        }
+#endif
+        token_char_t ch;
+        size_t length = tokenChar(tok->rules, p + i, avail - i, atEnd, &ch);
+        if(length == 0) break;
+        i += length;
+        tokenTake(tok, &ch);
+    }
+    return i;
+}
+
+/**
+ * purpose: where a range of fd near pos may start. Under the utf8 rules that
+ * is the first ASCII byte at or after pos (or size), which never lies inside
+ * a character; the ASCII rule sets can start anywhere.
+ */
+off_t tokenBoundary(int fd, off_t pos, off_t size, int rules){
+    if(rules != RULES_UTF8 || pos <= 0 || pos >= size) return pos;
+
+    unsigned char buf[64];
+    ssize_t n;
+    while((n = pread(fd, buf, sizeof(buf), pos)) > 0){
+        for(ssize_t i = 0; i < n; i++, pos++){
+            if(buf[i] < 0x80) return pos;
+        }
+    }
+    return size;
+}
+
+/**
+ * purpose: the kind of the character that ends just before boundary pos, as
+ * reading fd from the start would have decoded it. A read error counts as a
+ * separator.
+ */
+int tokenKindBefore(int fd, off_t pos, int rules){
+    unsigned char tail[4];
+    off_t from = (pos >= 4) ? pos - 4 : 0;
+    ssize_t n = pread(fd, tail, pos - from, from);
+    if(n != pos - from || n == 0) return TOKEN_SEPARATOR;
+
+    //the last character starts at the last byte that is not a continuation
+    ssize_t j = n - 1;
+    while(rules == RULES_UTF8 && j > 0 && (tail[j] & 0xC0) == 0x80) j--;
+
+    token_char_t ch;
+    if(tokenChar(rules, tail + j, n - j, 1, &ch) == (size_t) (n - j)) return ch.kind;
+
+    //an invalid byte: dropped, so part of a word
+    return TOKEN_WORD;
+}
@@ -0,0 +1,1985 @@
+//generated by ucdranges.py from Unicode 14.0.0, do not edit
+//first, last, kind (-1 separates, 1 is kept), what first folds to
+
+#define NUM_UCD_RANGES 1978
+
+static const int ucdRanges[NUM_UCD_RANGES][4] = {
+    { 0x85, 0x85, -1, 0x0 },
+    { 0xA0, 0xA0, -1, 0x0 },
+    { 0xAA, 0xAA, 1, 0xAA },
+    { 0xB5, 0xB5, 1, 0x3BC },
+    { 0xBA, 0xBA, 1, 0xBA },
+    { 0xC0, 0xD6, 1, 0xE0 },
+    { 0xD8, 0xDE, 1, 0xF8 },
+    { 0xDF, 0xF6, 1, 0xDF },
+    { 0xF8, 0xFF, 1, 0xF8 },
+    { 0x100, 0x100, 1, 0x101 },
+    { 0x101, 0x101, 1, 0x101 },
+    { 0x102, 0x102, 1, 0x103 },
+    { 0x103, 0x103, 1, 0x103 },
+    { 0x104, 0x104, 1, 0x105 },
+    { 0x105, 0x105, 1, 0x105 },
+    { 0x106, 0x106, 1, 0x107 },
+    { 0x107, 0x107, 1, 0x107 },
+    { 0x108, 0x108, 1, 0x109 },
+    { 0x109, 0x109, 1, 0x109 },
+    { 0x10A, 0x10A, 1, 0x10B },
+    { 0x10B, 0x10B, 1, 0x10B },
+    { 0x10C, 0x10C, 1, 0x10D },
+    { 0x10D, 0x10D, 1, 0x10D },
+    { 0x10E, 0x10E, 1, 0x10F },
+    { 0x10F, 0x10F, 1, 0x10F },
+    { 0x110, 0x110, 1, 0x111 },
+    { 0x111, 0x111, 1, 0x111 },
+    { 0x112, 0x112, 1, 0x113 },
+    { 0x113, 0x113, 1, 0x113 },
+    { 0x114, 0x114, 1, 0x115 },
+    { 0x115, 0x115, 1, 0x115 },
+    { 0x116, 0x116, 1, 0x117 },
+    { 0x117, 0x117, 1, 0x117 },
+    { 0x118, 0x118, 1, 0x119 },
+    { 0x119, 0x119, 1, 0x119 },
+    { 0x11A, 0x11A, 1, 0x11B },
+    { 0x11B, 0x11B, 1, 0x11B },
+    { 0x11C, 0x11C, 1, 0x11D },
+    { 0x11D, 0x11D, 1, 0x11D },
+    { 0x11E, 0x11E, 1, 0x11F },
+    { 0x11F, 0x11F, 1, 0x11F },
+    { 0x120, 0x120, 1, 0x121 },
+    { 0x121, 0x121, 1, 0x121 },
+    { 0x122, 0x122, 1, 0x123 },
+    { 0x123, 0x123, 1, 0x123 },
+    { 0x124, 0x124, 1, 0x125 },
+    { 0x125, 0x125, 1, 0x125 },
+    { 0x126, 0x126, 1, 0x127 },
+    { 0x127, 0x127, 1, 0x127 },
+    { 0x128, 0x128, 1, 0x129 },
+    { 0x129, 0x129, 1, 0x129 },
+    { 0x12A, 0x12A, 1, 0x12B },
+    { 0x12B, 0x12B, 1, 0x12B },
+    { 0x12C, 0x12C, 1, 0x12D },
+    { 0x12D, 0x12D, 1, 0x12D },
+    { 0x12E, 0x12E, 1, 0x12F },
+    { 0x12F, 0x131, 1, 0x12F },
+    { 0x132, 0x132, 1, 0x133 },
+    { 0x133, 0x133, 1, 0x133 },
+    { 0x134, 0x134, 1, 0x135 },
+    { 0x135, 0x135, 1, 0x135 },
+    { 0x136, 0x136, 1, 0x137 },
+    { 0x137, 0x138, 1, 0x137 },
+    { 0x139, 0x139, 1, 0x13A },
+    { 0x13A, 0x13A, 1, 0x13A },
+    { 0x13B, 0x13B, 1, 0x13C },
+    { 0x13C, 0x13C, 1, 0x13C },
+    { 0x13D, 0x13D, 1, 0x13E },
+    { 0x13E, 0x13E, 1, 0x13E },
+    { 0x13F, 0x13F, 1, 0x140 },
+    { 0x140, 0x140, 1, 0x140 },
+    { 0x141, 0x141, 1, 0x142 },
+    { 0x142, 0x142, 1, 0x142 },
+    { 0x143, 0x143, 1, 0x144 },
+    { 0x144, 0x144, 1, 0x144 },
+    { 0x145, 0x145, 1, 0x146 },
+    { 0x146, 0x146, 1, 0x146 },
+    { 0x147, 0x147, 1, 0x148 },
+    { 0x148, 0x149, 1, 0x148 },
+    { 0x14A, 0x14A, 1, 0x14B },
+    { 0x14B, 0x14B, 1, 0x14B },
+    { 0x14C, 0x14C, 1, 0x14D },
+    { 0x14D, 0x14D, 1, 0x14D },
+    { 0x14E, 0x14E, 1, 0x14F },
+    { 0x14F, 0x14F, 1, 0x14F },
+    { 0x150, 0x150, 1, 0x151 },
+    { 0x151, 0x151, 1, 0x151 },
+    { 0x152, 0x152, 1, 0x153 },
+    { 0x153, 0x153, 1, 0x153 },
+    { 0x154, 0x154, 1, 0x155 },
+    { 0x155, 0x155, 1, 0x155 },
+    { 0x156, 0x156, 1, 0x157 },
+    { 0x157, 0x157, 1, 0x157 },
+    { 0x158, 0x158, 1, 0x159 },
+    { 0x159, 0x159, 1, 0x159 },
+    { 0x15A, 0x15A, 1, 0x15B },
+    { 0x15B, 0x15B, 1, 0x15B },
+    { 0x15C, 0x15C, 1, 0x15D },
+    { 0x15D, 0x15D, 1, 0x15D },
+    { 0x15E, 0x15E, 1, 0x15F },
+    { 0x15F, 0x15F, 1, 0x15F },
+    { 0x160, 0x160, 1, 0x161 },
+    { 0x161, 0x161, 1, 0x161 },
+    { 0x162, 0x162, 1, 0x163 },
+    { 0x163, 0x163, 1, 0x163 },
+    { 0x164, 0x164, 1, 0x165 },
+    { 0x165, 0x165, 1, 0x165 },
+    { 0x166, 0x166, 1, 0x167 },
+    { 0x167, 0x167, 1, 0x167 },
+    { 0x168, 0x168, 1, 0x169 },
+    { 0x169, 0x169, 1, 0x169 },
+    { 0x16A, 0x16A, 1, 0x16B },
+    { 0x16B, 0x16B, 1, 0x16B },
+    { 0x16C, 0x16C, 1, 0x16D },
+    { 0x16D, 0x16D, 1, 0x16D },
+    { 0x16E, 0x16E, 1, 0x16F },
+    { 0x16F, 0x16F, 1, 0x16F },
+    { 0x170, 0x170, 1, 0x171 },
+    { 0x171, 0x171, 1, 0x171 },
+    { 0x172, 0x172, 1, 0x173 },
+    { 0x173, 0x173, 1, 0x173 },
+    { 0x174, 0x174, 1, 0x175 },
+    { 0x175, 0x175, 1, 0x175 },
+    { 0x176, 0x176, 1, 0x177 },
+    { 0x177, 0x177, 1, 0x177 },
+    { 0x178, 0x178, 1, 0xFF },
+    { 0x179, 0x179, 1, 0x17A },
+    { 0x17A, 0x17A, 1, 0x17A },
+    { 0x17B, 0x17B, 1, 0x17C },
+    { 0x17C, 0x17C, 1, 0x17C },
+    { 0x17D, 0x17D, 1, 0x17E },
+    { 0x17E, 0x17E, 1, 0x17E },
+    { 0x17F, 0x17F, 1, 0x73 },
+    { 0x180, 0x180, 1, 0x180 },
+    { 0x181, 0x181, 1, 0x253 },
+    { 0x182, 0x182, 1, 0x183 },
+    { 0x183, 0x183, 1, 0x183 },
+    { 0x184, 0x184, 1, 0x185 },
+    { 0x185, 0x185, 1, 0x185 },
+    { 0x186, 0x186, 1, 0x254 },
+    { 0x187, 0x187, 1, 0x188 },
+    { 0x188, 0x188, 1, 0x188 },
+    { 0x189, 0x18A, 1, 0x256 },
+    { 0x18B, 0x18B, 1, 0x18C },
+    { 0x18C, 0x18D, 1, 0x18C },
+    { 0x18E, 0x18E, 1, 0x1DD },
+    { 0x18F, 0x18F, 1, 0x259 },
+    { 0x190, 0x190, 1, 0x25B },
+    { 0x191, 0x191, 1, 0x192 },
+    { 0x192, 0x192, 1, 0x192 },
+    { 0x193, 0x193, 1, 0x260 },
+    { 0x194, 0x194, 1, 0x263 },
+    { 0x195, 0x195, 1, 0x195 },
+    { 0x196, 0x196, 1, 0x269 },
+    { 0x197, 0x197, 1, 0x268 },
+    { 0x198, 0x198, 1, 0x199 },
+    { 0x199, 0x19B, 1, 0x199 },
+    { 0x19C, 0x19C, 1, 0x26F },
+    { 0x19D, 0x19D, 1, 0x272 },
+    { 0x19E, 0x19E, 1, 0x19E },
+    { 0x19F, 0x19F, 1, 0x275 },
+    { 0x1A0, 0x1A0, 1, 0x1A1 },
+    { 0x1A1, 0x1A1, 1, 0x1A1 },
+    { 0x1A2, 0x1A2, 1, 0x1A3 },
+    { 0x1A3, 0x1A3, 1, 0x1A3 },
+    { 0x1A4, 0x1A4, 1, 0x1A5 },
+    { 0x1A5, 0x1A5, 1, 0x1A5 },
+    { 0x1A6, 0x1A6, 1, 0x280 },
+    { 0x1A7, 0x1A7, 1, 0x1A8 },
+    { 0x1A8, 0x1A8, 1, 0x1A8 },
+    { 0x1A9, 0x1A9, 1, 0x283 },
+    { 0x1AA, 0x1AB, 1, 0x1AA },
+    { 0x1AC, 0x1AC, 1, 0x1AD },
+    { 0x1AD, 0x1AD, 1, 0x1AD },
+    { 0x1AE, 0x1AE, 1, 0x288 },
+    { 0x1AF, 0x1AF, 1, 0x1B0 },
+    { 0x1B0, 0x1B0, 1, 0x1B0 },
+    { 0x1B1, 0x1B2, 1, 0x28A },
+    { 0x1B3, 0x1B3, 1, 0x1B4 },
+    { 0x1B4, 0x1B4, 1, 0x1B4 },
+    { 0x1B5, 0x1B5, 1, 0x1B6 },
+    { 0x1B6, 0x1B6, 1, 0x1B6 },
+    { 0x1B7, 0x1B7, 1, 0x292 },
+    { 0x1B8, 0x1B8, 1, 0x1B9 },
+    { 0x1B9, 0x1BB, 1, 0x1B9 },
+    { 0x1BC, 0x1BC, 1, 0x1BD },
+    { 0x1BD, 0x1C3, 1, 0x1BD },
+    { 0x1C4, 0x1C4, 1, 0x1C6 },
+    { 0x1C5, 0x1C5, 1, 0x1C6 },
+    { 0x1C6, 0x1C6, 1, 0x1C6 },
+    { 0x1C7, 0x1C7, 1, 0x1C9 },
+    { 0x1C8, 0x1C8, 1, 0x1C9 },
+    { 0x1C9, 0x1C9, 1, 0x1C9 },
+    { 0x1CA, 0x1CA, 1, 0x1CC },
+    { 0x1CB, 0x1CB, 1, 0x1CC },
+    { 0x1CC, 0x1CC, 1, 0x1CC },
+    { 0x1CD, 0x1CD, 1, 0x1CE },
+    { 0x1CE, 0x1CE, 1, 0x1CE },
+    { 0x1CF, 0x1CF, 1, 0x1D0 },
+    { 0x1D0, 0x1D0, 1, 0x1D0 },
+    { 0x1D1, 0x1D1, 1, 0x1D2 },
+    { 0x1D2, 0x1D2, 1, 0x1D2 },
+    { 0x1D3, 0x1D3, 1, 0x1D4 },
+    { 0x1D4, 0x1D4, 1, 0x1D4 },
+    { 0x1D5, 0x1D5, 1, 0x1D6 },
+    { 0x1D6, 0x1D6, 1, 0x1D6 },
+    { 0x1D7, 0x1D7, 1, 0x1D8 },
+    { 0x1D8, 0x1D8, 1, 0x1D8 },
+    { 0x1D9, 0x1D9, 1, 0x1DA },
+    { 0x1DA, 0x1DA, 1, 0x1DA },
+    { 0x1DB, 0x1DB, 1, 0x1DC },
+    { 0x1DC, 0x1DD, 1, 0x1DC },
+    { 0x1DE, 0x1DE, 1, 0x1DF },
+    { 0x1DF, 0x1DF, 1, 0x1DF },
+    { 0x1E0, 0x1E0, 1, 0x1E1 },
+    { 0x1E1, 0x1E1, 1, 0x1E1 },
+    { 0x1E2, 0x1E2, 1, 0x1E3 },
+    { 0x1E3, 0x1E3, 1, 0x1E3 },
+    { 0x1E4, 0x1E4, 1, 0x1E5 },
+    { 0x1E5, 0x1E5, 1, 0x1E5 },
+    { 0x1E6, 0x1E6, 1, 0x1E7 },
+    { 0x1E7, 0x1E7, 1, 0x1E7 },
+    { 0x1E8, 0x1E8, 1, 0x1E9 },
+    { 0x1E9, 0x1E9, 1, 0x1E9 },
+    { 0x1EA, 0x1EA, 1, 0x1EB },
+    { 0x1EB, 0x1EB, 1, 0x1EB },
+    { 0x1EC, 0x1EC, 1, 0x1ED },
+    { 0x1ED, 0x1ED, 1, 0x1ED },
+    { 0x1EE, 0x1EE, 1, 0x1EF },
+    { 0x1EF, 0x1F0, 1, 0x1EF },
+    { 0x1F1, 0x1F1, 1, 0x1F3 },
+    { 0x1F2, 0x1F2, 1, 0x1F3 },
+    { 0x1F3, 0x1F3, 1, 0x1F3 },
+    { 0x1F4, 0x1F4, 1, 0x1F5 },
+    { 0x1F5, 0x1F5, 1, 0x1F5 },
+    { 0x1F6, 0x1F6, 1, 0x195 },
+    { 0x1F7, 0x1F7, 1, 0x1BF },
+    { 0x1F8, 0x1F8, 1, 0x1F9 },
+    { 0x1F9, 0x1F9, 1, 0x1F9 },
+    { 0x1FA, 0x1FA, 1, 0x1FB },
+    { 0x1FB, 0x1FB, 1, 0x1FB },
+    { 0x1FC, 0x1FC, 1, 0x1FD },
+    { 0x1FD, 0x1FD, 1, 0x1FD },
+    { 0x1FE, 0x1FE, 1, 0x1FF },
+    { 0x1FF, 0x1FF, 1, 0x1FF },
+    { 0x200, 0x200, 1, 0x201 },
+    { 0x201, 0x201, 1, 0x201 },
+    { 0x202, 0x202, 1, 0x203 },
+    { 0x203, 0x203, 1, 0x203 },
+    { 0x204, 0x204, 1, 0x205 },
+    { 0x205, 0x205, 1, 0x205 },
+    { 0x206, 0x206, 1, 0x207 },
+    { 0x207, 0x207, 1, 0x207 },
+    { 0x208, 0x208, 1, 0x209 },
+    { 0x209, 0x209, 1, 0x209 },
+    { 0x20A, 0x20A, 1, 0x20B },
+    { 0x20B, 0x20B, 1, 0x20B },
+    { 0x20C, 0x20C, 1, 0x20D },
+    { 0x20D, 0x20D, 1, 0x20D },
+    { 0x20E, 0x20E, 1, 0x20F },
+    { 0x20F, 0x20F, 1, 0x20F },
+    { 0x210, 0x210, 1, 0x211 },
+    { 0x211, 0x211, 1, 0x211 },
+    { 0x212, 0x212, 1, 0x213 },
+    { 0x213, 0x213, 1, 0x213 },
+    { 0x214, 0x214, 1, 0x215 },
+    { 0x215, 0x215, 1, 0x215 },
+    { 0x216, 0x216, 1, 0x217 },
+    { 0x217, 0x217, 1, 0x217 },
+    { 0x218, 0x218, 1, 0x219 },
+    { 0x219, 0x219, 1, 0x219 },
+    { 0x21A, 0x21A, 1, 0x21B },
+    { 0x21B, 0x21B, 1, 0x21B },
+    { 0x21C, 0x21C, 1, 0x21D },
+    { 0x21D, 0x21D, 1, 0x21D },
+    { 0x21E, 0x21E, 1, 0x21F },
+    { 0x21F, 0x21F, 1, 0x21F },
+    { 0x220, 0x220, 1, 0x19E },
+    { 0x221, 0x221, 1, 0x221 },
+    { 0x222, 0x222, 1, 0x223 },
+    { 0x223, 0x223, 1, 0x223 },
+    { 0x224, 0x224, 1, 0x225 },
+    { 0x225, 0x225, 1, 0x225 },
+    { 0x226, 0x226, 1, 0x227 },
+    { 0x227, 0x227, 1, 0x227 },
+    { 0x228, 0x228, 1, 0x229 },
+    { 0x229, 0x229, 1, 0x229 },
+    { 0x22A, 0x22A, 1, 0x22B },
+    { 0x22B, 0x22B, 1, 0x22B },
+    { 0x22C, 0x22C, 1, 0x22D },
+    { 0x22D, 0x22D, 1, 0x22D },
+    { 0x22E, 0x22E, 1, 0x22F },
+    { 0x22F, 0x22F, 1, 0x22F },
+    { 0x230, 0x230, 1, 0x231 },
+    { 0x231, 0x231, 1, 0x231 },
+    { 0x232, 0x232, 1, 0x233 },
+    { 0x233, 0x239, 1, 0x233 },
+    { 0x23A, 0x23A, 1, 0x2C65 },
+    { 0x23B, 0x23B, 1, 0x23C },
+    { 0x23C, 0x23C, 1, 0x23C },
+    { 0x23D, 0x23D, 1, 0x19A },
+    { 0x23E, 0x23E, 1, 0x2C66 },
+    { 0x23F, 0x240, 1, 0x23F },
+    { 0x241, 0x241, 1, 0x242 },
+    { 0x242, 0x242, 1, 0x242 },
+    { 0x243, 0x243, 1, 0x180 },
+    { 0x244, 0x244, 1, 0x289 },
+    { 0x245, 0x245, 1, 0x28C },
+    { 0x246, 0x246, 1, 0x247 },
+    { 0x247, 0x247, 1, 0x247 },
+    { 0x248, 0x248, 1, 0x249 },
+    { 0x249, 0x249, 1, 0x249 },
+    { 0x24A, 0x24A, 1, 0x24B },
+    { 0x24B, 0x24B, 1, 0x24B },
+    { 0x24C, 0x24C, 1, 0x24D },
+    { 0x24D, 0x24D, 1, 0x24D },
+    { 0x24E, 0x24E, 1, 0x24F },
+    { 0x24F, 0x2C1, 1, 0x24F },
+    { 0x2C6, 0x2D1, 1, 0x2C6 },
+    { 0x2E0, 0x2E4, 1, 0x2E0 },
+    { 0x2EC, 0x2EC, 1, 0x2EC },
+    { 0x2EE, 0x2EE, 1, 0x2EE },
+    { 0x300, 0x344, 1, 0x300 },
+    { 0x345, 0x345, 1, 0x3B9 },
+    { 0x346, 0x36F, 1, 0x346 },
+    { 0x370, 0x370, 1, 0x371 },
+    { 0x371, 0x371, 1, 0x371 },
+    { 0x372, 0x372, 1, 0x373 },
+    { 0x373, 0x374, 1, 0x373 },
+    { 0x376, 0x376, 1, 0x377 },
+    { 0x377, 0x377, 1, 0x377 },
+    { 0x37A, 0x37D, 1, 0x37A },
+    { 0x37F, 0x37F, 1, 0x3F3 },
+    { 0x386, 0x386, 1, 0x3AC },
+    { 0x388, 0x38A, 1, 0x3AD },
+    { 0x38C, 0x38C, 1, 0x3CC },
+    { 0x38E, 0x38F, 1, 0x3CD },
+    { 0x390, 0x390, 1, 0x390 },
+    { 0x391, 0x3A1, 1, 0x3B1 },
+    { 0x3A3, 0x3AB, 1, 0x3C3 },
+    { 0x3AC, 0x3C1, 1, 0x3AC },
+    { 0x3C2, 0x3C2, 1, 0x3C3 },
+    { 0x3C3, 0x3CE, 1, 0x3C3 },
+    { 0x3CF, 0x3CF, 1, 0x3D7 },
+    { 0x3D0, 0x3D0, 1, 0x3B2 },
+    { 0x3D1, 0x3D1, 1, 0x3B8 },
+    { 0x3D2, 0x3D4, 1, 0x3D2 },
+    { 0x3D5, 0x3D5, 1, 0x3C6 },
+    { 0x3D6, 0x3D6, 1, 0x3C0 },
+    { 0x3D7, 0x3D7, 1, 0x3D7 },
+    { 0x3D8, 0x3D8, 1, 0x3D9 },
+    { 0x3D9, 0x3D9, 1, 0x3D9 },
+    { 0x3DA, 0x3DA, 1, 0x3DB },
+    { 0x3DB, 0x3DB, 1, 0x3DB },
+    { 0x3DC, 0x3DC, 1, 0x3DD },
+    { 0x3DD, 0x3DD, 1, 0x3DD },
+    { 0x3DE, 0x3DE, 1, 0x3DF },
+    { 0x3DF, 0x3DF, 1, 0x3DF },
+    { 0x3E0, 0x3E0, 1, 0x3E1 },
+    { 0x3E1, 0x3E1, 1, 0x3E1 },
+    { 0x3E2, 0x3E2, 1, 0x3E3 },
+    { 0x3E3, 0x3E3, 1, 0x3E3 },
+    { 0x3E4, 0x3E4, 1, 0x3E5 },
+    { 0x3E5, 0x3E5, 1, 0x3E5 },
+    { 0x3E6, 0x3E6, 1, 0x3E7 },
+    { 0x3E7, 0x3E7, 1, 0x3E7 },
+    { 0x3E8, 0x3E8, 1, 0x3E9 },
+    { 0x3E9, 0x3E9, 1, 0x3E9 },
+    { 0x3EA, 0x3EA, 1, 0x3EB },
+    { 0x3EB, 0x3EB, 1, 0x3EB },
+    { 0x3EC, 0x3EC, 1, 0x3ED },
+    { 0x3ED, 0x3ED, 1, 0x3ED },
+    { 0x3EE, 0x3EE, 1, 0x3EF },
+    { 0x3EF, 0x3EF, 1, 0x3EF },
+    { 0x3F0, 0x3F0, 1, 0x3BA },
+    { 0x3F1, 0x3F1, 1, 0x3C1 },
+    { 0x3F2, 0x3F3, 1, 0x3F2 },
+    { 0x3F4, 0x3F4, 1, 0x3B8 },
+    { 0x3F5, 0x3F5, 1, 0x3B5 },
+    { 0x3F7, 0x3F7, 1, 0x3F8 },
+    { 0x3F8, 0x3F8, 1, 0x3F8 },
+    { 0x3F9, 0x3F9, 1, 0x3F2 },
+    { 0x3FA, 0x3FA, 1, 0x3FB },
+    { 0x3FB, 0x3FC, 1, 0x3FB },
+    { 0x3FD, 0x3FF, 1, 0x37B },
+    { 0x400, 0x40F, 1, 0x450 },
+    { 0x410, 0x42F, 1, 0x430 },
+    { 0x430, 0x45F, 1, 0x430 },
+    { 0x460, 0x460, 1, 0x461 },
+    { 0x461, 0x461, 1, 0x461 },
+    { 0x462, 0x462, 1, 0x463 },
+    { 0x463, 0x463, 1, 0x463 },
+    { 0x464, 0x464, 1, 0x465 },
+    { 0x465, 0x465, 1, 0x465 },
+    { 0x466, 0x466, 1, 0x467 },
+    { 0x467, 0x467, 1, 0x467 },
+    { 0x468, 0x468, 1, 0x469 },
+    { 0x469, 0x469, 1, 0x469 },
+    { 0x46A, 0x46A, 1, 0x46B },
+    { 0x46B, 0x46B, 1, 0x46B },
+    { 0x46C, 0x46C, 1, 0x46D },
+    { 0x46D, 0x46D, 1, 0x46D },
+    { 0x46E, 0x46E, 1, 0x46F },
+    { 0x46F, 0x46F, 1, 0x46F },
+    { 0x470, 0x470, 1, 0x471 },
+    { 0x471, 0x471, 1, 0x471 },
+    { 0x472, 0x472, 1, 0x473 },
+    { 0x473, 0x473, 1, 0x473 },
+    { 0x474, 0x474, 1, 0x475 },
+    { 0x475, 0x475, 1, 0x475 },
+    { 0x476, 0x476, 1, 0x477 },
+    { 0x477, 0x477, 1, 0x477 },
+    { 0x478, 0x478, 1, 0x479 },
+    { 0x479, 0x479, 1, 0x479 },
+    { 0x47A, 0x47A, 1, 0x47B },
+    { 0x47B, 0x47B, 1, 0x47B },
+    { 0x47C, 0x47C, 1, 0x47D },
+    { 0x47D, 0x47D, 1, 0x47D },
+    { 0x47E, 0x47E, 1, 0x47F },
+    { 0x47F, 0x47F, 1, 0x47F },
+    { 0x480, 0x480, 1, 0x481 },
+    { 0x481, 0x481, 1, 0x481 },
+    { 0x483, 0x489, 1, 0x483 },
+    { 0x48A, 0x48A, 1, 0x48B },
+    { 0x48B, 0x48B, 1, 0x48B },
+    { 0x48C, 0x48C, 1, 0x48D },
+    { 0x48D, 0x48D, 1, 0x48D },
+    { 0x48E, 0x48E, 1, 0x48F },
+    { 0x48F, 0x48F, 1, 0x48F },
+    { 0x490, 0x490, 1, 0x491 },
+    { 0x491, 0x491, 1, 0x491 },
+    { 0x492, 0x492, 1, 0x493 },
+    { 0x493, 0x493, 1, 0x493 },
+    { 0x494, 0x494, 1, 0x495 },
+    { 0x495, 0x495, 1, 0x495 },
+    { 0x496, 0x496, 1, 0x497 },
+    { 0x497, 0x497, 1, 0x497 },
+    { 0x498, 0x498, 1, 0x499 },
+    { 0x499, 0x499, 1, 0x499 },
+    { 0x49A, 0x49A, 1, 0x49B },
+    { 0x49B, 0x49B, 1, 0x49B },
+    { 0x49C, 0x49C, 1, 0x49D },
+    { 0x49D, 0x49D, 1, 0x49D },
+    { 0x49E, 0x49E, 1, 0x49F },
+    { 0x49F, 0x49F, 1, 0x49F },
+    { 0x4A0, 0x4A0, 1, 0x4A1 },
+    { 0x4A1, 0x4A1, 1, 0x4A1 },
+    { 0x4A2, 0x4A2, 1, 0x4A3 },
+    { 0x4A3, 0x4A3, 1, 0x4A3 },
+    { 0x4A4, 0x4A4, 1, 0x4A5 },
+    { 0x4A5, 0x4A5, 1, 0x4A5 },
+    { 0x4A6, 0x4A6, 1, 0x4A7 },
+    { 0x4A7, 0x4A7, 1, 0x4A7 },
+    { 0x4A8, 0x4A8, 1, 0x4A9 },
+    { 0x4A9, 0x4A9, 1, 0x4A9 },
+    { 0x4AA, 0x4AA, 1, 0x4AB },
+    { 0x4AB, 0x4AB, 1, 0x4AB },
+    { 0x4AC, 0x4AC, 1, 0x4AD },
+    { 0x4AD, 0x4AD, 1, 0x4AD },
+    { 0x4AE, 0x4AE, 1, 0x4AF },
+    { 0x4AF, 0x4AF, 1, 0x4AF },
+    { 0x4B0, 0x4B0, 1, 0x4B1 },
+    { 0x4B1, 0x4B1, 1, 0x4B1 },
+    { 0x4B2, 0x4B2, 1, 0x4B3 },
+    { 0x4B3, 0x4B3, 1, 0x4B3 },
+    { 0x4B4, 0x4B4, 1, 0x4B5 },
+    { 0x4B5, 0x4B5, 1, 0x4B5 },
+    { 0x4B6, 0x4B6, 1, 0x4B7 },
+    { 0x4B7, 0x4B7, 1, 0x4B7 },
+    { 0x4B8, 0x4B8, 1, 0x4B9 },
+    { 0x4B9, 0x4B9, 1, 0x4B9 },
+    { 0x4BA, 0x4BA, 1, 0x4BB },
+    { 0x4BB, 0x4BB, 1, 0x4BB },
+    { 0x4BC, 0x4BC, 1, 0x4BD },
+    { 0x4BD, 0x4BD, 1, 0x4BD },
+    { 0x4BE, 0x4BE, 1, 0x4BF },
+    { 0x4BF, 0x4BF, 1, 0x4BF },
+    { 0x4C0, 0x4C0, 1, 0x4CF },
+    { 0x4C1, 0x4C1, 1, 0x4C2 },
+    { 0x4C2, 0x4C2, 1, 0x4C2 },
+    { 0x4C3, 0x4C3, 1, 0x4C4 },
+    { 0x4C4, 0x4C4, 1, 0x4C4 },
+    { 0x4C5, 0x4C5, 1, 0x4C6 },
+    { 0x4C6, 0x4C6, 1, 0x4C6 },
+    { 0x4C7, 0x4C7, 1, 0x4C8 },
+    { 0x4C8, 0x4C8, 1, 0x4C8 },
+    { 0x4C9, 0x4C9, 1, 0x4CA },
+    { 0x4CA, 0x4CA, 1, 0x4CA },
+    { 0x4CB, 0x4CB, 1, 0x4CC },
+    { 0x4CC, 0x4CC, 1, 0x4CC },
+    { 0x4CD, 0x4CD, 1, 0x4CE },
+    { 0x4CE, 0x4CF, 1, 0x4CE },
+    { 0x4D0, 0x4D0, 1, 0x4D1 },
+    { 0x4D1, 0x4D1, 1, 0x4D1 },
+    { 0x4D2, 0x4D2, 1, 0x4D3 },
+    { 0x4D3, 0x4D3, 1, 0x4D3 },
+    { 0x4D4, 0x4D4, 1, 0x4D5 },
+    { 0x4D5, 0x4D5, 1, 0x4D5 },
+    { 0x4D6, 0x4D6, 1, 0x4D7 },
+    { 0x4D7, 0x4D7, 1, 0x4D7 },
+    { 0x4D8, 0x4D8, 1, 0x4D9 },
+    { 0x4D9, 0x4D9, 1, 0x4D9 },
+    { 0x4DA, 0x4DA, 1, 0x4DB },
+    { 0x4DB, 0x4DB, 1, 0x4DB },
+    { 0x4DC, 0x4DC, 1, 0x4DD },
+    { 0x4DD, 0x4DD, 1, 0x4DD },
+    { 0x4DE, 0x4DE, 1, 0x4DF },
+    { 0x4DF, 0x4DF, 1, 0x4DF },
+    { 0x4E0, 0x4E0, 1, 0x4E1 },
+    { 0x4E1, 0x4E1, 1, 0x4E1 },
+    { 0x4E2, 0x4E2, 1, 0x4E3 },
+    { 0x4E3, 0x4E3, 1, 0x4E3 },
+    { 0x4E4, 0x4E4, 1, 0x4E5 },
+    { 0x4E5, 0x4E5, 1, 0x4E5 },
+    { 0x4E6, 0x4E6, 1, 0x4E7 },
+    { 0x4E7, 0x4E7, 1, 0x4E7 },
+    { 0x4E8, 0x4E8, 1, 0x4E9 },
+    { 0x4E9, 0x4E9, 1, 0x4E9 },
+    { 0x4EA, 0x4EA, 1, 0x4EB },
+    { 0x4EB, 0x4EB, 1, 0x4EB },
+    { 0x4EC, 0x4EC, 1, 0x4ED },
+    { 0x4ED, 0x4ED, 1, 0x4ED },
+    { 0x4EE, 0x4EE, 1, 0x4EF },
+    { 0x4EF, 0x4EF, 1, 0x4EF },
+    { 0x4F0, 0x4F0, 1, 0x4F1 },
+    { 0x4F1, 0x4F1, 1, 0x4F1 },
+    { 0x4F2, 0x4F2, 1, 0x4F3 },
+    { 0x4F3, 0x4F3, 1, 0x4F3 },
+    { 0x4F4, 0x4F4, 1, 0x4F5 },
+    { 0x4F5, 0x4F5, 1, 0x4F5 },
+    { 0x4F6, 0x4F6, 1, 0x4F7 },
+    { 0x4F7, 0x4F7, 1, 0x4F7 },
+    { 0x4F8, 0x4F8, 1, 0x4F9 },
+    { 0x4F9, 0x4F9, 1, 0x4F9 },
+    { 0x4FA, 0x4FA, 1, 0x4FB },
+    { 0x4FB, 0x4FB, 1, 0x4FB },
+    { 0x4FC, 0x4FC, 1, 0x4FD },
+    { 0x4FD, 0x4FD, 1, 0x4FD },
+    { 0x4FE, 0x4FE, 1, 0x4FF },
+    { 0x4FF, 0x4FF, 1, 0x4FF },
+    { 0x500, 0x500, 1, 0x501 },
+    { 0x501, 0x501, 1, 0x501 },
+    { 0x502, 0x502, 1, 0x503 },
+    { 0x503, 0x503, 1, 0x503 },
+    { 0x504, 0x504, 1, 0x505 },
+    { 0x505, 0x505, 1, 0x505 },
+    { 0x506, 0x506, 1, 0x507 },
+    { 0x507, 0x507, 1, 0x507 },
+    { 0x508, 0x508, 1, 0x509 },
+    { 0x509, 0x509, 1, 0x509 },
+    { 0x50A, 0x50A, 1, 0x50B },
+    { 0x50B, 0x50B, 1, 0x50B },
+    { 0x50C, 0x50C, 1, 0x50D },
+    { 0x50D, 0x50D, 1, 0x50D },
+    { 0x50E, 0x50E, 1, 0x50F },
+    { 0x50F, 0x50F, 1, 0x50F },
+    { 0x510, 0x510, 1, 0x511 },
+    { 0x511, 0x511, 1, 0x511 },
+    { 0x512, 0x512, 1, 0x513 },
+    { 0x513, 0x513, 1, 0x513 },
+    { 0x514, 0x514, 1, 0x515 },
+    { 0x515, 0x515, 1, 0x515 },
+    { 0x516, 0x516, 1, 0x517 },
+    { 0x517, 0x517, 1, 0x517 },
+    { 0x518, 0x518, 1, 0x519 },
+    { 0x519, 0x519, 1, 0x519 },
+    { 0x51A, 0x51A, 1, 0x51B },
+    { 0x51B, 0x51B, 1, 0x51B },
+    { 0x51C, 0x51C, 1, 0x51D },
+    { 0x51D, 0x51D, 1, 0x51D },
+    { 0x51E, 0x51E, 1, 0x51F },
+    { 0x51F, 0x51F, 1, 0x51F },
+    { 0x520, 0x520, 1, 0x521 },
+    { 0x521, 0x521, 1, 0x521 },
+    { 0x522, 0x522, 1, 0x523 },
+    { 0x523, 0x523, 1, 0x523 },
+    { 0x524, 0x524, 1, 0x525 },
+    { 0x525, 0x525, 1, 0x525 },
+    { 0x526, 0x526, 1, 0x527 },
+    { 0x527, 0x527, 1, 0x527 },
+    { 0x528, 0x528, 1, 0x529 },
+    { 0x529, 0x529, 1, 0x529 },
+    { 0x52A, 0x52A, 1, 0x52B },
+    { 0x52B, 0x52B, 1, 0x52B },
+    { 0x52C, 0x52C, 1, 0x52D },
+    { 0x52D, 0x52D, 1, 0x52D },
+    { 0x52E, 0x52E, 1, 0x52F },
+    { 0x52F, 0x52F, 1, 0x52F },
+    { 0x531, 0x556, 1, 0x561 },
+    { 0x559, 0x559, 1, 0x559 },
+    { 0x560, 0x588, 1, 0x560 },
+    { 0x591, 0x5BD, 1, 0x591 },
+    { 0x5BF, 0x5BF, 1, 0x5BF },
+    { 0x5C1, 0x5C2, 1, 0x5C1 },
+    { 0x5C4, 0x5C5, 1, 0x5C4 },
+    { 0x5C7, 0x5C7, 1, 0x5C7 },
+    { 0x5D0, 0x5EA, 1, 0x5D0 },
+    { 0x5EF, 0x5F2, 1, 0x5EF },
+    { 0x610, 0x61A, 1, 0x610 },
+    { 0x620, 0x669, 1, 0x620 },
+    { 0x66E, 0x6D3, 1, 0x66E },
+    { 0x6D5, 0x6DC, 1, 0x6D5 },
+    { 0x6DF, 0x6E8, 1, 0x6DF },
+    { 0x6EA, 0x6FC, 1, 0x6EA },
+    { 0x6FF, 0x6FF, 1, 0x6FF },
+    { 0x710, 0x74A, 1, 0x710 },
+    { 0x74D, 0x7B1, 1, 0x74D },
+    { 0x7C0, 0x7F5, 1, 0x7C0 },
+    { 0x7FA, 0x7FA, 1, 0x7FA },
+    { 0x7FD, 0x7FD, 1, 0x7FD },
+    { 0x800, 0x82D, 1, 0x800 },
+    { 0x840, 0x85B, 1, 0x840 },
+    { 0x860, 0x86A, 1, 0x860 },
+    { 0x870, 0x887, 1, 0x870 },
+    { 0x889, 0x88E, 1, 0x889 },
+    { 0x898, 0x8E1, 1, 0x898 },
+    { 0x8E3, 0x963, 1, 0x8E3 },
+    { 0x966, 0x96F, 1, 0x966 },
+    { 0x971, 0x983, 1, 0x971 },
+    { 0x985, 0x98C, 1, 0x985 },
+    { 0x98F, 0x990, 1, 0x98F },
+    { 0x993, 0x9A8, 1, 0x993 },
+    { 0x9AA, 0x9B0, 1, 0x9AA },
+    { 0x9B2, 0x9B2, 1, 0x9B2 },
+    { 0x9B6, 0x9B9, 1, 0x9B6 },
+    { 0x9BC, 0x9C4, 1, 0x9BC },
+    { 0x9C7, 0x9C8, 1, 0x9C7 },
+    { 0x9CB, 0x9CE, 1, 0x9CB },
+    { 0x9D7, 0x9D7, 1, 0x9D7 },
+    { 0x9DC, 0x9DD, 1, 0x9DC },
+    { 0x9DF, 0x9E3, 1, 0x9DF },
+    { 0x9E6, 0x9F1, 1, 0x9E6 },
+    { 0x9FC, 0x9FC, 1, 0x9FC },
+    { 0x9FE, 0x9FE, 1, 0x9FE },
+    { 0xA01, 0xA03, 1, 0xA01 },
+    { 0xA05, 0xA0A, 1, 0xA05 },
+    { 0xA0F, 0xA10, 1, 0xA0F },
+    { 0xA13, 0xA28, 1, 0xA13 },
+    { 0xA2A, 0xA30, 1, 0xA2A },
+    { 0xA32, 0xA33, 1, 0xA32 },
+    { 0xA35, 0xA36, 1, 0xA35 },
+    { 0xA38, 0xA39, 1, 0xA38 },
+    { 0xA3C, 0xA3C, 1, 0xA3C },
+    { 0xA3E, 0xA42, 1, 0xA3E },
+    { 0xA47, 0xA48, 1, 0xA47 },
+    { 0xA4B, 0xA4D, 1, 0xA4B },
+    { 0xA51, 0xA51, 1, 0xA51 },
+    { 0xA59, 0xA5C, 1, 0xA59 },
+    { 0xA5E, 0xA5E, 1, 0xA5E },
+    { 0xA66, 0xA75, 1, 0xA66 },
+    { 0xA81, 0xA83, 1, 0xA81 },
+    { 0xA85, 0xA8D, 1, 0xA85 },
+    { 0xA8F, 0xA91, 1, 0xA8F },
+    { 0xA93, 0xAA8, 1, 0xA93 },
+    { 0xAAA, 0xAB0, 1, 0xAAA },
+    { 0xAB2, 0xAB3, 1, 0xAB2 },
+    { 0xAB5, 0xAB9, 1, 0xAB5 },
+    { 0xABC, 0xAC5, 1, 0xABC },
+    { 0xAC7, 0xAC9, 1, 0xAC7 },
+    { 0xACB, 0xACD, 1, 0xACB },
+    { 0xAD0, 0xAD0, 1, 0xAD0 },
+    { 0xAE0, 0xAE3, 1, 0xAE0 },
+    { 0xAE6, 0xAEF, 1, 0xAE6 },
+    { 0xAF9, 0xAFF, 1, 0xAF9 },
+    { 0xB01, 0xB03, 1, 0xB01 },
+    { 0xB05, 0xB0C, 1, 0xB05 },
+    { 0xB0F, 0xB10, 1, 0xB0F },
+    { 0xB13, 0xB28, 1, 0xB13 },
+    { 0xB2A, 0xB30, 1, 0xB2A },
+    { 0xB32, 0xB33, 1, 0xB32 },
+    { 0xB35, 0xB39, 1, 0xB35 },
+    { 0xB3C, 0xB44, 1, 0xB3C },
+    { 0xB47, 0xB48, 1, 0xB47 },
+    { 0xB4B, 0xB4D, 1, 0xB4B },
+    { 0xB55, 0xB57, 1, 0xB55 },
+    { 0xB5C, 0xB5D, 1, 0xB5C },
+    { 0xB5F, 0xB63, 1, 0xB5F },
+    { 0xB66, 0xB6F, 1, 0xB66 },
+    { 0xB71, 0xB71, 1, 0xB71 },
+    { 0xB82, 0xB83, 1, 0xB82 },
+    { 0xB85, 0xB8A, 1, 0xB85 },
+    { 0xB8E, 0xB90, 1, 0xB8E },
+    { 0xB92, 0xB95, 1, 0xB92 },
+    { 0xB99, 0xB9A, 1, 0xB99 },
+    { 0xB9C, 0xB9C, 1, 0xB9C },
+    { 0xB9E, 0xB9F, 1, 0xB9E },
+    { 0xBA3, 0xBA4, 1, 0xBA3 },
+    { 0xBA8, 0xBAA, 1, 0xBA8 },
+    { 0xBAE, 0xBB9, 1, 0xBAE },
+    { 0xBBE, 0xBC2, 1, 0xBBE },
+    { 0xBC6, 0xBC8, 1, 0xBC6 },
+    { 0xBCA, 0xBCD, 1, 0xBCA },
+    { 0xBD0, 0xBD0, 1, 0xBD0 },
+    { 0xBD7, 0xBD7, 1, 0xBD7 },
+    { 0xBE6, 0xBEF, 1, 0xBE6 },
+    { 0xC00, 0xC0C, 1, 0xC00 },
+    { 0xC0E, 0xC10, 1, 0xC0E },
+    { 0xC12, 0xC28, 1, 0xC12 },
+    { 0xC2A, 0xC39, 1, 0xC2A },
+    { 0xC3C, 0xC44, 1, 0xC3C },
+    { 0xC46, 0xC48, 1, 0xC46 },
+    { 0xC4A, 0xC4D, 1, 0xC4A },
+    { 0xC55, 0xC56, 1, 0xC55 },
+    { 0xC58, 0xC5A, 1, 0xC58 },
+    { 0xC5D, 0xC5D, 1, 0xC5D },
+    { 0xC60, 0xC63, 1, 0xC60 },
+    { 0xC66, 0xC6F, 1, 0xC66 },
+    { 0xC80, 0xC83, 1, 0xC80 },
+    { 0xC85, 0xC8C, 1, 0xC85 },
+    { 0xC8E, 0xC90, 1, 0xC8E },
+    { 0xC92, 0xCA8, 1, 0xC92 },
+    { 0xCAA, 0xCB3, 1, 0xCAA },
+    { 0xCB5, 0xCB9, 1, 0xCB5 },
+    { 0xCBC, 0xCC4, 1, 0xCBC },
+    { 0xCC6, 0xCC8, 1, 0xCC6 },
+    { 0xCCA, 0xCCD, 1, 0xCCA },
+    { 0xCD5, 0xCD6, 1, 0xCD5 },
+    { 0xCDD, 0xCDE, 1, 0xCDD },
+    { 0xCE0, 0xCE3, 1, 0xCE0 },
+    { 0xCE6, 0xCEF, 1, 0xCE6 },
+    { 0xCF1, 0xCF2, 1, 0xCF1 },
+    { 0xD00, 0xD0C, 1, 0xD00 },
+    { 0xD0E, 0xD10, 1, 0xD0E },
+    { 0xD12, 0xD44, 1, 0xD12 },
+    { 0xD46, 0xD48, 1, 0xD46 },
+    { 0xD4A, 0xD4E, 1, 0xD4A },
+    { 0xD54, 0xD57, 1, 0xD54 },
+    { 0xD5F, 0xD63, 1, 0xD5F },
+    { 0xD66, 0xD6F, 1, 0xD66 },
+    { 0xD7A, 0xD7F, 1, 0xD7A },
+    { 0xD81, 0xD83, 1, 0xD81 },
+    { 0xD85, 0xD96, 1, 0xD85 },
+    { 0xD9A, 0xDB1, 1, 0xD9A },
+    { 0xDB3, 0xDBB, 1, 0xDB3 },
+    { 0xDBD, 0xDBD, 1, 0xDBD },
+    { 0xDC0, 0xDC6, 1, 0xDC0 },
+    { 0xDCA, 0xDCA, 1, 0xDCA },
+    { 0xDCF, 0xDD4, 1, 0xDCF },
+    { 0xDD6, 0xDD6, 1, 0xDD6 },
+    { 0xDD8, 0xDDF, 1, 0xDD8 },
+    { 0xDE6, 0xDEF, 1, 0xDE6 },
+    { 0xDF2, 0xDF3, 1, 0xDF2 },
+    { 0xE01, 0xE3A, 1, 0xE01 },
+    { 0xE40, 0xE4E, 1, 0xE40 },
+    { 0xE50, 0xE59, 1, 0xE50 },
+    { 0xE81, 0xE82, 1, 0xE81 },
+    { 0xE84, 0xE84, 1, 0xE84 },
+    { 0xE86, 0xE8A, 1, 0xE86 },
+    { 0xE8C, 0xEA3, 1, 0xE8C },
+    { 0xEA5, 0xEA5, 1, 0xEA5 },
+    { 0xEA7, 0xEBD, 1, 0xEA7 },
+    { 0xEC0, 0xEC4, 1, 0xEC0 },
+    { 0xEC6, 0xEC6, 1, 0xEC6 },
+    { 0xEC8, 0xECD, 1, 0xEC8 },
+    { 0xED0, 0xED9, 1, 0xED0 },
+    { 0xEDC, 0xEDF, 1, 0xEDC },
+    { 0xF00, 0xF00, 1, 0xF00 },
+    { 0xF18, 0xF19, 1, 0xF18 },
+    { 0xF20, 0xF29, 1, 0xF20 },
+    { 0xF35, 0xF35, 1, 0xF35 },
+    { 0xF37, 0xF37, 1, 0xF37 },
+    { 0xF39, 0xF39, 1, 0xF39 },
+    { 0xF3E, 0xF47, 1, 0xF3E },
+    { 0xF49, 0xF6C, 1, 0xF49 },
+    { 0xF71, 0xF84, 1, 0xF71 },
+    { 0xF86, 0xF97, 1, 0xF86 },
+    { 0xF99, 0xFBC, 1, 0xF99 },
+    { 0xFC6, 0xFC6, 1, 0xFC6 },
+    { 0x1000, 0x1049, 1, 0x1000 },
+    { 0x1050, 0x109D, 1, 0x1050 },
+    { 0x10A0, 0x10C5, 1, 0x2D00 },
+    { 0x10C7, 0x10C7, 1, 0x2D27 },
+    { 0x10CD, 0x10CD, 1, 0x2D2D },
+    { 0x10D0, 0x10FA, 1, 0x10D0 },
+    { 0x10FC, 0x1248, 1, 0x10FC },
+    { 0x124A, 0x124D, 1, 0x124A },
+    { 0x1250, 0x1256, 1, 0x1250 },
+    { 0x1258, 0x1258, 1, 0x1258 },
+    { 0x125A, 0x125D, 1, 0x125A },
+    { 0x1260, 0x1288, 1, 0x1260 },
+    { 0x128A, 0x128D, 1, 0x128A },
+    { 0x1290, 0x12B0, 1, 0x1290 },
+    { 0x12B2, 0x12B5, 1, 0x12B2 },
+    { 0x12B8, 0x12BE, 1, 0x12B8 },
+    { 0x12C0, 0x12C0, 1, 0x12C0 },
+    { 0x12C2, 0x12C5, 1, 0x12C2 },
+    { 0x12C8, 0x12D6, 1, 0x12C8 },
+    { 0x12D8, 0x1310, 1, 0x12D8 },
+    { 0x1312, 0x1315, 1, 0x1312 },
+    { 0x1318, 0x135A, 1, 0x1318 },
+    { 0x135D, 0x135F, 1, 0x135D },
+    { 0x1380, 0x138F, 1, 0x1380 },
+    { 0x13A0, 0x13F5, 1, 0x13A0 },
+    { 0x13F8, 0x13FD, 1, 0x13F0 },
+    { 0x1401, 0x166C, 1, 0x1401 },
+    { 0x166F, 0x167F, 1, 0x166F },
+    { 0x1680, 0x1680, -1, 0x0 },
+    { 0x1681, 0x169A, 1, 0x1681 },
+    { 0x16A0, 0x16EA, 1, 0x16A0 },
+    { 0x16EE, 0x16F8, 1, 0x16EE },
+    { 0x1700, 0x1715, 1, 0x1700 },
+    { 0x171F, 0x1734, 1, 0x171F },
+    { 0x1740, 0x1753, 1, 0x1740 },
+    { 0x1760, 0x176C, 1, 0x1760 },
+    { 0x176E, 0x1770, 1, 0x176E },
+    { 0x1772, 0x1773, 1, 0x1772 },
+    { 0x1780, 0x17D3, 1, 0x1780 },
+    { 0x17D7, 0x17D7, 1, 0x17D7 },
+    { 0x17DC, 0x17DD, 1, 0x17DC },
+    { 0x17E0, 0x17E9, 1, 0x17E0 },
+    { 0x180B, 0x180D, 1, 0x180B },
+    { 0x180F, 0x1819, 1, 0x180F },
+    { 0x1820, 0x1878, 1, 0x1820 },
+    { 0x1880, 0x18AA, 1, 0x1880 },
+    { 0x18B0, 0x18F5, 1, 0x18B0 },
+    { 0x1900, 0x191E, 1, 0x1900 },
+    { 0x1920, 0x192B, 1, 0x1920 },
+    { 0x1930, 0x193B, 1, 0x1930 },
+    { 0x1946, 0x196D, 1, 0x1946 },
+    { 0x1970, 0x1974, 1, 0x1970 },
+    { 0x1980, 0x19AB, 1, 0x1980 },
+    { 0x19B0, 0x19C9, 1, 0x19B0 },
+    { 0x19D0, 0x19D9, 1, 0x19D0 },
+    { 0x1A00, 0x1A1B, 1, 0x1A00 },
+    { 0x1A20, 0x1A5E, 1, 0x1A20 },
+    { 0x1A60, 0x1A7C, 1, 0x1A60 },
+    { 0x1A7F, 0x1A89, 1, 0x1A7F },
+    { 0x1A90, 0x1A99, 1, 0x1A90 },
+    { 0x1AA7, 0x1AA7, 1, 0x1AA7 },
+    { 0x1AB0, 0x1ACE, 1, 0x1AB0 },
+    { 0x1B00, 0x1B4C, 1, 0x1B00 },
+    { 0x1B50, 0x1B59, 1, 0x1B50 },
+    { 0x1B6B, 0x1B73, 1, 0x1B6B },
+    { 0x1B80, 0x1BF3, 1, 0x1B80 },
+    { 0x1C00, 0x1C37, 1, 0x1C00 },
+    { 0x1C40, 0x1C49, 1, 0x1C40 },
+    { 0x1C4D, 0x1C7D, 1, 0x1C4D },
+    { 0x1C80, 0x1C80, 1, 0x432 },
+    { 0x1C81, 0x1C81, 1, 0x434 },
+    { 0x1C82, 0x1C82, 1, 0x43E },
+    { 0x1C83, 0x1C84, 1, 0x441 },
+    { 0x1C85, 0x1C85, 1, 0x442 },
+    { 0x1C86, 0x1C86, 1, 0x44A },
+    { 0x1C87, 0x1C87, 1, 0x463 },
+    { 0x1C88, 0x1C88, 1, 0xA64B },
+    { 0x1C90, 0x1CBA, 1, 0x10D0 },
+    { 0x1CBD, 0x1CBF, 1, 0x10FD },
+    { 0x1CD0, 0x1CD2, 1, 0x1CD0 },
+    { 0x1CD4, 0x1CFA, 1, 0x1CD4 },
+    { 0x1D00, 0x1DFF, 1, 0x1D00 },
+    { 0x1E00, 0x1E00, 1, 0x1E01 },
+    { 0x1E01, 0x1E01, 1, 0x1E01 },
+    { 0x1E02, 0x1E02, 1, 0x1E03 },
+    { 0x1E03, 0x1E03, 1, 0x1E03 },
+    { 0x1E04, 0x1E04, 1, 0x1E05 },
+    { 0x1E05, 0x1E05, 1, 0x1E05 },
+    { 0x1E06, 0x1E06, 1, 0x1E07 },
+    { 0x1E07, 0x1E07, 1, 0x1E07 },
+    { 0x1E08, 0x1E08, 1, 0x1E09 },
+    { 0x1E09, 0x1E09, 1, 0x1E09 },
+    { 0x1E0A, 0x1E0A, 1, 0x1E0B },
+    { 0x1E0B, 0x1E0B, 1, 0x1E0B },
+    { 0x1E0C, 0x1E0C, 1, 0x1E0D },
+    { 0x1E0D, 0x1E0D, 1, 0x1E0D },
+    { 0x1E0E, 0x1E0E, 1, 0x1E0F },
+    { 0x1E0F, 0x1E0F, 1, 0x1E0F },
+    { 0x1E10, 0x1E10, 1, 0x1E11 },
+    { 0x1E11, 0x1E11, 1, 0x1E11 },
+    { 0x1E12, 0x1E12, 1, 0x1E13 },
+    { 0x1E13, 0x1E13, 1, 0x1E13 },
+    { 0x1E14, 0x1E14, 1, 0x1E15 },
+    { 0x1E15, 0x1E15, 1, 0x1E15 },
+    { 0x1E16, 0x1E16, 1, 0x1E17 },
+    { 0x1E17, 0x1E17, 1, 0x1E17 },
+    { 0x1E18, 0x1E18, 1, 0x1E19 },
+    { 0x1E19, 0x1E19, 1, 0x1E19 },
+    { 0x1E1A, 0x1E1A, 1, 0x1E1B },
+    { 0x1E1B, 0x1E1B, 1, 0x1E1B },
+    { 0x1E1C, 0x1E1C, 1, 0x1E1D },
+    { 0x1E1D, 0x1E1D, 1, 0x1E1D },
+    { 0x1E1E, 0x1E1E, 1, 0x1E1F },
+    { 0x1E1F, 0x1E1F, 1, 0x1E1F },
+    { 0x1E20, 0x1E20, 1, 0x1E21 },
+    { 0x1E21, 0x1E21, 1, 0x1E21 },
+    { 0x1E22, 0x1E22, 1, 0x1E23 },
+    { 0x1E23, 0x1E23, 1, 0x1E23 },
+    { 0x1E24, 0x1E24, 1, 0x1E25 },
+    { 0x1E25, 0x1E25, 1, 0x1E25 },
+    { 0x1E26, 0x1E26, 1, 0x1E27 },
+    { 0x1E27, 0x1E27, 1, 0x1E27 },
+    { 0x1E28, 0x1E28, 1, 0x1E29 },
+    { 0x1E29, 0x1E29, 1, 0x1E29 },
+    { 0x1E2A, 0x1E2A, 1, 0x1E2B },
+    { 0x1E2B, 0x1E2B, 1, 0x1E2B },
+    { 0x1E2C, 0x1E2C, 1, 0x1E2D },
+    { 0x1E2D, 0x1E2D, 1, 0x1E2D },
+    { 0x1E2E, 0x1E2E, 1, 0x1E2F },
+    { 0x1E2F, 0x1E2F, 1, 0x1E2F },
+    { 0x1E30, 0x1E30, 1, 0x1E31 },
+    { 0x1E31, 0x1E31, 1, 0x1E31 },
+    { 0x1E32, 0x1E32, 1, 0x1E33 },
+    { 0x1E33, 0x1E33, 1, 0x1E33 },
+    { 0x1E34, 0x1E34, 1, 0x1E35 },
+    { 0x1E35, 0x1E35, 1, 0x1E35 },
+    { 0x1E36, 0x1E36, 1, 0x1E37 },
+    { 0x1E37, 0x1E37, 1, 0x1E37 },
+    { 0x1E38, 0x1E38, 1, 0x1E39 },
+    { 0x1E39, 0x1E39, 1, 0x1E39 },
+    { 0x1E3A, 0x1E3A, 1, 0x1E3B },
+    { 0x1E3B, 0x1E3B, 1, 0x1E3B },
+    { 0x1E3C, 0x1E3C, 1, 0x1E3D },
+    { 0x1E3D, 0x1E3D, 1, 0x1E3D },
+    { 0x1E3E, 0x1E3E, 1, 0x1E3F },
+    { 0x1E3F, 0x1E3F, 1, 0x1E3F },
+    { 0x1E40, 0x1E40, 1, 0x1E41 },
+    { 0x1E41, 0x1E41, 1, 0x1E41 },
+    { 0x1E42, 0x1E42, 1, 0x1E43 },
+    { 0x1E43, 0x1E43, 1, 0x1E43 },
+    { 0x1E44, 0x1E44, 1, 0x1E45 },
+    { 0x1E45, 0x1E45, 1, 0x1E45 },
+    { 0x1E46, 0x1E46, 1, 0x1E47 },
+    { 0x1E47, 0x1E47, 1, 0x1E47 },
+    { 0x1E48, 0x1E48, 1, 0x1E49 },
+    { 0x1E49, 0x1E49, 1, 0x1E49 },
+    { 0x1E4A, 0x1E4A, 1, 0x1E4B },
+    { 0x1E4B, 0x1E4B, 1, 0x1E4B },
+    { 0x1E4C, 0x1E4C, 1, 0x1E4D },
+    { 0x1E4D, 0x1E4D, 1, 0x1E4D },
+    { 0x1E4E, 0x1E4E, 1, 0x1E4F },
+    { 0x1E4F, 0x1E4F, 1, 0x1E4F },
+    { 0x1E50, 0x1E50, 1, 0x1E51 },
+    { 0x1E51, 0x1E51, 1, 0x1E51 },
+    { 0x1E52, 0x1E52, 1, 0x1E53 },
+    { 0x1E53, 0x1E53, 1, 0x1E53 },
+    { 0x1E54, 0x1E54, 1, 0x1E55 },
+    { 0x1E55, 0x1E55, 1, 0x1E55 },
+    { 0x1E56, 0x1E56, 1, 0x1E57 },
+    { 0x1E57, 0x1E57, 1, 0x1E57 },
+    { 0x1E58, 0x1E58, 1, 0x1E59 },
+    { 0x1E59, 0x1E59, 1, 0x1E59 },
+    { 0x1E5A, 0x1E5A, 1, 0x1E5B },
+    { 0x1E5B, 0x1E5B, 1, 0x1E5B },
+    { 0x1E5C, 0x1E5C, 1, 0x1E5D },
+    { 0x1E5D, 0x1E5D, 1, 0x1E5D },
+    { 0x1E5E, 0x1E5E, 1, 0x1E5F },
+    { 0x1E5F, 0x1E5F, 1, 0x1E5F },
+    { 0x1E60, 0x1E60, 1, 0x1E61 },
+    { 0x1E61, 0x1E61, 1, 0x1E61 },
+    { 0x1E62, 0x1E62, 1, 0x1E63 },
+    { 0x1E63, 0x1E63, 1, 0x1E63 },
+    { 0x1E64, 0x1E64, 1, 0x1E65 },
+    { 0x1E65, 0x1E65, 1, 0x1E65 },
+    { 0x1E66, 0x1E66, 1, 0x1E67 },
+    { 0x1E67, 0x1E67, 1, 0x1E67 },
+    { 0x1E68, 0x1E68, 1, 0x1E69 },
+    { 0x1E69, 0x1E69, 1, 0x1E69 },
+    { 0x1E6A, 0x1E6A, 1, 0x1E6B },
+    { 0x1E6B, 0x1E6B, 1, 0x1E6B },
+    { 0x1E6C, 0x1E6C, 1, 0x1E6D },
+    { 0x1E6D, 0x1E6D, 1, 0x1E6D },
+    { 0x1E6E, 0x1E6E, 1, 0x1E6F },
+    { 0x1E6F, 0x1E6F, 1, 0x1E6F },
+    { 0x1E70, 0x1E70, 1, 0x1E71 },
+    { 0x1E71, 0x1E71, 1, 0x1E71 },
+    { 0x1E72, 0x1E72, 1, 0x1E73 },
+    { 0x1E73, 0x1E73, 1, 0x1E73 },
+    { 0x1E74, 0x1E74, 1, 0x1E75 },
+    { 0x1E75, 0x1E75, 1, 0x1E75 },
+    { 0x1E76, 0x1E76, 1, 0x1E77 },
+    { 0x1E77, 0x1E77, 1, 0x1E77 },
+    { 0x1E78, 0x1E78, 1, 0x1E79 },
+    { 0x1E79, 0x1E79, 1, 0x1E79 },
+    { 0x1E7A, 0x1E7A, 1, 0x1E7B },
+    { 0x1E7B, 0x1E7B, 1, 0x1E7B },
+    { 0x1E7C, 0x1E7C, 1, 0x1E7D },
+    { 0x1E7D, 0x1E7D, 1, 0x1E7D },
+    { 0x1E7E, 0x1E7E, 1, 0x1E7F },
+    { 0x1E7F, 0x1E7F, 1, 0x1E7F },
+    { 0x1E80, 0x1E80, 1, 0x1E81 },
+    { 0x1E81, 0x1E81, 1, 0x1E81 },
+    { 0x1E82, 0x1E82, 1, 0x1E83 },
+    { 0x1E83, 0x1E83, 1, 0x1E83 },
+    { 0x1E84, 0x1E84, 1, 0x1E85 },
+    { 0x1E85, 0x1E85, 1, 0x1E85 },
+    { 0x1E86, 0x1E86, 1, 0x1E87 },
+    { 0x1E87, 0x1E87, 1, 0x1E87 },
+    { 0x1E88, 0x1E88, 1, 0x1E89 },
+    { 0x1E89, 0x1E89, 1, 0x1E89 },
+    { 0x1E8A, 0x1E8A, 1, 0x1E8B },
+    { 0x1E8B, 0x1E8B, 1, 0x1E8B },
+    { 0x1E8C, 0x1E8C, 1, 0x1E8D },
+    { 0x1E8D, 0x1E8D, 1, 0x1E8D },
+    { 0x1E8E, 0x1E8E, 1, 0x1E8F },
+    { 0x1E8F, 0x1E8F, 1, 0x1E8F },
+    { 0x1E90, 0x1E90, 1, 0x1E91 },
+    { 0x1E91, 0x1E91, 1, 0x1E91 },
+    { 0x1E92, 0x1E92, 1, 0x1E93 },
+    { 0x1E93, 0x1E93, 1, 0x1E93 },
+    { 0x1E94, 0x1E94, 1, 0x1E95 },
+    { 0x1E95, 0x1E9A, 1, 0x1E95 },
+    { 0x1E9B, 0x1E9B, 1, 0x1E61 },
+    { 0x1E9C, 0x1E9D, 1, 0x1E9C },
+    { 0x1E9E, 0x1E9E, 1, 0xDF },
+    { 0x1E9F, 0x1E9F, 1, 0x1E9F },
+    { 0x1EA0, 0x1EA0, 1, 0x1EA1 },
+    { 0x1EA1, 0x1EA1, 1, 0x1EA1 },
+    { 0x1EA2, 0x1EA2, 1, 0x1EA3 },
+    { 0x1EA3, 0x1EA3, 1, 0x1EA3 },
+    { 0x1EA4, 0x1EA4, 1, 0x1EA5 },
+    { 0x1EA5, 0x1EA5, 1, 0x1EA5 },
+    { 0x1EA6, 0x1EA6, 1, 0x1EA7 },
+    { 0x1EA7, 0x1EA7, 1, 0x1EA7 },
+    { 0x1EA8, 0x1EA8, 1, 0x1EA9 },
+    { 0x1EA9, 0x1EA9, 1, 0x1EA9 },
+    { 0x1EAA, 0x1EAA, 1, 0x1EAB },
+    { 0x1EAB, 0x1EAB, 1, 0x1EAB },
+    { 0x1EAC, 0x1EAC, 1, 0x1EAD },
+    { 0x1EAD, 0x1EAD, 1, 0x1EAD },
+    { 0x1EAE, 0x1EAE, 1, 0x1EAF },
+    { 0x1EAF, 0x1EAF, 1, 0x1EAF },
+    { 0x1EB0, 0x1EB0, 1, 0x1EB1 },
+    { 0x1EB1, 0x1EB1, 1, 0x1EB1 },
+    { 0x1EB2, 0x1EB2, 1, 0x1EB3 },
+    { 0x1EB3, 0x1EB3, 1, 0x1EB3 },
+    { 0x1EB4, 0x1EB4, 1, 0x1EB5 },
+    { 0x1EB5, 0x1EB5, 1, 0x1EB5 },
+    { 0x1EB6, 0x1EB6, 1, 0x1EB7 },
+    { 0x1EB7, 0x1EB7, 1, 0x1EB7 },
+    { 0x1EB8, 0x1EB8, 1, 0x1EB9 },
+    { 0x1EB9, 0x1EB9, 1, 0x1EB9 },
+    { 0x1EBA, 0x1EBA, 1, 0x1EBB },
+    { 0x1EBB, 0x1EBB, 1, 0x1EBB },
+    { 0x1EBC, 0x1EBC, 1, 0x1EBD },
+    { 0x1EBD, 0x1EBD, 1, 0x1EBD },
+    { 0x1EBE, 0x1EBE, 1, 0x1EBF },
+    { 0x1EBF, 0x1EBF, 1, 0x1EBF },
+    { 0x1EC0, 0x1EC0, 1, 0x1EC1 },
+    { 0x1EC1, 0x1EC1, 1, 0x1EC1 },
+    { 0x1EC2, 0x1EC2, 1, 0x1EC3 },
+    { 0x1EC3, 0x1EC3, 1, 0x1EC3 },
+    { 0x1EC4, 0x1EC4, 1, 0x1EC5 },
+    { 0x1EC5, 0x1EC5, 1, 0x1EC5 },
+    { 0x1EC6, 0x1EC6, 1, 0x1EC7 },
+    { 0x1EC7, 0x1EC7, 1, 0x1EC7 },
+    { 0x1EC8, 0x1EC8, 1, 0x1EC9 },
+    { 0x1EC9, 0x1EC9, 1, 0x1EC9 },
+    { 0x1ECA, 0x1ECA, 1, 0x1ECB },
+    { 0x1ECB, 0x1ECB, 1, 0x1ECB },
+    { 0x1ECC, 0x1ECC, 1, 0x1ECD },
+    { 0x1ECD, 0x1ECD, 1, 0x1ECD },
+    { 0x1ECE, 0x1ECE, 1, 0x1ECF },
+    { 0x1ECF, 0x1ECF, 1, 0x1ECF },
+    { 0x1ED0, 0x1ED0, 1, 0x1ED1 },
+    { 0x1ED1, 0x1ED1, 1, 0x1ED1 },
+    { 0x1ED2, 0x1ED2, 1, 0x1ED3 },
+    { 0x1ED3, 0x1ED3, 1, 0x1ED3 },
+    { 0x1ED4, 0x1ED4, 1, 0x1ED5 },
+    { 0x1ED5, 0x1ED5, 1, 0x1ED5 },
+    { 0x1ED6, 0x1ED6, 1, 0x1ED7 },
+    { 0x1ED7, 0x1ED7, 1, 0x1ED7 },
+    { 0x1ED8, 0x1ED8, 1, 0x1ED9 },
+    { 0x1ED9, 0x1ED9, 1, 0x1ED9 },
+    { 0x1EDA, 0x1EDA, 1, 0x1EDB },
+    { 0x1EDB, 0x1EDB, 1, 0x1EDB },
+    { 0x1EDC, 0x1EDC, 1, 0x1EDD },
+    { 0x1EDD, 0x1EDD, 1, 0x1EDD },
+    { 0x1EDE, 0x1EDE, 1, 0x1EDF },
+    { 0x1EDF, 0x1EDF, 1, 0x1EDF },
+    { 0x1EE0, 0x1EE0, 1, 0x1EE1 },
+    { 0x1EE1, 0x1EE1, 1, 0x1EE1 },
+    { 0x1EE2, 0x1EE2, 1, 0x1EE3 },
+    { 0x1EE3, 0x1EE3, 1, 0x1EE3 },
+    { 0x1EE4, 0x1EE4, 1, 0x1EE5 },
+    { 0x1EE5, 0x1EE5, 1, 0x1EE5 },
+    { 0x1EE6, 0x1EE6, 1, 0x1EE7 },
+    { 0x1EE7, 0x1EE7, 1, 0x1EE7 },
+    { 0x1EE8, 0x1EE8, 1, 0x1EE9 },
+    { 0x1EE9, 0x1EE9, 1, 0x1EE9 },
+    { 0x1EEA, 0x1EEA, 1, 0x1EEB },
+    { 0x1EEB, 0x1EEB, 1, 0x1EEB },
+    { 0x1EEC, 0x1EEC, 1, 0x1EED },
+    { 0x1EED, 0x1EED, 1, 0x1EED },
+    { 0x1EEE, 0x1EEE, 1, 0x1EEF },
+    { 0x1EEF, 0x1EEF, 1, 0x1EEF },
+    { 0x1EF0, 0x1EF0, 1, 0x1EF1 },
+    { 0x1EF1, 0x1EF1, 1, 0x1EF1 },
+    { 0x1EF2, 0x1EF2, 1, 0x1EF3 },
+    { 0x1EF3, 0x1EF3, 1, 0x1EF3 },
+    { 0x1EF4, 0x1EF4, 1, 0x1EF5 },
+    { 0x1EF5, 0x1EF5, 1, 0x1EF5 },
+    { 0x1EF6, 0x1EF6, 1, 0x1EF7 },
+    { 0x1EF7, 0x1EF7, 1, 0x1EF7 },
+    { 0x1EF8, 0x1EF8, 1, 0x1EF9 },
+    { 0x1EF9, 0x1EF9, 1, 0x1EF9 },
+    { 0x1EFA, 0x1EFA, 1, 0x1EFB },
+    { 0x1EFB, 0x1EFB, 1, 0x1EFB },
+    { 0x1EFC, 0x1EFC, 1, 0x1EFD },
+    { 0x1EFD, 0x1EFD, 1, 0x1EFD },
+    { 0x1EFE, 0x1EFE, 1, 0x1EFF },
+    { 0x1EFF, 0x1F07, 1, 0x1EFF },
+    { 0x1F08, 0x1F0F, 1, 0x1F00 },
+    { 0x1F10, 0x1F15, 1, 0x1F10 },
+    { 0x1F18, 0x1F1D, 1, 0x1F10 },
+    { 0x1F20, 0x1F27, 1, 0x1F20 },
+    { 0x1F28, 0x1F2F, 1, 0x1F20 },
+    { 0x1F30, 0x1F37, 1, 0x1F30 },
+    { 0x1F38, 0x1F3F, 1, 0x1F30 },
+    { 0x1F40, 0x1F45, 1, 0x1F40 },
+    { 0x1F48, 0x1F4D, 1, 0x1F40 },
+    { 0x1F50, 0x1F57, 1, 0x1F50 },
+    { 0x1F59, 0x1F59, 1, 0x1F51 },
+    { 0x1F5B, 0x1F5B, 1, 0x1F53 },
+    { 0x1F5D, 0x1F5D, 1, 0x1F55 },
+    { 0x1F5F, 0x1F5F, 1, 0x1F57 },
+    { 0x1F60, 0x1F67, 1, 0x1F60 },
+    { 0x1F68, 0x1F6F, 1, 0x1F60 },
+    { 0x1F70, 0x1F7D, 1, 0x1F70 },
+    { 0x1F80, 0x1F87, 1, 0x1F80 },
+    { 0x1F88, 0x1F8F, 1, 0x1F80 },
+    { 0x1F90, 0x1F97, 1, 0x1F90 },
+    { 0x1F98, 0x1F9F, 1, 0x1F90 },
+    { 0x1FA0, 0x1FA7, 1, 0x1FA0 },
+    { 0x1FA8, 0x1FAF, 1, 0x1FA0 },
+    { 0x1FB0, 0x1FB4, 1, 0x1FB0 },
+    { 0x1FB6, 0x1FB7, 1, 0x1FB6 },
+    { 0x1FB8, 0x1FB9, 1, 0x1FB0 },
+    { 0x1FBA, 0x1FBB, 1, 0x1F70 },
+    { 0x1FBC, 0x1FBC, 1, 0x1FB3 },
+    { 0x1FBE, 0x1FBE, 1, 0x3B9 },
+    { 0x1FC2, 0x1FC4, 1, 0x1FC2 },
+    { 0x1FC6, 0x1FC7, 1, 0x1FC6 },
+    { 0x1FC8, 0x1FCB, 1, 0x1F72 },
+    { 0x1FCC, 0x1FCC, 1, 0x1FC3 },
+    { 0x1FD0, 0x1FD3, 1, 0x1FD0 },
+    { 0x1FD6, 0x1FD7, 1, 0x1FD6 },
+    { 0x1FD8, 0x1FD9, 1, 0x1FD0 },
+    { 0x1FDA, 0x1FDB, 1, 0x1F76 },
+    { 0x1FE0, 0x1FE7, 1, 0x1FE0 },
+    { 0x1FE8, 0x1FE9, 1, 0x1FE0 },
+    { 0x1FEA, 0x1FEB, 1, 0x1F7A },
+    { 0x1FEC, 0x1FEC, 1, 0x1FE5 },
+    { 0x1FF2, 0x1FF4, 1, 0x1FF2 },
+    { 0x1FF6, 0x1FF7, 1, 0x1FF6 },
+    { 0x1FF8, 0x1FF9, 1, 0x1F78 },
+    { 0x1FFA, 0x1FFB, 1, 0x1F7C },
+    { 0x1FFC, 0x1FFC, 1, 0x1FF3 },
+    { 0x2000, 0x200A, -1, 0x0 },
+    { 0x2028, 0x2029, -1, 0x0 },
+    { 0x202F, 0x202F, -1, 0x0 },
+    { 0x205F, 0x205F, -1, 0x0 },
+    { 0x2071, 0x2071, 1, 0x2071 },
+    { 0x207F, 0x207F, 1, 0x207F },
+    { 0x2090, 0x209C, 1, 0x2090 },
+    { 0x20D0, 0x20F0, 1, 0x20D0 },
+    { 0x2102, 0x2102, 1, 0x2102 },
+    { 0x2107, 0x2107, 1, 0x2107 },
+    { 0x210A, 0x2113, 1, 0x210A },
+    { 0x2115, 0x2115, 1, 0x2115 },
+    { 0x2119, 0x211D, 1, 0x2119 },
+    { 0x2124, 0x2124, 1, 0x2124 },
+    { 0x2126, 0x2126, 1, 0x3C9 },
+    { 0x2128, 0x2128, 1, 0x2128 },
+    { 0x212A, 0x212A, 1, 0x6B },
+    { 0x212B, 0x212B, 1, 0xE5 },
+    { 0x212C, 0x212D, 1, 0x212C },
+    { 0x212F, 0x2131, 1, 0x212F },
+    { 0x2132, 0x2132, 1, 0x214E },
+    { 0x2133, 0x2139, 1, 0x2133 },
+    { 0x213C, 0x213F, 1, 0x213C },
+    { 0x2145, 0x2149, 1, 0x2145 },
+    { 0x214E, 0x214E, 1, 0x214E },
+    { 0x2160, 0x216F, 1, 0x2170 },
+    { 0x2170, 0x2182, 1, 0x2170 },
+    { 0x2183, 0x2183, 1, 0x2184 },
+    { 0x2184, 0x2188, 1, 0x2184 },
+    { 0x24B6, 0x24CF, 1, 0x24D0 },
+    { 0x24D0, 0x24E9, 1, 0x24D0 },
+    { 0x2C00, 0x2C2F, 1, 0x2C30 },
+    { 0x2C30, 0x2C5F, 1, 0x2C30 },
+    { 0x2C60, 0x2C60, 1, 0x2C61 },
+    { 0x2C61, 0x2C61, 1, 0x2C61 },
+    { 0x2C62, 0x2C62, 1, 0x26B },
+    { 0x2C63, 0x2C63, 1, 0x1D7D },
+    { 0x2C64, 0x2C64, 1, 0x27D },
+    { 0x2C65, 0x2C66, 1, 0x2C65 },
+    { 0x2C67, 0x2C67, 1, 0x2C68 },
+    { 0x2C68, 0x2C68, 1, 0x2C68 },
+    { 0x2C69, 0x2C69, 1, 0x2C6A },
+    { 0x2C6A, 0x2C6A, 1, 0x2C6A },
+    { 0x2C6B, 0x2C6B, 1, 0x2C6C },
+    { 0x2C6C, 0x2C6C, 1, 0x2C6C },
+    { 0x2C6D, 0x2C6D, 1, 0x251 },
+    { 0x2C6E, 0x2C6E, 1, 0x271 },
+    { 0x2C6F, 0x2C6F, 1, 0x250 },
+    { 0x2C70, 0x2C70, 1, 0x252 },
+    { 0x2C71, 0x2C71, 1, 0x2C71 },
+    { 0x2C72, 0x2C72, 1, 0x2C73 },
+    { 0x2C73, 0x2C74, 1, 0x2C73 },
+    { 0x2C75, 0x2C75, 1, 0x2C76 },
+    { 0x2C76, 0x2C7D, 1, 0x2C76 },
+    { 0x2C7E, 0x2C7F, 1, 0x23F },
+    { 0x2C80, 0x2C80, 1, 0x2C81 },
+    { 0x2C81, 0x2C81, 1, 0x2C81 },
+    { 0x2C82, 0x2C82, 1, 0x2C83 },
+    { 0x2C83, 0x2C83, 1, 0x2C83 },
+    { 0x2C84, 0x2C84, 1, 0x2C85 },
+    { 0x2C85, 0x2C85, 1, 0x2C85 },
+    { 0x2C86, 0x2C86, 1, 0x2C87 },
+    { 0x2C87, 0x2C87, 1, 0x2C87 },
+    { 0x2C88, 0x2C88, 1, 0x2C89 },
+    { 0x2C89, 0x2C89, 1, 0x2C89 },
+    { 0x2C8A, 0x2C8A, 1, 0x2C8B },
+    { 0x2C8B, 0x2C8B, 1, 0x2C8B },
+    { 0x2C8C, 0x2C8C, 1, 0x2C8D },
+    { 0x2C8D, 0x2C8D, 1, 0x2C8D },
+    { 0x2C8E, 0x2C8E, 1, 0x2C8F },
+    { 0x2C8F, 0x2C8F, 1, 0x2C8F },
+    { 0x2C90, 0x2C90, 1, 0x2C91 },
+    { 0x2C91, 0x2C91, 1, 0x2C91 },
+    { 0x2C92, 0x2C92, 1, 0x2C93 },
+    { 0x2C93, 0x2C93, 1, 0x2C93 },
+    { 0x2C94, 0x2C94, 1, 0x2C95 },
+    { 0x2C95, 0x2C95, 1, 0x2C95 },
+    { 0x2C96, 0x2C96, 1, 0x2C97 },
+    { 0x2C97, 0x2C97, 1, 0x2C97 },
+    { 0x2C98, 0x2C98, 1, 0x2C99 },
+    { 0x2C99, 0x2C99, 1, 0x2C99 },
+    { 0x2C9A, 0x2C9A, 1, 0x2C9B },
+    { 0x2C9B, 0x2C9B, 1, 0x2C9B },
+    { 0x2C9C, 0x2C9C, 1, 0x2C9D },
+    { 0x2C9D, 0x2C9D, 1, 0x2C9D },
+    { 0x2C9E, 0x2C9E, 1, 0x2C9F },
+    { 0x2C9F, 0x2C9F, 1, 0x2C9F },
+    { 0x2CA0, 0x2CA0, 1, 0x2CA1 },
+    { 0x2CA1, 0x2CA1, 1, 0x2CA1 },
+    { 0x2CA2, 0x2CA2, 1, 0x2CA3 },
+    { 0x2CA3, 0x2CA3, 1, 0x2CA3 },
+    { 0x2CA4, 0x2CA4, 1, 0x2CA5 },
+    { 0x2CA5, 0x2CA5, 1, 0x2CA5 },
+    { 0x2CA6, 0x2CA6, 1, 0x2CA7 },
+    { 0x2CA7, 0x2CA7, 1, 0x2CA7 },
+    { 0x2CA8, 0x2CA8, 1, 0x2CA9 },
+    { 0x2CA9, 0x2CA9, 1, 0x2CA9 },
+    { 0x2CAA, 0x2CAA, 1, 0x2CAB },
+    { 0x2CAB, 0x2CAB, 1, 0x2CAB },
+    { 0x2CAC, 0x2CAC, 1, 0x2CAD },
+    { 0x2CAD, 0x2CAD, 1, 0x2CAD },
+    { 0x2CAE, 0x2CAE, 1, 0x2CAF },
+    { 0x2CAF, 0x2CAF, 1, 0x2CAF },
+    { 0x2CB0, 0x2CB0, 1, 0x2CB1 },
+    { 0x2CB1, 0x2CB1, 1, 0x2CB1 },
+    { 0x2CB2, 0x2CB2, 1, 0x2CB3 },
+    { 0x2CB3, 0x2CB3, 1, 0x2CB3 },
+    { 0x2CB4, 0x2CB4, 1, 0x2CB5 },
+    { 0x2CB5, 0x2CB5, 1, 0x2CB5 },
+    { 0x2CB6, 0x2CB6, 1, 0x2CB7 },
+    { 0x2CB7, 0x2CB7, 1, 0x2CB7 },
+    { 0x2CB8, 0x2CB8, 1, 0x2CB9 },
+    { 0x2CB9, 0x2CB9, 1, 0x2CB9 },
+    { 0x2CBA, 0x2CBA, 1, 0x2CBB },
+    { 0x2CBB, 0x2CBB, 1, 0x2CBB },
+    { 0x2CBC, 0x2CBC, 1, 0x2CBD },
+    { 0x2CBD, 0x2CBD, 1, 0x2CBD },
+    { 0x2CBE, 0x2CBE, 1, 0x2CBF },
+    { 0x2CBF, 0x2CBF, 1, 0x2CBF },
+    { 0x2CC0, 0x2CC0, 1, 0x2CC1 },
+    { 0x2CC1, 0x2CC1, 1, 0x2CC1 },
+    { 0x2CC2, 0x2CC2, 1, 0x2CC3 },
+    { 0x2CC3, 0x2CC3, 1, 0x2CC3 },
+    { 0x2CC4, 0x2CC4, 1, 0x2CC5 },
+    { 0x2CC5, 0x2CC5, 1, 0x2CC5 },
+    { 0x2CC6, 0x2CC6, 1, 0x2CC7 },
+    { 0x2CC7, 0x2CC7, 1, 0x2CC7 },
+    { 0x2CC8, 0x2CC8, 1, 0x2CC9 },
+    { 0x2CC9, 0x2CC9, 1, 0x2CC9 },
+    { 0x2CCA, 0x2CCA, 1, 0x2CCB },
+    { 0x2CCB, 0x2CCB, 1, 0x2CCB },
+    { 0x2CCC, 0x2CCC, 1, 0x2CCD },
+    { 0x2CCD, 0x2CCD, 1, 0x2CCD },
+    { 0x2CCE, 0x2CCE, 1, 0x2CCF },
+    { 0x2CCF, 0x2CCF, 1, 0x2CCF },
+    { 0x2CD0, 0x2CD0, 1, 0x2CD1 },
+    { 0x2CD1, 0x2CD1, 1, 0x2CD1 },
+    { 0x2CD2, 0x2CD2, 1, 0x2CD3 },
+    { 0x2CD3, 0x2CD3, 1, 0x2CD3 },
+    { 0x2CD4, 0x2CD4, 1, 0x2CD5 },
+    { 0x2CD5, 0x2CD5, 1, 0x2CD5 },
+    { 0x2CD6, 0x2CD6, 1, 0x2CD7 },
+    { 0x2CD7, 0x2CD7, 1, 0x2CD7 },
+    { 0x2CD8, 0x2CD8, 1, 0x2CD9 },
+    { 0x2CD9, 0x2CD9, 1, 0x2CD9 },
+    { 0x2CDA, 0x2CDA, 1, 0x2CDB },
+    { 0x2CDB, 0x2CDB, 1, 0x2CDB },
+    { 0x2CDC, 0x2CDC, 1, 0x2CDD },
+    { 0x2CDD, 0x2CDD, 1, 0x2CDD },
+    { 0x2CDE, 0x2CDE, 1, 0x2CDF },
+    { 0x2CDF, 0x2CDF, 1, 0x2CDF },
+    { 0x2CE0, 0x2CE0, 1, 0x2CE1 },
+    { 0x2CE1, 0x2CE1, 1, 0x2CE1 },
+    { 0x2CE2, 0x2CE2, 1, 0x2CE3 },
+    { 0x2CE3, 0x2CE4, 1, 0x2CE3 },
+    { 0x2CEB, 0x2CEB, 1, 0x2CEC },
+    { 0x2CEC, 0x2CEC, 1, 0x2CEC },
+    { 0x2CED, 0x2CED, 1, 0x2CEE },
+    { 0x2CEE, 0x2CF1, 1, 0x2CEE },
+    { 0x2CF2, 0x2CF2, 1, 0x2CF3 },
+    { 0x2CF3, 0x2CF3, 1, 0x2CF3 },
+    { 0x2D00, 0x2D25, 1, 0x2D00 },
+    { 0x2D27, 0x2D27, 1, 0x2D27 },
+    { 0x2D2D, 0x2D2D, 1, 0x2D2D },
+    { 0x2D30, 0x2D67, 1, 0x2D30 },
+    { 0x2D6F, 0x2D6F, 1, 0x2D6F },
+    { 0x2D7F, 0x2D96, 1, 0x2D7F },
+    { 0x2DA0, 0x2DA6, 1, 0x2DA0 },
+    { 0x2DA8, 0x2DAE, 1, 0x2DA8 },
+    { 0x2DB0, 0x2DB6, 1, 0x2DB0 },
+    { 0x2DB8, 0x2DBE, 1, 0x2DB8 },
+    { 0x2DC0, 0x2DC6, 1, 0x2DC0 },
+    { 0x2DC8, 0x2DCE, 1, 0x2DC8 },
+    { 0x2DD0, 0x2DD6, 1, 0x2DD0 },
+    { 0x2DD8, 0x2DDE, 1, 0x2DD8 },
+    { 0x2DE0, 0x2DFF, 1, 0x2DE0 },
+    { 0x2E2F, 0x2E2F, 1, 0x2E2F },
+    { 0x3000, 0x3000, -1, 0x0 },
+    { 0x3005, 0x3007, 1, 0x3005 },
+    { 0x3021, 0x302F, 1, 0x3021 },
+    { 0x3031, 0x3035, 1, 0x3031 },
+    { 0x3038, 0x303C, 1, 0x3038 },
+    { 0x3041, 0x3096, 1, 0x3041 },
+    { 0x3099, 0x309A, 1, 0x3099 },
+    { 0x309D, 0x309F, 1, 0x309D },
+    { 0x30A1, 0x30FA, 1, 0x30A1 },
+    { 0x30FC, 0x30FF, 1, 0x30FC },
+    { 0x3105, 0x312F, 1, 0x3105 },
+    { 0x3131, 0x318E, 1, 0x3131 },
+    { 0x31A0, 0x31BF, 1, 0x31A0 },
+    { 0x31F0, 0x31FF, 1, 0x31F0 },
+    { 0x3400, 0x4DBF, 1, 0x3400 },
+    { 0x4E00, 0xA48C, 1, 0x4E00 },
+    { 0xA4D0, 0xA4FD, 1, 0xA4D0 },
+    { 0xA500, 0xA60C, 1, 0xA500 },
+    { 0xA610, 0xA62B, 1, 0xA610 },
+    { 0xA640, 0xA640, 1, 0xA641 },
+    { 0xA641, 0xA641, 1, 0xA641 },
+    { 0xA642, 0xA642, 1, 0xA643 },
+    { 0xA643, 0xA643, 1, 0xA643 },
+    { 0xA644, 0xA644, 1, 0xA645 },
+    { 0xA645, 0xA645, 1, 0xA645 },
+    { 0xA646, 0xA646, 1, 0xA647 },
+    { 0xA647, 0xA647, 1, 0xA647 },
+    { 0xA648, 0xA648, 1, 0xA649 },
+    { 0xA649, 0xA649, 1, 0xA649 },
+    { 0xA64A, 0xA64A, 1, 0xA64B },
+    { 0xA64B, 0xA64B, 1, 0xA64B },
+    { 0xA64C, 0xA64C, 1, 0xA64D },
+    { 0xA64D, 0xA64D, 1, 0xA64D },
+    { 0xA64E, 0xA64E, 1, 0xA64F },
+    { 0xA64F, 0xA64F, 1, 0xA64F },
+    { 0xA650, 0xA650, 1, 0xA651 },
+    { 0xA651, 0xA651, 1, 0xA651 },
+    { 0xA652, 0xA652, 1, 0xA653 },
+    { 0xA653, 0xA653, 1, 0xA653 },
+    { 0xA654, 0xA654, 1, 0xA655 },
+    { 0xA655, 0xA655, 1, 0xA655 },
+    { 0xA656, 0xA656, 1, 0xA657 },
+    { 0xA657, 0xA657, 1, 0xA657 },
+    { 0xA658, 0xA658, 1, 0xA659 },
+    { 0xA659, 0xA659, 1, 0xA659 },
+    { 0xA65A, 0xA65A, 1, 0xA65B },
+    { 0xA65B, 0xA65B, 1, 0xA65B },
+    { 0xA65C, 0xA65C, 1, 0xA65D },
+    { 0xA65D, 0xA65D, 1, 0xA65D },
+    { 0xA65E, 0xA65E, 1, 0xA65F },
+    { 0xA65F, 0xA65F, 1, 0xA65F },
+    { 0xA660, 0xA660, 1, 0xA661 },
+    { 0xA661, 0xA661, 1, 0xA661 },
+    { 0xA662, 0xA662, 1, 0xA663 },
+    { 0xA663, 0xA663, 1, 0xA663 },
+    { 0xA664, 0xA664, 1, 0xA665 },
+    { 0xA665, 0xA665, 1, 0xA665 },
+    { 0xA666, 0xA666, 1, 0xA667 },
+    { 0xA667, 0xA667, 1, 0xA667 },
+    { 0xA668, 0xA668, 1, 0xA669 },
+    { 0xA669, 0xA669, 1, 0xA669 },
+    { 0xA66A, 0xA66A, 1, 0xA66B },
+    { 0xA66B, 0xA66B, 1, 0xA66B },
+    { 0xA66C, 0xA66C, 1, 0xA66D },
+    { 0xA66D, 0xA672, 1, 0xA66D },
+    { 0xA674, 0xA67D, 1, 0xA674 },
+    { 0xA67F, 0xA67F, 1, 0xA67F },
+    { 0xA680, 0xA680, 1, 0xA681 },
+    { 0xA681, 0xA681, 1, 0xA681 },
+    { 0xA682, 0xA682, 1, 0xA683 },
+    { 0xA683, 0xA683, 1, 0xA683 },
+    { 0xA684, 0xA684, 1, 0xA685 },
+    { 0xA685, 0xA685, 1, 0xA685 },
+    { 0xA686, 0xA686, 1, 0xA687 },
+    { 0xA687, 0xA687, 1, 0xA687 },
+    { 0xA688, 0xA688, 1, 0xA689 },
+    { 0xA689, 0xA689, 1, 0xA689 },
+    { 0xA68A, 0xA68A, 1, 0xA68B },
+    { 0xA68B, 0xA68B, 1, 0xA68B },
+    { 0xA68C, 0xA68C, 1, 0xA68D },
+    { 0xA68D, 0xA68D, 1, 0xA68D },
+    { 0xA68E, 0xA68E, 1, 0xA68F },
+    { 0xA68F, 0xA68F, 1, 0xA68F },
+    { 0xA690, 0xA690, 1, 0xA691 },
+    { 0xA691, 0xA691, 1, 0xA691 },
+    { 0xA692, 0xA692, 1, 0xA693 },
+    { 0xA693, 0xA693, 1, 0xA693 },
+    { 0xA694, 0xA694, 1, 0xA695 },
+    { 0xA695, 0xA695, 1, 0xA695 },
+    { 0xA696, 0xA696, 1, 0xA697 },
+    { 0xA697, 0xA697, 1, 0xA697 },
+    { 0xA698, 0xA698, 1, 0xA699 },
+    { 0xA699, 0xA699, 1, 0xA699 },
+    { 0xA69A, 0xA69A, 1, 0xA69B },
+    { 0xA69B, 0xA6F1, 1, 0xA69B },
+    { 0xA717, 0xA71F, 1, 0xA717 },
+    { 0xA722, 0xA722, 1, 0xA723 },
+    { 0xA723, 0xA723, 1, 0xA723 },
+    { 0xA724, 0xA724, 1, 0xA725 },
+    { 0xA725, 0xA725, 1, 0xA725 },
+    { 0xA726, 0xA726, 1, 0xA727 },
+    { 0xA727, 0xA727, 1, 0xA727 },
+    { 0xA728, 0xA728, 1, 0xA729 },
+    { 0xA729, 0xA729, 1, 0xA729 },
+    { 0xA72A, 0xA72A, 1, 0xA72B },
+    { 0xA72B, 0xA72B, 1, 0xA72B },
+    { 0xA72C, 0xA72C, 1, 0xA72D },
+    { 0xA72D, 0xA72D, 1, 0xA72D },
+    { 0xA72E, 0xA72E, 1, 0xA72F },
+    { 0xA72F, 0xA731, 1, 0xA72F },
+    { 0xA732, 0xA732, 1, 0xA733 },
+    { 0xA733, 0xA733, 1, 0xA733 },
+    { 0xA734, 0xA734, 1, 0xA735 },
+    { 0xA735, 0xA735, 1, 0xA735 },
+    { 0xA736, 0xA736, 1, 0xA737 },
+    { 0xA737, 0xA737, 1, 0xA737 },
+    { 0xA738, 0xA738, 1, 0xA739 },
+    { 0xA739, 0xA739, 1, 0xA739 },
+    { 0xA73A, 0xA73A, 1, 0xA73B },
+    { 0xA73B, 0xA73B, 1, 0xA73B },
+    { 0xA73C, 0xA73C, 1, 0xA73D },
+    { 0xA73D, 0xA73D, 1, 0xA73D },
+    { 0xA73E, 0xA73E, 1, 0xA73F },
+    { 0xA73F, 0xA73F, 1, 0xA73F },
+    { 0xA740, 0xA740, 1, 0xA741 },
+    { 0xA741, 0xA741, 1, 0xA741 },
+    { 0xA742, 0xA742, 1, 0xA743 },
+    { 0xA743, 0xA743, 1, 0xA743 },
+    { 0xA744, 0xA744, 1, 0xA745 },
+    { 0xA745, 0xA745, 1, 0xA745 },
+    { 0xA746, 0xA746, 1, 0xA747 },
+    { 0xA747, 0xA747, 1, 0xA747 },
+    { 0xA748, 0xA748, 1, 0xA749 },
+    { 0xA749, 0xA749, 1, 0xA749 },
+    { 0xA74A, 0xA74A, 1, 0xA74B },
+    { 0xA74B, 0xA74B, 1, 0xA74B },
+    { 0xA74C, 0xA74C, 1, 0xA74D },
+    { 0xA74D, 0xA74D, 1, 0xA74D },
+    { 0xA74E, 0xA74E, 1, 0xA74F },
+    { 0xA74F, 0xA74F, 1, 0xA74F },
+    { 0xA750, 0xA750, 1, 0xA751 },
+    { 0xA751, 0xA751, 1, 0xA751 },
+    { 0xA752, 0xA752, 1, 0xA753 },
+    { 0xA753, 0xA753, 1, 0xA753 },
+    { 0xA754, 0xA754, 1, 0xA755 },
+    { 0xA755, 0xA755, 1, 0xA755 },
+    { 0xA756, 0xA756, 1, 0xA757 },
+    { 0xA757, 0xA757, 1, 0xA757 },
+    { 0xA758, 0xA758, 1, 0xA759 },
+    { 0xA759, 0xA759, 1, 0xA759 },
+    { 0xA75A, 0xA75A, 1, 0xA75B },
+    { 0xA75B, 0xA75B, 1, 0xA75B },
+    { 0xA75C, 0xA75C, 1, 0xA75D },
+    { 0xA75D, 0xA75D, 1, 0xA75D },
+    { 0xA75E, 0xA75E, 1, 0xA75F },
+    { 0xA75F, 0xA75F, 1, 0xA75F },
+    { 0xA760, 0xA760, 1, 0xA761 },
+    { 0xA761, 0xA761, 1, 0xA761 },
+    { 0xA762, 0xA762, 1, 0xA763 },
+    { 0xA763, 0xA763, 1, 0xA763 },
+    { 0xA764, 0xA764, 1, 0xA765 },
+    { 0xA765, 0xA765, 1, 0xA765 },
+    { 0xA766, 0xA766, 1, 0xA767 },
+    { 0xA767, 0xA767, 1, 0xA767 },
+    { 0xA768, 0xA768, 1, 0xA769 },
+    { 0xA769, 0xA769, 1, 0xA769 },
+    { 0xA76A, 0xA76A, 1, 0xA76B },
+    { 0xA76B, 0xA76B, 1, 0xA76B },
+    { 0xA76C, 0xA76C, 1, 0xA76D },
+    { 0xA76D, 0xA76D, 1, 0xA76D },
+    { 0xA76E, 0xA76E, 1, 0xA76F },
+    { 0xA76F, 0xA778, 1, 0xA76F },
+    { 0xA779, 0xA779, 1, 0xA77A },
+    { 0xA77A, 0xA77A, 1, 0xA77A },
+    { 0xA77B, 0xA77B, 1, 0xA77C },
+    { 0xA77C, 0xA77C, 1, 0xA77C },
+    { 0xA77D, 0xA77D, 1, 0x1D79 },
+    { 0xA77E, 0xA77E, 1, 0xA77F },
+    { 0xA77F, 0xA77F, 1, 0xA77F },
+    { 0xA780, 0xA780, 1, 0xA781 },
+    { 0xA781, 0xA781, 1, 0xA781 },
+    { 0xA782, 0xA782, 1, 0xA783 },
+    { 0xA783, 0xA783, 1, 0xA783 },
+    { 0xA784, 0xA784, 1, 0xA785 },
+    { 0xA785, 0xA785, 1, 0xA785 },
+    { 0xA786, 0xA786, 1, 0xA787 },
+    { 0xA787, 0xA788, 1, 0xA787 },
+    { 0xA78B, 0xA78B, 1, 0xA78C },
+    { 0xA78C, 0xA78C, 1, 0xA78C },
+    { 0xA78D, 0xA78D, 1, 0x265 },
+    { 0xA78E, 0xA78F, 1, 0xA78E },
+    { 0xA790, 0xA790, 1, 0xA791 },
+    { 0xA791, 0xA791, 1, 0xA791 },
+    { 0xA792, 0xA792, 1, 0xA793 },
+    { 0xA793, 0xA795, 1, 0xA793 },
+    { 0xA796, 0xA796, 1, 0xA797 },
+    { 0xA797, 0xA797, 1, 0xA797 },
+    { 0xA798, 0xA798, 1, 0xA799 },
+    { 0xA799, 0xA799, 1, 0xA799 },
+    { 0xA79A, 0xA79A, 1, 0xA79B },
+    { 0xA79B, 0xA79B, 1, 0xA79B },
+    { 0xA79C, 0xA79C, 1, 0xA79D },
+    { 0xA79D, 0xA79D, 1, 0xA79D },
+    { 0xA79E, 0xA79E, 1, 0xA79F },
+    { 0xA79F, 0xA79F, 1, 0xA79F },
+    { 0xA7A0, 0xA7A0, 1, 0xA7A1 },
+    { 0xA7A1, 0xA7A1, 1, 0xA7A1 },
+    { 0xA7A2, 0xA7A2, 1, 0xA7A3 },
+    { 0xA7A3, 0xA7A3, 1, 0xA7A3 },
+    { 0xA7A4, 0xA7A4, 1, 0xA7A5 },
+    { 0xA7A5, 0xA7A5, 1, 0xA7A5 },
+    { 0xA7A6, 0xA7A6, 1, 0xA7A7 },
+    { 0xA7A7, 0xA7A7, 1, 0xA7A7 },
+    { 0xA7A8, 0xA7A8, 1, 0xA7A9 },
+    { 0xA7A9, 0xA7A9, 1, 0xA7A9 },
+    { 0xA7AA, 0xA7AA, 1, 0x266 },
+    { 0xA7AB, 0xA7AB, 1, 0x25C },
+    { 0xA7AC, 0xA7AC, 1, 0x261 },
+    { 0xA7AD, 0xA7AD, 1, 0x26C },
+    { 0xA7AE, 0xA7AE, 1, 0x26A },
+    { 0xA7AF, 0xA7AF, 1, 0xA7AF },
+    { 0xA7B0, 0xA7B0, 1, 0x29E },
+    { 0xA7B1, 0xA7B1, 1, 0x287 },
+    { 0xA7B2, 0xA7B2, 1, 0x29D },
+    { 0xA7B3, 0xA7B3, 1, 0xAB53 },
+    { 0xA7B4, 0xA7B4, 1, 0xA7B5 },
+    { 0xA7B5, 0xA7B5, 1, 0xA7B5 },
+    { 0xA7B6, 0xA7B6, 1, 0xA7B7 },
+    { 0xA7B7, 0xA7B7, 1, 0xA7B7 },
+    { 0xA7B8, 0xA7B8, 1, 0xA7B9 },
+    { 0xA7B9, 0xA7B9, 1, 0xA7B9 },
+    { 0xA7BA, 0xA7BA, 1, 0xA7BB },
+    { 0xA7BB, 0xA7BB, 1, 0xA7BB },
+    { 0xA7BC, 0xA7BC, 1, 0xA7BD },
+    { 0xA7BD, 0xA7BD, 1, 0xA7BD },
+    { 0xA7BE, 0xA7BE, 1, 0xA7BF },
+    { 0xA7BF, 0xA7BF, 1, 0xA7BF },
+    { 0xA7C0, 0xA7C0, 1, 0xA7C1 },
+    { 0xA7C1, 0xA7C1, 1, 0xA7C1 },
+    { 0xA7C2, 0xA7C2, 1, 0xA7C3 },
+    { 0xA7C3, 0xA7C3, 1, 0xA7C3 },
+    { 0xA7C4, 0xA7C4, 1, 0xA794 },
+    { 0xA7C5, 0xA7C5, 1, 0x282 },
+    { 0xA7C6, 0xA7C6, 1, 0x1D8E },
+    { 0xA7C7, 0xA7C7, 1, 0xA7C8 },
+    { 0xA7C8, 0xA7C8, 1, 0xA7C8 },
+    { 0xA7C9, 0xA7C9, 1, 0xA7CA },
+    { 0xA7CA, 0xA7CA, 1, 0xA7CA },
+    { 0xA7D0, 0xA7D0, 1, 0xA7D1 },
+    { 0xA7D1, 0xA7D1, 1, 0xA7D1 },
+    { 0xA7D3, 0xA7D3, 1, 0xA7D3 },
+    { 0xA7D5, 0xA7D5, 1, 0xA7D5 },
+    { 0xA7D6, 0xA7D6, 1, 0xA7D7 },
+    { 0xA7D7, 0xA7D7, 1, 0xA7D7 },
+    { 0xA7D8, 0xA7D8, 1, 0xA7D9 },
+    { 0xA7D9, 0xA7D9, 1, 0xA7D9 },
+    { 0xA7F2, 0xA7F4, 1, 0xA7F2 },
+    { 0xA7F5, 0xA7F5, 1, 0xA7F6 },
+    { 0xA7F6, 0xA827, 1, 0xA7F6 },
+    { 0xA82C, 0xA82C, 1, 0xA82C },
+    { 0xA840, 0xA873, 1, 0xA840 },
+    { 0xA880, 0xA8C5, 1, 0xA880 },
+    { 0xA8D0, 0xA8D9, 1, 0xA8D0 },
+    { 0xA8E0, 0xA8F7, 1, 0xA8E0 },
+    { 0xA8FB, 0xA8FB, 1, 0xA8FB },
+    { 0xA8FD, 0xA92D, 1, 0xA8FD },
+    { 0xA930, 0xA953, 1, 0xA930 },
+    { 0xA960, 0xA97C, 1, 0xA960 },
+    { 0xA980, 0xA9C0, 1, 0xA980 },
+    { 0xA9CF, 0xA9D9, 1, 0xA9CF },
+    { 0xA9E0, 0xA9FE, 1, 0xA9E0 },
+    { 0xAA00, 0xAA36, 1, 0xAA00 },
+    { 0xAA40, 0xAA4D, 1, 0xAA40 },
+    { 0xAA50, 0xAA59, 1, 0xAA50 },
+    { 0xAA60, 0xAA76, 1, 0xAA60 },
+    { 0xAA7A, 0xAAC2, 1, 0xAA7A },
+    { 0xAADB, 0xAADD, 1, 0xAADB },
+    { 0xAAE0, 0xAAEF, 1, 0xAAE0 },
+    { 0xAAF2, 0xAAF6, 1, 0xAAF2 },
+    { 0xAB01, 0xAB06, 1, 0xAB01 },
+    { 0xAB09, 0xAB0E, 1, 0xAB09 },
+    { 0xAB11, 0xAB16, 1, 0xAB11 },
+    { 0xAB20, 0xAB26, 1, 0xAB20 },
+    { 0xAB28, 0xAB2E, 1, 0xAB28 },
+    { 0xAB30, 0xAB5A, 1, 0xAB30 },
+    { 0xAB5C, 0xAB69, 1, 0xAB5C },
+    { 0xAB70, 0xABBF, 1, 0x13A0 },
+    { 0xABC0, 0xABEA, 1, 0xABC0 },
+    { 0xABEC, 0xABED, 1, 0xABEC },
+    { 0xABF0, 0xABF9, 1, 0xABF0 },
+    { 0xAC00, 0xD7A3, 1, 0xAC00 },
+    { 0xD7B0, 0xD7C6, 1, 0xD7B0 },
+    { 0xD7CB, 0xD7FB, 1, 0xD7CB },
+    { 0xF900, 0xFA6D, 1, 0xF900 },
+    { 0xFA70, 0xFAD9, 1, 0xFA70 },
+    { 0xFB00, 0xFB06, 1, 0xFB00 },
+    { 0xFB13, 0xFB17, 1, 0xFB13 },
+    { 0xFB1D, 0xFB28, 1, 0xFB1D },
+    { 0xFB2A, 0xFB36, 1, 0xFB2A },
+    { 0xFB38, 0xFB3C, 1, 0xFB38 },
+    { 0xFB3E, 0xFB3E, 1, 0xFB3E },
+    { 0xFB40, 0xFB41, 1, 0xFB40 },
+    { 0xFB43, 0xFB44, 1, 0xFB43 },
+    { 0xFB46, 0xFBB1, 1, 0xFB46 },
+    { 0xFBD3, 0xFD3D, 1, 0xFBD3 },
+    { 0xFD50, 0xFD8F, 1, 0xFD50 },
+    { 0xFD92, 0xFDC7, 1, 0xFD92 },
+    { 0xFDF0, 0xFDFB, 1, 0xFDF0 },
+    { 0xFE00, 0xFE0F, 1, 0xFE00 },
+    { 0xFE20, 0xFE2F, 1, 0xFE20 },
+    { 0xFE70, 0xFE74, 1, 0xFE70 },
+    { 0xFE76, 0xFEFC, 1, 0xFE76 },
+    { 0xFF10, 0xFF19, 1, 0xFF10 },
+    { 0xFF21, 0xFF3A, 1, 0xFF41 },
+    { 0xFF41, 0xFF5A, 1, 0xFF41 },
+    { 0xFF66, 0xFFBE, 1, 0xFF66 },
+    { 0xFFC2, 0xFFC7, 1, 0xFFC2 },
+    { 0xFFCA, 0xFFCF, 1, 0xFFCA },
+    { 0xFFD2, 0xFFD7, 1, 0xFFD2 },
+    { 0xFFDA, 0xFFDC, 1, 0xFFDA },
+    { 0x10000, 0x1000B, 1, 0x10000 },
+    { 0x1000D, 0x10026, 1, 0x1000D },
+    { 0x10028, 0x1003A, 1, 0x10028 },
+    { 0x1003C, 0x1003D, 1, 0x1003C },
+    { 0x1003F, 0x1004D, 1, 0x1003F },
+    { 0x10050, 0x1005D, 1, 0x10050 },
+    { 0x10080, 0x100FA, 1, 0x10080 },
+    { 0x10140, 0x10174, 1, 0x10140 },
+    { 0x101FD, 0x101FD, 1, 0x101FD },
+    { 0x10280, 0x1029C, 1, 0x10280 },
+    { 0x102A0, 0x102D0, 1, 0x102A0 },
+    { 0x102E0, 0x102E0, 1, 0x102E0 },
+    { 0x10300, 0x1031F, 1, 0x10300 },
+    { 0x1032D, 0x1034A, 1, 0x1032D },
+    { 0x10350, 0x1037A, 1, 0x10350 },
+    { 0x10380, 0x1039D, 1, 0x10380 },
+    { 0x103A0, 0x103C3, 1, 0x103A0 },
+    { 0x103C8, 0x103CF, 1, 0x103C8 },
+    { 0x103D1, 0x103D5, 1, 0x103D1 },
+    { 0x10400, 0x10427, 1, 0x10428 },
+    { 0x10428, 0x1049D, 1, 0x10428 },
+    { 0x104A0, 0x104A9, 1, 0x104A0 },
+    { 0x104B0, 0x104D3, 1, 0x104D8 },
+    { 0x104D8, 0x104FB, 1, 0x104D8 },
+    { 0x10500, 0x10527, 1, 0x10500 },
+    { 0x10530, 0x10563, 1, 0x10530 },
+    { 0x10570, 0x1057A, 1, 0x10597 },
+    { 0x1057C, 0x1058A, 1, 0x105A3 },
+    { 0x1058C, 0x10592, 1, 0x105B3 },
+    { 0x10594, 0x10595, 1, 0x105BB },
+    { 0x10597, 0x105A1, 1, 0x10597 },
+    { 0x105A3, 0x105B1, 1, 0x105A3 },
+    { 0x105B3, 0x105B9, 1, 0x105B3 },
+    { 0x105BB, 0x105BC, 1, 0x105BB },
+    { 0x10600, 0x10736, 1, 0x10600 },
+    { 0x10740, 0x10755, 1, 0x10740 },
+    { 0x10760, 0x10767, 1, 0x10760 },
+    { 0x10780, 0x10785, 1, 0x10780 },
+    { 0x10787, 0x107B0, 1, 0x10787 },
+    { 0x107B2, 0x107BA, 1, 0x107B2 },
+    { 0x10800, 0x10805, 1, 0x10800 },
+    { 0x10808, 0x10808, 1, 0x10808 },
+    { 0x1080A, 0x10835, 1, 0x1080A },
+    { 0x10837, 0x10838, 1, 0x10837 },
+    { 0x1083C, 0x1083C, 1, 0x1083C },
+    { 0x1083F, 0x10855, 1, 0x1083F },
+    { 0x10860, 0x10876, 1, 0x10860 },
+    { 0x10880, 0x1089E, 1, 0x10880 },
+    { 0x108E0, 0x108F2, 1, 0x108E0 },
+    { 0x108F4, 0x108F5, 1, 0x108F4 },
+    { 0x10900, 0x10915, 1, 0x10900 },
+    { 0x10920, 0x10939, 1, 0x10920 },
+    { 0x10980, 0x109B7, 1, 0x10980 },
+    { 0x109BE, 0x109BF, 1, 0x109BE },
+    { 0x10A00, 0x10A03, 1, 0x10A00 },
+    { 0x10A05, 0x10A06, 1, 0x10A05 },
+    { 0x10A0C, 0x10A13, 1, 0x10A0C },
+    { 0x10A15, 0x10A17, 1, 0x10A15 },
+    { 0x10A19, 0x10A35, 1, 0x10A19 },
+    { 0x10A38, 0x10A3A, 1, 0x10A38 },
+    { 0x10A3F, 0x10A3F, 1, 0x10A3F },
+    { 0x10A60, 0x10A7C, 1, 0x10A60 },
+    { 0x10A80, 0x10A9C, 1, 0x10A80 },
+    { 0x10AC0, 0x10AC7, 1, 0x10AC0 },
+    { 0x10AC9, 0x10AE6, 1, 0x10AC9 },
+    { 0x10B00, 0x10B35, 1, 0x10B00 },
+    { 0x10B40, 0x10B55, 1, 0x10B40 },
+    { 0x10B60, 0x10B72, 1, 0x10B60 },
+    { 0x10B80, 0x10B91, 1, 0x10B80 },
+    { 0x10C00, 0x10C48, 1, 0x10C00 },
+    { 0x10C80, 0x10CB2, 1, 0x10CC0 },
+    { 0x10CC0, 0x10CF2, 1, 0x10CC0 },
+    { 0x10D00, 0x10D27, 1, 0x10D00 },
+    { 0x10D30, 0x10D39, 1, 0x10D30 },
+    { 0x10E80, 0x10EA9, 1, 0x10E80 },
+    { 0x10EAB, 0x10EAC, 1, 0x10EAB },
+    { 0x10EB0, 0x10EB1, 1, 0x10EB0 },
+    { 0x10F00, 0x10F1C, 1, 0x10F00 },
+    { 0x10F27, 0x10F27, 1, 0x10F27 },
+    { 0x10F30, 0x10F50, 1, 0x10F30 },
+    { 0x10F70, 0x10F85, 1, 0x10F70 },
+    { 0x10FB0, 0x10FC4, 1, 0x10FB0 },
+    { 0x10FE0, 0x10FF6, 1, 0x10FE0 },
+    { 0x11000, 0x11046, 1, 0x11000 },
+    { 0x11066, 0x11075, 1, 0x11066 },
+    { 0x1107F, 0x110BA, 1, 0x1107F },
+    { 0x110C2, 0x110C2, 1, 0x110C2 },
+    { 0x110D0, 0x110E8, 1, 0x110D0 },
+    { 0x110F0, 0x110F9, 1, 0x110F0 },
+    { 0x11100, 0x11134, 1, 0x11100 },
+    { 0x11136, 0x1113F, 1, 0x11136 },
+    { 0x11144, 0x11147, 1, 0x11144 },
+    { 0x11150, 0x11173, 1, 0x11150 },
+    { 0x11176, 0x11176, 1, 0x11176 },
+    { 0x11180, 0x111C4, 1, 0x11180 },
+    { 0x111C9, 0x111CC, 1, 0x111C9 },
+    { 0x111CE, 0x111DA, 1, 0x111CE },
+    { 0x111DC, 0x111DC, 1, 0x111DC },
+    { 0x11200, 0x11211, 1, 0x11200 },
+    { 0x11213, 0x11237, 1, 0x11213 },
+    { 0x1123E, 0x1123E, 1, 0x1123E },
+    { 0x11280, 0x11286, 1, 0x11280 },
+    { 0x11288, 0x11288, 1, 0x11288 },
+    { 0x1128A, 0x1128D, 1, 0x1128A },
+    { 0x1128F, 0x1129D, 1, 0x1128F },
+    { 0x1129F, 0x112A8, 1, 0x1129F },
+    { 0x112B0, 0x112EA, 1, 0x112B0 },
+    { 0x112F0, 0x112F9, 1, 0x112F0 },
+    { 0x11300, 0x11303, 1, 0x11300 },
+    { 0x11305, 0x1130C, 1, 0x11305 },
+    { 0x1130F, 0x11310, 1, 0x1130F },
+    { 0x11313, 0x11328, 1, 0x11313 },
+    { 0x1132A, 0x11330, 1, 0x1132A },
+    { 0x11332, 0x11333, 1, 0x11332 },
+    { 0x11335, 0x11339, 1, 0x11335 },
+    { 0x1133B, 0x11344, 1, 0x1133B },
+    { 0x11347, 0x11348, 1, 0x11347 },
+    { 0x1134B, 0x1134D, 1, 0x1134B },
+    { 0x11350, 0x11350, 1, 0x11350 },
+    { 0x11357, 0x11357, 1, 0x11357 },
+    { 0x1135D, 0x11363, 1, 0x1135D },
+    { 0x11366, 0x1136C, 1, 0x11366 },
+    { 0x11370, 0x11374, 1, 0x11370 },
+    { 0x11400, 0x1144A, 1, 0x11400 },
+    { 0x11450, 0x11459, 1, 0x11450 },
+    { 0x1145E, 0x11461, 1, 0x1145E },
+    { 0x11480, 0x114C5, 1, 0x11480 },
+    { 0x114C7, 0x114C7, 1, 0x114C7 },
+    { 0x114D0, 0x114D9, 1, 0x114D0 },
+    { 0x11580, 0x115B5, 1, 0x11580 },
+    { 0x115B8, 0x115C0, 1, 0x115B8 },
+    { 0x115D8, 0x115DD, 1, 0x115D8 },
+    { 0x11600, 0x11640, 1, 0x11600 },
+    { 0x11644, 0x11644, 1, 0x11644 },
+    { 0x11650, 0x11659, 1, 0x11650 },
+    { 0x11680, 0x116B8, 1, 0x11680 },
+    { 0x116C0, 0x116C9, 1, 0x116C0 },
+    { 0x11700, 0x1171A, 1, 0x11700 },
+    { 0x1171D, 0x1172B, 1, 0x1171D },
+    { 0x11730, 0x11739, 1, 0x11730 },
+    { 0x11740, 0x11746, 1, 0x11740 },
+    { 0x11800, 0x1183A, 1, 0x11800 },
+    { 0x118A0, 0x118BF, 1, 0x118C0 },
+    { 0x118C0, 0x118E9, 1, 0x118C0 },
+    { 0x118FF, 0x11906, 1, 0x118FF },
+    { 0x11909, 0x11909, 1, 0x11909 },
+    { 0x1190C, 0x11913, 1, 0x1190C },
+    { 0x11915, 0x11916, 1, 0x11915 },
+    { 0x11918, 0x11935, 1, 0x11918 },
+    { 0x11937, 0x11938, 1, 0x11937 },
+    { 0x1193B, 0x11943, 1, 0x1193B },
+    { 0x11950, 0x11959, 1, 0x11950 },
+    { 0x119A0, 0x119A7, 1, 0x119A0 },
+    { 0x119AA, 0x119D7, 1, 0x119AA },
+    { 0x119DA, 0x119E1, 1, 0x119DA },
+    { 0x119E3, 0x119E4, 1, 0x119E3 },
+    { 0x11A00, 0x11A3E, 1, 0x11A00 },
+    { 0x11A47, 0x11A47, 1, 0x11A47 },
+    { 0x11A50, 0x11A99, 1, 0x11A50 },
+    { 0x11A9D, 0x11A9D, 1, 0x11A9D },
+    { 0x11AB0, 0x11AF8, 1, 0x11AB0 },
+    { 0x11C00, 0x11C08, 1, 0x11C00 },
+    { 0x11C0A, 0x11C36, 1, 0x11C0A },
+    { 0x11C38, 0x11C40, 1, 0x11C38 },
+    { 0x11C50, 0x11C59, 1, 0x11C50 },
+    { 0x11C72, 0x11C8F, 1, 0x11C72 },
+    { 0x11C92, 0x11CA7, 1, 0x11C92 },
+    { 0x11CA9, 0x11CB6, 1, 0x11CA9 },
+    { 0x11D00, 0x11D06, 1, 0x11D00 },
+    { 0x11D08, 0x11D09, 1, 0x11D08 },
+    { 0x11D0B, 0x11D36, 1, 0x11D0B },
+    { 0x11D3A, 0x11D3A, 1, 0x11D3A },
+    { 0x11D3C, 0x11D3D, 1, 0x11D3C },
+    { 0x11D3F, 0x11D47, 1, 0x11D3F },
+    { 0x11D50, 0x11D59, 1, 0x11D50 },
+    { 0x11D60, 0x11D65, 1, 0x11D60 },
+    { 0x11D67, 0x11D68, 1, 0x11D67 },
+    { 0x11D6A, 0x11D8E, 1, 0x11D6A },
+    { 0x11D90, 0x11D91, 1, 0x11D90 },
+    { 0x11D93, 0x11D98, 1, 0x11D93 },
+    { 0x11DA0, 0x11DA9, 1, 0x11DA0 },
+    { 0x11EE0, 0x11EF6, 1, 0x11EE0 },
+    { 0x11FB0, 0x11FB0, 1, 0x11FB0 },
+    { 0x12000, 0x12399, 1, 0x12000 },
+    { 0x12400, 0x1246E, 1, 0x12400 },
+    { 0x12480, 0x12543, 1, 0x12480 },
+    { 0x12F90, 0x12FF0, 1, 0x12F90 },
+    { 0x13000, 0x1342E, 1, 0x13000 },
+    { 0x14400, 0x14646, 1, 0x14400 },
+    { 0x16800, 0x16A38, 1, 0x16800 },
+    { 0x16A40, 0x16A5E, 1, 0x16A40 },
+    { 0x16A60, 0x16A69, 1, 0x16A60 },
+    { 0x16A70, 0x16ABE, 1, 0x16A70 },
+    { 0x16AC0, 0x16AC9, 1, 0x16AC0 },
+    { 0x16AD0, 0x16AED, 1, 0x16AD0 },
+    { 0x16AF0, 0x16AF4, 1, 0x16AF0 },
+    { 0x16B00, 0x16B36, 1, 0x16B00 },
+    { 0x16B40, 0x16B43, 1, 0x16B40 },
+    { 0x16B50, 0x16B59, 1, 0x16B50 },
+    { 0x16B63, 0x16B77, 1, 0x16B63 },
+    { 0x16B7D, 0x16B8F, 1, 0x16B7D },
+    { 0x16E40, 0x16E5F, 1, 0x16E60 },
+    { 0x16E60, 0x16E7F, 1, 0x16E60 },
+    { 0x16F00, 0x16F4A, 1, 0x16F00 },
+    { 0x16F4F, 0x16F87, 1, 0x16F4F },
+    { 0x16F8F, 0x16F9F, 1, 0x16F8F },
+    { 0x16FE0, 0x16FE1, 1, 0x16FE0 },
+    { 0x16FE3, 0x16FE4, 1, 0x16FE3 },
+    { 0x16FF0, 0x16FF1, 1, 0x16FF0 },
+    { 0x17000, 0x187F7, 1, 0x17000 },
+    { 0x18800, 0x18CD5, 1, 0x18800 },
+    { 0x18D00, 0x18D08, 1, 0x18D00 },
+    { 0x1AFF0, 0x1AFF3, 1, 0x1AFF0 },
+    { 0x1AFF5, 0x1AFFB, 1, 0x1AFF5 },
+    { 0x1AFFD, 0x1AFFE, 1, 0x1AFFD },
+    { 0x1B000, 0x1B122, 1, 0x1B000 },
+    { 0x1B150, 0x1B152, 1, 0x1B150 },
+    { 0x1B164, 0x1B167, 1, 0x1B164 },
+    { 0x1B170, 0x1B2FB, 1, 0x1B170 },
+    { 0x1BC00, 0x1BC6A, 1, 0x1BC00 },
+    { 0x1BC70, 0x1BC7C, 1, 0x1BC70 },
+    { 0x1BC80, 0x1BC88, 1, 0x1BC80 },
+    { 0x1BC90, 0x1BC99, 1, 0x1BC90 },
+    { 0x1BC9D, 0x1BC9E, 1, 0x1BC9D },
+    { 0x1CF00, 0x1CF2D, 1, 0x1CF00 },
+    { 0x1CF30, 0x1CF46, 1, 0x1CF30 },
+    { 0x1D165, 0x1D169, 1, 0x1D165 },
+    { 0x1D16D, 0x1D172, 1, 0x1D16D },
+    { 0x1D17B, 0x1D182, 1, 0x1D17B },
+    { 0x1D185, 0x1D18B, 1, 0x1D185 },
+    { 0x1D1AA, 0x1D1AD, 1, 0x1D1AA },
+    { 0x1D242, 0x1D244, 1, 0x1D242 },
+    { 0x1D400, 0x1D454, 1, 0x1D400 },
+    { 0x1D456, 0x1D49C, 1, 0x1D456 },
+    { 0x1D49E, 0x1D49F, 1, 0x1D49E },
+    { 0x1D4A2, 0x1D4A2, 1, 0x1D4A2 },
+    { 0x1D4A5, 0x1D4A6, 1, 0x1D4A5 },
+    { 0x1D4A9, 0x1D4AC, 1, 0x1D4A9 },
+    { 0x1D4AE, 0x1D4B9, 1, 0x1D4AE },
+    { 0x1D4BB, 0x1D4BB, 1, 0x1D4BB },
+    { 0x1D4BD, 0x1D4C3, 1, 0x1D4BD },
+    { 0x1D4C5, 0x1D505, 1, 0x1D4C5 },
+    { 0x1D507, 0x1D50A, 1, 0x1D507 },
+    { 0x1D50D, 0x1D514, 1, 0x1D50D },
+    { 0x1D516, 0x1D51C, 1, 0x1D516 },
+    { 0x1D51E, 0x1D539, 1, 0x1D51E },
+    { 0x1D53B, 0x1D53E, 1, 0x1D53B },
+    { 0x1D540, 0x1D544, 1, 0x1D540 },
+    { 0x1D546, 0x1D546, 1, 0x1D546 },
+    { 0x1D54A, 0x1D550, 1, 0x1D54A },
+    { 0x1D552, 0x1D6A5, 1, 0x1D552 },
+    { 0x1D6A8, 0x1D6C0, 1, 0x1D6A8 },
+    { 0x1D6C2, 0x1D6DA, 1, 0x1D6C2 },
+    { 0x1D6DC, 0x1D6FA, 1, 0x1D6DC },
+    { 0x1D6FC, 0x1D714, 1, 0x1D6FC },
+    { 0x1D716, 0x1D734, 1, 0x1D716 },
+    { 0x1D736, 0x1D74E, 1, 0x1D736 },
+    { 0x1D750, 0x1D76E, 1, 0x1D750 },
+    { 0x1D770, 0x1D788, 1, 0x1D770 },
+    { 0x1D78A, 0x1D7A8, 1, 0x1D78A },
+    { 0x1D7AA, 0x1D7C2, 1, 0x1D7AA },
+    { 0x1D7C4, 0x1D7CB, 1, 0x1D7C4 },
+    { 0x1D7CE, 0x1D7FF, 1, 0x1D7CE },
+    { 0x1DA00, 0x1DA36, 1, 0x1DA00 },
+    { 0x1DA3B, 0x1DA6C, 1, 0x1DA3B },
+    { 0x1DA75, 0x1DA75, 1, 0x1DA75 },
+    { 0x1DA84, 0x1DA84, 1, 0x1DA84 },
+    { 0x1DA9B, 0x1DA9F, 1, 0x1DA9B },
+    { 0x1DAA1, 0x1DAAF, 1, 0x1DAA1 },
+    { 0x1DF00, 0x1DF1E, 1, 0x1DF00 },
+    { 0x1E000, 0x1E006, 1, 0x1E000 },
+    { 0x1E008, 0x1E018, 1, 0x1E008 },
+    { 0x1E01B, 0x1E021, 1, 0x1E01B },
+    { 0x1E023, 0x1E024, 1, 0x1E023 },
+    { 0x1E026, 0x1E02A, 1, 0x1E026 },
+    { 0x1E100, 0x1E12C, 1, 0x1E100 },
+    { 0x1E130, 0x1E13D, 1, 0x1E130 },
+    { 0x1E140, 0x1E149, 1, 0x1E140 },
+    { 0x1E14E, 0x1E14E, 1, 0x1E14E },
+    { 0x1E290, 0x1E2AE, 1, 0x1E290 },
+    { 0x1E2C0, 0x1E2F9, 1, 0x1E2C0 },
+    { 0x1E7E0, 0x1E7E6, 1, 0x1E7E0 },
+    { 0x1E7E8, 0x1E7EB, 1, 0x1E7E8 },
+    { 0x1E7ED, 0x1E7EE, 1, 0x1E7ED },
+    { 0x1E7F0, 0x1E7FE, 1, 0x1E7F0 },
+    { 0x1E800, 0x1E8C4, 1, 0x1E800 },
+    { 0x1E8D0, 0x1E8D6, 1, 0x1E8D0 },
+    { 0x1E900, 0x1E921, 1, 0x1E922 },
+    { 0x1E922, 0x1E94B, 1, 0x1E922 },
+    { 0x1E950, 0x1E959, 1, 0x1E950 },
+    { 0x1EE00, 0x1EE03, 1, 0x1EE00 },
+    { 0x1EE05, 0x1EE1F, 1, 0x1EE05 },
+    { 0x1EE21, 0x1EE22, 1, 0x1EE21 },
+    { 0x1EE24, 0x1EE24, 1, 0x1EE24 },
+    { 0x1EE27, 0x1EE27, 1, 0x1EE27 },
+    { 0x1EE29, 0x1EE32, 1, 0x1EE29 },
+    { 0x1EE34, 0x1EE37, 1, 0x1EE34 },
+    { 0x1EE39, 0x1EE39, 1, 0x1EE39 },
+    { 0x1EE3B, 0x1EE3B, 1, 0x1EE3B },
+    { 0x1EE42, 0x1EE42, 1, 0x1EE42 },
+    { 0x1EE47, 0x1EE47, 1, 0x1EE47 },
+    { 0x1EE49, 0x1EE49, 1, 0x1EE49 },
+    { 0x1EE4B, 0x1EE4B, 1, 0x1EE4B },
+    { 0x1EE4D, 0x1EE4F, 1, 0x1EE4D },
+    { 0x1EE51, 0x1EE52, 1, 0x1EE51 },
+    { 0x1EE54, 0x1EE54, 1, 0x1EE54 },
+    { 0x1EE57, 0x1EE57, 1, 0x1EE57 },
+    { 0x1EE59, 0x1EE59, 1, 0x1EE59 },
+    { 0x1EE5B, 0x1EE5B, 1, 0x1EE5B },
+    { 0x1EE5D, 0x1EE5D, 1, 0x1EE5D },
+    { 0x1EE5F, 0x1EE5F, 1, 0x1EE5F },
+    { 0x1EE61, 0x1EE62, 1, 0x1EE61 },
+    { 0x1EE64, 0x1EE64, 1, 0x1EE64 },
+    { 0x1EE67, 0x1EE6A, 1, 0x1EE67 },
+    { 0x1EE6C, 0x1EE72, 1, 0x1EE6C },
+    { 0x1EE74, 0x1EE77, 1, 0x1EE74 },
+    { 0x1EE79, 0x1EE7C, 1, 0x1EE79 },
+    { 0x1EE7E, 0x1EE7E, 1, 0x1EE7E },
+    { 0x1EE80, 0x1EE89, 1, 0x1EE80 },
+    { 0x1EE8B, 0x1EE9B, 1, 0x1EE8B },
+    { 0x1EEA1, 0x1EEA3, 1, 0x1EEA1 },
+    { 0x1EEA5, 0x1EEA9, 1, 0x1EEA5 },
+    { 0x1EEAB, 0x1EEBB, 1, 0x1EEAB },
+    { 0x1F130, 0x1F149, 1, 0x1F130 },
+    { 0x1F150, 0x1F169, 1, 0x1F150 },
+    { 0x1F170, 0x1F189, 1, 0x1F170 },
+    { 0x1FBF0, 0x1FBF9, 1, 0x1FBF0 },
+    { 0x20000, 0x2A6DF, 1, 0x20000 },
+    { 0x2A700, 0x2B738, 1, 0x2A700 },
+    { 0x2B740, 0x2B81D, 1, 0x2B740 },
+    { 0x2B820, 0x2CEA1, 1, 0x2B820 },
+    { 0x2CEB0, 0x2EBE0, 1, 0x2CEB0 },
+    { 0x2F800, 0x2FA1D, 1, 0x2F800 },
+    { 0x30000, 0x3134A, 1, 0x30000 },
+    { 0xE0100, 0xE01EF, 1, 0xE0100 },
+};
@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+"""Writes ucdranges.h, the class of every code point from U+0080 up under the
+utf8 rules, from the files of the Unicode Character Database:
+
+    PropList.txt                White_Space separates words
+    DerivedCoreProperties.txt   Alphabetic is kept,
+    UnicodeData.txt             and so are decimal digits (Nd) and combining
+                                marks (Mn, Mc, Me), which belong to the
+                                letter before them
+    CaseFolding.txt             a kept code point is folded by its simple
+                                folding (status C or S)
+
+Everything else (punctuation, symbols, controls, format characters, private
+use and unassigned code points) is dropped. gentables.c builds the tokenizer
+tables from the header at build time; run this again to move to a newer
+version of Unicode:
+
+usage: ucdranges.py UCD_DIR > ucdranges.h
+"""
+import os
+import re
+import sys
+
+SEPARATOR = -1
+WORD = 1
+
+
+def properties(path, name):
+    """Code points listed with property name in a PropList.txt style file."""
+    out = set()
+    with open(path, encoding='utf-8') as f:
+        for line in f:
+            fields = line.split('#')[0].split(';')
+            if len(fields) < 2 or fields[1].strip() != name:
+                continue
+            first, _, last = fields[0].strip().partition('..')
+            out.update(range(int(first, 16), int(last or first, 16) + 1))
+    return out
+
+
+def categories(path):
+    """General category of every assigned code point in UnicodeData.txt."""
+    out = {}
+    first = None
+    with open(path, encoding='utf-8') as f:
+        for line in f:
+            fields = line.split(';')
+            cp = int(fields[0], 16)
+            if fields[1].endswith(', First>'):
+                first = cp
+                continue
+            for c in range(cp if first is None else first, cp + 1):
+                out[c] = fields[2]
+            first = None
+    return out
+
+
+def foldings(path):
+    """Simple case folding (status C and S) from CaseFolding.txt."""
+    out = {}
+    with open(path, encoding='utf-8') as f:
+        for line in f:
+            fields = [x.strip() for x in line.split('#')[0].split(';')]
+            if len(fields) >= 3 and fields[1] in ('C', 'S'):
+                out[int(fields[0], 16)] = int(fields[2], 16)
+    return out
+
+
+def version(ucd):
+    """The Unicode version named in the header of DerivedCoreProperties.txt."""
+    with open(os.path.join(ucd, 'DerivedCoreProperties.txt'), encoding='utf-8') as f:
+        match = re.search(r'-(\d+\.\d+\.\d+)\.txt', f.readline())
+    return match.group(1) if match else 'unknown'
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit(__doc__.rsplit('usage: ', 1)[1])
+    ucd = sys.argv[1]
+    space = properties(os.path.join(ucd, 'PropList.txt'), 'White_Space')
+    alphabetic = properties(os.path.join(ucd, 'DerivedCoreProperties.txt'), 'Alphabetic')
+    category = categories(os.path.join(ucd, 'UnicodeData.txt'))
+    fold = foldings(os.path.join(ucd, 'CaseFolding.txt'))
+
+    # runs of one kind whose code points all fold by the same offset
+    ranges = []
+    for cp in range(0x80, 0x110000):
+        if cp in space:
+            kind, to = SEPARATOR, 0
+        elif cp in alphabetic or category.get(cp, 'Cn') in ('Nd', 'Mn', 'Mc', 'Me'):
+            kind, to = WORD, fold.get(cp, cp)
+        else:
+            continue
+        last = ranges[-1] if ranges else None
+        if last and last[1] == cp - 1 and last[2] == kind and (kind == SEPARATOR or last[3] + cp - last[0] == to):
+            last[1] = cp
+        else:
+            ranges.append([cp, cp, kind, to])
+
+    print('//generated by ucdranges.py from Unicode %s, do not edit' % version(ucd))
+    print('//first, last, kind (-1 separates, 1 is kept), what first folds to')
+    print()
+    print('#define NUM_UCD_RANGES %d' % len(ranges))
+    print()
+    print('static const int ucdRanges[NUM_UCD_RANGES][4] = {')
+    for first, last, kind, to in ranges:
+        print('    { 0x%X, 0x%X, %d, 0x%X },' % (first, last, kind, to))
+    print('};')
+
+
+if __name__ == '__main__':
+    main()
@@ -45,8 +45,9 @@ int destroy_unbounded(unbounded_queue_t *Q)
 }
 
 
-// add item to end of queue
-// if the queue is full, block until space becomes available
+// add item to end of queue, taking ownership of it (the pointer itself is stored)
+// the queue grows instead of blocking
+// returns -1 if the queue is closed, in which case the caller still owns item
 int enqueue_unbounded(unbounded_queue_t *Q, char * item)
 {
 	pthread_mutex_lock(&Q->lock);
@@ -74,8 +75,7 @@ int enqueue_unbounded(unbounded_queue_t *Q, char * item)
 	unsigned i = Q->head + Q->count;
 	if (i >= Q->dataLength) i -= Q->dataLength;
 
-	Q->data[i] = malloc(1 + strlen(item));
-	strcpy(Q->data[i], item);
+	Q->data[i] = item;
 	++Q->count;
 	
 	pthread_cond_signal(&Q->read_ready);
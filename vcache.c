@@ -0,0 +1,245 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+
+//---------------------------------------------------------------------
+// Out-of-core analysis: a bounded cache of snapshot vectors
+//---------------------------------------------------------------------
+
+/*
+ * With --out-of-core MB a corpus snapshot is not mapped: loadSnapshotIndex
+ * reads only its paths, summaries and where each vector is, and the vectors
+ * are read into this cache when a pair needs them. Vectors spilled to disk
+ * under --max-memory (membudget.c) are read back the same way; a vector
+ * with no place on disk (offset -1) is always resident and never cached. A vector stays resident
+ * while an analysis thread has it pinned; once nobody does it joins the back
+ * of a least recently used list, and the front of that list is freed
+ * whenever the resident bytes are over the budget. Pinned vectors are never
+ * freed, so a budget smaller than what the threads pin at once is exceeded
+ * (the peak is reported).
+ *
+ * The tiles are handed out as a blocked nested loop (orderCacheTiles): rows
+ * are grouped into blocks whose vectors fill half the budget, and each block
+ * is swept against the columns it pairs with, so a column vector is read once
+ * per row block instead of once per row tile.
+ */
+
+enum { VC_ABSENT, VC_LOADING, VC_RESIDENT };
+
+typedef struct {
+    int pins;
+    int state;
+    int prev;                   //neighbours in the unpinned list, -1 at its ends
+    int next;
+} vcache_entry_t;
+
+typedef struct {
+    FileAndList **docs;         //the analysed documents, which the entries follow
+    int fd;
+    const char *path;
+    vcache_entry_t *entries;
+    int lruHead;                //least recently used unpinned vector
+    int lruTail;
+    uint64_t budget;
+    uint64_t resident;
+    uint64_t peak;
+    uint64_t bytesRead;
+    long hits;
+    long misses;
+    pthread_mutex_t lock;
+    pthread_cond_t loaded;
+} vector_cache_t;
+
+int init_vector_cache(vector_cache_t *cache, FileAndList **docs, int numDocs, int fd, const char *path,
+                      uint64_t budget){
+    cache->docs = docs;
+    cache->fd = fd;
+    cache->path = path;
+    cache->entries = calloc(numDocs + 1, sizeof(vcache_entry_t));
+    cache->lruHead = -1;
+    cache->lruTail = -1;
+    cache->budget = budget;
+    cache->resident = 0;
+    cache->peak = 0;
+    cache->bytesRead = 0;
+    cache->hits = 0;
+    cache->misses = 0;
+    if(pthread_mutex_init(&cache->lock, NULL) || pthread_cond_init(&cache->loaded, NULL)){
+        perror("vector cache lock init error");
+        abort();
+    }
+    return 0;
+}
+
+void destroy_vector_cache(vector_cache_t *cache){
+    //the vectors still resident are freed with their documents
+    free(cache->entries);
+    pthread_mutex_destroy(&cache->lock);
+    pthread_cond_destroy(&cache->loaded);
+}
+
+void unlinkCacheEntry(vector_cache_t *cache, int i){
+    vcache_entry_t *e = &cache->entries[i];
+    if(e->prev >= 0) cache->entries[e->prev].next = e->next; else cache->lruHead = e->next;
+    if(e->next >= 0) cache->entries[e->next].prev = e->prev; else cache->lruTail = e->prev;
+}
+
+/**
+ * purpose: free unpinned vectors, least recently used first, until the
+ * resident bytes fit the budget. Called with the cache lock held.
+ */
+void evictVectors(vector_cache_t *cache){
+    while(cache->resident > cache->budget && cache->lruHead >= 0){
+        int i = cache->lruHead;
+        DocVector *vec = cache->docs[i]->vec;
+        unlinkCacheEntry(cache, i);
+        cache->entries[i].state = VC_ABSENT;
+        cache->resident -= vec->bytes;
+        free(vec->data);
+        vec->data = NULL;
+    }
+}
+
+/**
+ * purpose: make the vector of analysed document i resident and keep it so
+ * until unpinVector. The read happens outside the lock; other threads
+ * wanting the same vector wait for it.
+ */
+void pinVector(vector_cache_t *cache, int i){
+    vcache_entry_t *e = &cache->entries[i];
+    DocVector *vec = cache->docs[i]->vec;
+    if(vec->offset < 0) return;
+
+    pthread_mutex_lock(&cache->lock);
+    while(e->state == VC_LOADING){
+        pthread_cond_wait(&cache->loaded, &cache->lock);
+    }
+    if(e->state == VC_RESIDENT){
+        if(e->pins++ == 0) unlinkCacheEntry(cache, i);
+        cache->hits++;
+        pthread_mutex_unlock(&cache->lock);
+        return;
+    }
+    e->state = VC_LOADING;
+    e->pins = 1;
+    cache->misses++;
+    cache->resident += vec->bytes;
+    evictVectors(cache);
+    if(cache->resident > cache->peak) cache->peak = cache->resident;
+    pthread_mutex_unlock(&cache->lock);
+
+    unsigned char *data = malloc(vec->bytes + 1);
+    for(uint64_t done = 0; done < vec->bytes; ){
+        ssize_t n = pread(cache->fd, data + done, vec->bytes - done, vec->offset + done);
+        if(n <= 0){
+            //the snapshot was readable when it was opened, so this is fatal
+            if(n == 0) errno = EIO;
+            perror(cache->path);
+            abort();
+        }
+        done += n;
+    }
+
+    pthread_mutex_lock(&cache->lock);
+    vec->data = data;
+    e->state = VC_RESIDENT;
+    cache->bytesRead += vec->bytes;
+    pthread_cond_broadcast(&cache->loaded);
+    pthread_mutex_unlock(&cache->lock);
+}
+
+void unpinVector(vector_cache_t *cache, int i){
+    vcache_entry_t *e = &cache->entries[i];
+    if(cache->docs[i]->vec->offset < 0) return;
+
+    pthread_mutex_lock(&cache->lock);
+    if(--e->pins == 0){
+        e->prev = cache->lruTail;
+        e->next = -1;
+        if(cache->lruTail >= 0) cache->entries[cache->lruTail].next = i; else cache->lruHead = i;
+        cache->lruTail = i;
+        evictVectors(cache);
+    }
+    pthread_mutex_unlock(&cache->lock);
+}
+
+typedef struct {
+    int block;
+    pair_tile_t tile;
+} cache_tile_t;
+
+int compareCacheTiles(const void *a, const void *b){
+    const pair_tile_t *x = &((const cache_tile_t *) a)->tile;
+    const pair_tile_t *y = &((const cache_tile_t *) b)->tile;
+    int blocks = ((const cache_tile_t *) a)->block - ((const cache_tile_t *) b)->block;
+    if(blocks != 0) return blocks;
+    if(x->colStart != y->colStart) return (x->colStart < y->colStart) ? -1 : 1;
+    return (x->rowStart > y->rowStart) - (x->rowStart < y->rowStart);
+}
+
+int compareTileRows(const void *a, const void *b){
+    const pair_tile_t *x = a;
+    const pair_tile_t *y = b;
+    if(x->rowStart != y->rowStart) return (x->rowStart < y->rowStart) ? -1 : 1;
+    return (x->colStart > y->colStart) - (x->colStart < y->colStart);
+}
+
+/**
+ * purpose: reorder tiles into the blocked nested loop described above. Rows
+ * join a block while its vectors fit half the budget.
+ */
+void orderCacheTiles(pair_tile_t *tiles, int numTiles, FileAndList **docs, uint64_t budget){
+    qsort(tiles, numTiles, sizeof(pair_tile_t), compareTileRows);
+
+    cache_tile_t *keyed = malloc(sizeof(cache_tile_t) * (numTiles + 1));
+    int block = 0;
+    uint64_t blockBytes = 0;
+    for(int t = 0; t < numTiles; t++){
+        if(t == 0 || tiles[t].rowStart != tiles[t - 1].rowStart){
+            uint64_t rowBytes = 0;
+            for(int i = tiles[t].rowStart; i < tiles[t].rowEnd; i++){
+                if(docs[i]->vec->offset >= 0) rowBytes += docs[i]->vec->bytes;
+            }
+            if(blockBytes > 0 && blockBytes + rowBytes > budget / 2){
+                block++;
+                blockBytes = 0;
+            }
+            blockBytes += rowBytes;
+        }
+        keyed[t].block = block;
+        keyed[t].tile = tiles[t];
+    }
+
+    qsort(keyed, numTiles, sizeof(cache_tile_t), compareCacheTiles);
+    for(int t = 0; t < numTiles; t++){
+        tiles[t] = keyed[t].tile;
+    }
+    free(keyed);
+}
+
+/**
+ * purpose: print what the cache read against the least it could have: every
+ * vector on disk that the tiles use read exactly once.
+ */
+void reportVectorCache(vector_cache_t *cache, pair_tile_t *tiles, int numTiles, FileAndList **docs, int numDocs){
+    char *used = calloc(numDocs + 1, 1);
+    for(int t = 0; t < numTiles; t++){
+        memset(used + tiles[t].rowStart, 1, tiles[t].rowEnd - tiles[t].rowStart);
+        memset(used + tiles[t].colStart, 1, tiles[t].colEnd - tiles[t].colStart);
+    }
+    uint64_t least = 0;
+    for(int i = 0; i < numDocs; i++){
+        if(used[i] && docs[i]->vec->offset >= 0) least += docs[i]->vec->bytes;
+    }
+    free(used);
+
+    double mb = 1024.0 * 1024.0;
+    fprintf(stderr, "out-of-core: read %.1f MB of vectors, at least %.1f MB needed (%.2fx)\n",
+            cache->bytesRead / mb, least / mb, least > 0 ? (double) cache->bytesRead / least : 1.0);
+    fprintf(stderr, "out-of-core: %ld hits, %ld misses, peak %.2f MB resident of a %.2f MB budget\n",
+            cache->hits, cache->misses, cache->peak / mb, cache->budget / mb);
+}
@@ -0,0 +1,456 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+
+#ifndef VOCABSIZE
+#define VOCABSIZE 1024
+#endif
+
+#ifndef MALLOC_OVERHEAD
+#define MALLOC_OVERHEAD 16      //bytes malloc adds to every block, for memory accounting
+#endif
+
+//---------------------------------------------------------------------
+// Vocabulary: interns every distinct word once for the whole corpus
+//---------------------------------------------------------------------
+
+/**
+ * HOW TO: vocabularies
+ *
+ * declaration              vocabulary_t vocab;
+ *
+ * initialization           init_vocabulary(&vocab);
+ *
+ * interning a word         uint64_t id = intern_word(&vocab, word);
+ *                          (call with vocab.lock held, see vectorFromList)
+ *
+ * deallocation             destroy_vocabulary(&vocab);
+ */
+typedef struct {
+    char **words;       //words[id] is the interned string
+    uint64_t *slots;    //open addressing table of id + 1, 0 is an empty slot
+    size_t count;
+    size_t capacity;    //always a power of two
+    size_t bytes;       //memory held by the words and both arrays
+    pthread_mutex_t lock;
+} vocabulary_t;
+
+uint64_t hashWord(const char *word){
+    //FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    while(*word){
+        hash ^= (unsigned char) *word++;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+//FNV-1a continued over n more bytes, for fingerprints of whole runs
+uint64_t fnvBytes(uint64_t h, const void *data, size_t n){
+    const unsigned char *p = data;
+    for(size_t i = 0; i < n; i++){
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+int init_vocabulary(vocabulary_t *vocab){
+    vocab->count = 0;
+    vocab->capacity = VOCABSIZE;
+    vocab->words = malloc(sizeof(char*) * vocab->capacity);
+    vocab->slots = calloc(vocab->capacity, sizeof(uint64_t));
+    vocab->bytes = vocab->capacity * (sizeof(char*) + sizeof(uint64_t));
+    if(vocab->words == NULL || vocab->slots == NULL){
+        perror("vocabulary init, malloc failed!");
+        return 1;
+    }
+    if(pthread_mutex_init(&vocab->lock, NULL)){
+        perror("lock init failed");
+        return 1;
+    }
+    return 0;
+}
+
+int destroy_vocabulary(vocabulary_t *vocab){
+    for(size_t i = 0; i < vocab->count; i++){
+        free(vocab->words[i]);
+    }
+    free(vocab->words);
+    free(vocab->slots);
+    pthread_mutex_destroy(&vocab->lock);
+    return 0;
+}
+
+/**
+ * purpose: look up a word without adding it.
+ * Returns 1 and sets *id if the word is interned, 0 otherwise.
+ */
+int lookup_word(vocabulary_t *vocab, const char *word, uint64_t *id){
+    size_t mask = vocab->capacity - 1;
+    size_t slot = hashWord(word) & mask;
+    while(vocab->slots[slot] != 0){
+        uint64_t candidate = vocab->slots[slot] - 1;
+        if(strcmp(vocab->words[candidate], word) == 0){
+            *id = candidate;
+            return 1;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return 0;
+}
+
+uint64_t intern_word(vocabulary_t *vocab, const char *word){
+    uint64_t id;
+    if(lookup_word(vocab, word, &id)){
+        return id;
+    }
+
+    //grow both arrays once the table is half full
+    if(2 * (vocab->count + 1) > vocab->capacity){
+        size_t capacity = 2 * vocab->capacity;
+        uint64_t *slots = calloc(capacity, sizeof(uint64_t));
+        char **words = realloc(vocab->words, sizeof(char*) * capacity);
+        if(slots == NULL || words == NULL){
+            perror("vocabulary resize failed");
+            abort();
+        }
+        for(size_t i = 0; i < vocab->count; i++){
+            size_t slot = hashWord(words[i]) & (capacity - 1);
+            while(slots[slot] != 0) slot = (slot + 1) & (capacity - 1);
+            slots[slot] = i + 1;
+        }
+        free(vocab->slots);
+        vocab->slots = slots;
+        vocab->words = words;
+        vocab->bytes += (capacity - vocab->capacity) * (sizeof(char*) + sizeof(uint64_t));
+        vocab->capacity = capacity;
+    }
+
+    id = vocab->count++;
+    vocab->words[id] = malloc(strlen(word) + 1);
+    strcpy(vocab->words[id], word);
+    vocab->bytes += strlen(word) + 1 + MALLOC_OVERHEAD;
+
+    size_t mask = vocab->capacity - 1;
+    size_t slot = hashWord(word) & mask;
+    while(vocab->slots[slot] != 0) slot = (slot + 1) & mask;
+    vocab->slots[slot] = id + 1;
+
+    return id;
+}
+
+//---------------------------------------------------------------------
+// Compact document vectors
+//---------------------------------------------------------------------
+
+/*
+ * A DocVector replaces a document's List once the collection phase is done.
+ * Each entry is a pair of LEB128 varints: the gap from the previous word ID
+ * and the word's frequency. Entries are sorted by word ID, and the WFD of a
+ * word is derived on the fly as frequency / total.
+ *
+ * Because the frequencies are kept as exact integers, every derived WFD is
+ * bit-for-bit the value computeWFD would have stored; only the order the
+ * JSD terms are summed in changes (word ID instead of lexicographic order).
+ */
+typedef struct DocVector {
+    int length;             //distinct words
+    uint64_t total;         //total words, the denominator of every WFD
+    size_t bytes;
+    unsigned char *data;    //NULL while the bytes are only on disk, see vcache.c
+    int64_t offset;         //where the bytes are in the repository's storeFd, -1 if nowhere
+} DocVector;
+
+typedef struct {
+    uint64_t id;
+    uint64_t frequency;
+} vectorEntry;
+
+size_t putVarint(unsigned char *out, uint64_t value){
+    size_t n = 0;
+    while(value >= 0x80){
+        out[n++] = (unsigned char) (value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = (unsigned char) value;
+    return n;
+}
+
+uint64_t getVarint(const unsigned char **in){
+    const unsigned char *p = *in;
+    uint64_t value = 0;
+    int shift = 0;
+    while(*p & 0x80){
+        value |= (uint64_t) (*p++ & 0x7f) << shift;
+        shift += 7;
+    }
+    value |= (uint64_t) *p++ << shift;
+    *in = p;
+    return value;
+}
+
+int compareEntries(const void *a, const void *b){
+    uint64_t x = ((const vectorEntry *) a)->id;
+    uint64_t y = ((const vectorEntry *) b)->id;
+    return (x > y) - (x < y);
+}
+
+/**
+ * purpose: pack an array of (id, frequency) entries into a new vector.
+ * The entries are sorted in place.
+ */
+DocVector *vectorFromEntries(vectorEntry *entries, int length){
+    qsort(entries, length, sizeof(vectorEntry), compareEntries);
+
+    DocVector *vec = malloc(sizeof(DocVector));
+    unsigned char *buf = malloc((size_t) length * 20 + 1);
+    size_t used = 0;
+    uint64_t previous = 0;
+    vec->length = length;
+    vec->total = 0;
+    for(int i = 0; i < length; i++){
+        used += putVarint(buf + used, entries[i].id - previous);
+        used += putVarint(buf + used, (uint64_t) entries[i].frequency);
+        previous = entries[i].id;
+        vec->total += entries[i].frequency;
+    }
+
+    vec->bytes = used;
+    vec->data = realloc(buf, used + 1);
+    vec->offset = -1;
+    return vec;
+}
+
+//intern every word of list into entries (call with vocab.lock held)
+static void internList(List *list, vocabulary_t *vocab, vectorEntry *entries){
+    int i = 0;
+    for(List *temp = list; temp != NULL; temp = temp->next){
+        entries[i].id = intern_word(vocab, temp->word);
+        entries[i].frequency = temp->frequency;
+        i++;
+    }
+}
+
+/**
+ * purpose: intern the words of a list and pack it into a vector.
+ * The list is left untouched; the caller destroys it.
+ */
+DocVector *vectorFromList(List *list, vocabulary_t *vocab){
+    int length = countLength(list);
+    vectorEntry *entries = malloc(sizeof(vectorEntry) * (length + 1));
+
+    //one lock per document rather than per word
+    pthread_mutex_lock(&vocab->lock);
+    internList(list, vocab, entries);
+    pthread_mutex_unlock(&vocab->lock);
+
+    DocVector *vec = vectorFromEntries(entries, length);
+    free(entries);
+    return vec;
+}
+
+/**
+ * purpose: vectorFromList, but only if interning the list can add at most
+ * allowed bytes to the vocabulary, counting every word as new and the table
+ * growth that many new words would cause. Sets *bytes to what it added, or
+ * returns NULL and sets *bytes to the most it could add if that is more.
+ */
+DocVector *vectorFromListWithin(List *list, vocabulary_t *vocab, size_t allowed, size_t *bytes){
+    int length = countLength(list);
+    size_t bound = 0;
+    for(List *temp = list; temp != NULL; temp = temp->next){
+        bound += strlen(temp->word) + 1 + MALLOC_OVERHEAD;
+    }
+
+    pthread_mutex_lock(&vocab->lock);
+    size_t capacity = vocab->capacity;
+    while(2 * (vocab->count + length) > capacity) capacity *= 2;
+    bound += (capacity - vocab->capacity) * (sizeof(char*) + sizeof(uint64_t));
+    if(bound > allowed){
+        pthread_mutex_unlock(&vocab->lock);
+        *bytes = bound;
+        return NULL;
+    }
+    vectorEntry *entries = malloc(sizeof(vectorEntry) * (length + 1));
+    size_t before = vocab->bytes;
+    internList(list, vocab, entries);
+    *bytes = vocab->bytes - before;
+    pthread_mutex_unlock(&vocab->lock);
+
+    DocVector *vec = vectorFromEntries(entries, length);
+    free(entries);
+    return vec;
+}
+
+//IDs given to words of a query that the corpus has never seen; they never clash with interned IDs
+#define UNKNOWN_WORD_ID ((uint64_t) 1 << 62)
+
+/**
+ * purpose: pack a list against the vocabulary without adding its new words,
+ * for documents (queries) that are compared to the corpus but not kept.
+ */
+DocVector *vectorLookupList(List *list, vocabulary_t *vocab){
+    int length = countLength(list);
+    vectorEntry *entries = malloc(sizeof(vectorEntry) * (length + 1));
+    uint64_t unknown = UNKNOWN_WORD_ID;
+
+    pthread_mutex_lock(&vocab->lock);
+    int i = 0;
+    for(List *temp = list; temp != NULL; temp = temp->next){
+        if(!lookup_word(vocab, temp->word, &entries[i].id)){
+            entries[i].id = unknown++;
+        }
+        entries[i].frequency = temp->frequency;
+        i++;
+    }
+    pthread_mutex_unlock(&vocab->lock);
+
+    DocVector *vec = vectorFromEntries(entries, length);
+    free(entries);
+    return vec;
+}
+
+void destroy_vector(DocVector *vec){
+    if(vec == NULL) return;
+    free(vec->data);
+    free(vec);
+}
+
+/**
+ * purpose: the same computation as calculateJSD over two vectors, in one
+ * merge walk and without building the mean distribution.
+ * A word only present in one document contributes WFD * log2(2) = WFD.
+ * Any other metrics asked for are summed in the same walk: the dot product
+ * and the Bhattacharyya coefficient over the shared support, and the norms
+ * over both supports. Only the JSD and totalWords are set for METRIC_JSD.
+ *
+ * more is a constant at both calls below, so the JSD alone compiles to the
+ * plain walk.
+ */
+static inline __attribute__((always_inline))
+void metricsWalk(DocVector *one, DocVector *two, const int more, pair_metrics_t *out){
+
+    out->totalWords = one->length + two->length;
+    if(one->length == 0 || two->length == 0){
+        emptyMetrics(one->length == 0, two->length == 0, out);
+        return;
+    }
+
+    const unsigned char *p1 = one->data;
+    const unsigned char *p2 = two->data;
+    int left1 = one->length;
+    int left2 = two->length;
+    uint64_t id1 = getVarint(&p1);
+    double wfd1 = (double) getVarint(&p1) / one->total;
+    uint64_t id2 = getVarint(&p2);
+    double wfd2 = (double) getVarint(&p2) / two->total;
+    double KLD1 = 0.0;
+    double KLD2 = 0.0;
+    double dot = 0.0, norm1 = 0.0, norm2 = 0.0, bc = 0.0;
+    int shared = 0;
+
+    while(left1 > 0 && left2 > 0){
+        if(id1 == id2){
+            double mean = (wfd1 + wfd2) / 2;
+            KLD1 += wfd1 * log2(wfd1 / mean);
+            KLD2 += wfd2 * log2(wfd2 / mean);
+            if(more){
+                dot += wfd1 * wfd2;
+                bc += sqrt(wfd1 * wfd2);
+                norm1 += wfd1 * wfd1;
+                norm2 += wfd2 * wfd2;
+                shared++;
+            }
+        } else if(id1 < id2){
+            KLD1 += wfd1;
+            if(more) norm1 += wfd1 * wfd1;
+        } else {
+            KLD2 += wfd2;
+            if(more) norm2 += wfd2 * wfd2;
+        }
+
+        //advance whichever side(s) were consumed
+        uint64_t consumed1 = id1, consumed2 = id2;
+        if(consumed1 <= consumed2 && --left1 > 0){
+            id1 += getVarint(&p1);
+            wfd1 = (double) getVarint(&p1) / one->total;
+        }
+        if(consumed2 <= consumed1 && --left2 > 0){
+            id2 += getVarint(&p2);
+            wfd2 = (double) getVarint(&p2) / two->total;
+        }
+    }
+
+    //whatever is left only appears in one document
+    while(left1 > 0){
+        KLD1 += wfd1;
+        if(more) norm1 += wfd1 * wfd1;
+        if(--left1 > 0){
+            id1 += getVarint(&p1);
+            wfd1 = (double) getVarint(&p1) / one->total;
+        }
+    }
+    while(left2 > 0){
+        KLD2 += wfd2;
+        if(more) norm2 += wfd2 * wfd2;
+        if(--left2 > 0){
+            id2 += getVarint(&p2);
+            wfd2 = (double) getVarint(&p2) / two->total;
+        }
+    }
+
+    out->JSD = sqrt((0.5*KLD1) + (0.5*KLD2));
+    if(more){
+        out->cosine = dot / sqrt(norm1 * norm2);
+        out->hellinger = (bc < 1) ? sqrt(1 - bc) : 0;
+        out->shared = shared;
+    }
+}
+
+void vectorMetrics(DocVector *one, DocVector *two, int metrics, pair_metrics_t *out){
+    if(metrics & ~METRIC_JSD){
+        metricsWalk(one, two, 1, out);
+    } else {
+        metricsWalk(one, two, 0, out);
+    }
+}
+
+double vectorJSD(DocVector *one, DocVector *two, int *countAddress){
+    pair_metrics_t metrics;
+    vectorMetrics(one, two, METRIC_JSD, &metrics);
+    *countAddress = metrics.totalWords;
+    return metrics.JSD;
+}
+
+/**
+ * purpose: JSD of two repository entries, whichever representation they hold.
+ */
+double documentJSD(FileAndList *one, FileAndList *two, int *countAddress){
+    if(one->vec != NULL && two->vec != NULL){
+        return vectorJSD(one->vec, two->vec, countAddress);
+    }
+    return calculateJSD(one->list, two->list, countAddress);
+}
+
+/**
+ * purpose: the chosen metrics of two repository entries in one pass. For
+ * the JSD alone lists still go through calculateJSD, so the output of a
+ * plain run does not move. Metrics that were not asked for are 0, since
+ * every field is stored in checkpoints and shard outputs.
+ */
+void documentMetrics(FileAndList *one, FileAndList *two, int metrics, pair_metrics_t *out){
+    out->cosine = 0;
+    out->hellinger = 0;
+    out->shared = 0;
+    if(one->vec != NULL && two->vec != NULL){
+        vectorMetrics(one->vec, two->vec, metrics, out);
+    } else if(metrics == METRIC_JSD){
+        out->JSD = calculateJSD(one->list, two->list, &out->totalWords);
+    } else {
+        listMetrics(one->list, two->list, out);
+    }
+}
@@ -0,0 +1,522 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#ifndef VP_LEAF
+#define VP_LEAF 8               //ranges this small are scanned instead of split
+#endif
+#ifndef VP_PARALLEL
+#define VP_PARALLEL 2048        //nodes this large share their distances between threads
+#endif
+#define VP_GAP 0.1              //a jump in distance this large splits a node instead of the median
+#define VP_SLACK 1e-9           //rounding allowance on the triangle inequality
+#define VPTREE_MAGIC "JSDV"
+#define VPTREE_VERSION 2
+
+//---------------------------------------------------------------------
+// Vantage-point tree: exact nearest neighbours through the triangle inequality
+//---------------------------------------------------------------------
+
+/*
+ * The distance compare prints (the square root of the JS divergence) is a
+ * metric, so for a query q, a vantage point v and any document x
+ *
+ *     d(q, x) >= |d(q, v) - d(v, x)|
+ *
+ * Every node of the tree is a range of order[]: its first document is the
+ * vantage point, and the rest, sorted by distance from it, is split into an
+ * inner and an outer subtree, each of which records the smallest and largest
+ * distance from the vantage point to its documents. A query that knows
+ * d(q, v) therefore has a lower bound for every document of a subtree. The
+ * search takes the pending subtrees closest bound first and stops once that
+ * bound is past the k-th best distance (or the radius). Ranges of VP_LEAF
+ * documents or fewer are leaves and are scanned.
+ *
+ * Near-duplicates make the split matter: a vantage point's own family sits
+ * well inside the distance of nearly everything else, which is close to 1.
+ * A median split would put the family in with half the rest, and its shell
+ * would cover both. So a node splits at a jump of at least VP_GAP in the
+ * sorted distances, the one nearest the median, and only falls back to the
+ * median without one. The family then gets a shell of its own that every
+ * query from elsewhere skips. Such splits can be lopsided, so the tree is
+ * built and checked without recursing into the larger side.
+ *
+ * Node data is kept in nodes[start of the range], so the tree is two flat
+ * arrays that are written to and read from a file as they are. Vantage points
+ * and splits are picked deterministically, so the same corpus always gives
+ * the same tree whatever the number of threads building it.
+ */
+
+typedef struct {
+    int mid;                    //the inner subtree is [start + 1, mid), the outer [mid, end)
+    int reserved;
+    double innerMin, innerMax;  //distances from the vantage point to the inner subtree
+    double outerMin, outerMax;
+} vp_node_t;
+
+typedef struct {
+    int numDocs;
+    int *order;                 //documents in tree order
+    vp_node_t *nodes;           //nodes[s] describes the node whose range starts at s
+    uint64_t fingerprint;
+    long compared;              //distances computed by queries, for the statistics
+} vp_tree_t;
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t numDocs;
+    uint32_t leafSize;
+    uint64_t fingerprint;
+} vptree_header_t;
+
+typedef struct {
+    int doc;
+    double distance;
+} vp_item_t;
+
+double vpDistance(DocVector *one, DocVector *two){
+    int count;
+    return vectorJSD(one, two, &count);
+}
+
+/**
+ * purpose: a hash of the documents a tree indexes, so a tree read from a
+ * file is only used with the corpus it was built from.
+ */
+uint64_t vpFingerprint(FileAndList **docs, int numDocs){
+    uint64_t h = 14695981039346656037ULL;
+    h = fnvBytes(h, &numDocs, sizeof(numDocs));
+    for(int i = 0; i < numDocs; i++){
+        h = fnvBytes(h, docs[i]->filepath, strlen(docs[i]->filepath) + 1);
+        h = fnvBytes(h, &docs[i]->vec->length, sizeof(int));
+        h = fnvBytes(h, &docs[i]->vec->total, sizeof(uint64_t));
+        h = fnvBytes(h, docs[i]->vec->data, docs[i]->vec->bytes);
+    }
+    return h;
+}
+
+int compareVpItems(const void *a, const void *b){
+    const vp_item_t *x = a;
+    const vp_item_t *y = b;
+    if(x->distance != y->distance) return (x->distance > y->distance) - (x->distance < y->distance);
+    return (x->doc > y->doc) - (x->doc < y->doc);
+}
+
+/**
+ * purpose: where to split items[0..n), sorted by distance: at the jump of
+ * at least VP_GAP nearest the median, or at the median. Returns the size
+ * of the inner side, at least 1.
+ */
+int splitVpItems(vp_item_t *items, int n){
+    int median = n / 2;
+    int best = median;
+    int offBest = n;
+    for(int m = 1; m < n; m++){
+        int off = (m > median) ? m - median : median - m;
+        if(items[m].distance - items[m - 1].distance >= VP_GAP && off < offBest){
+            best = m;
+            offBest = off;
+        }
+    }
+    return best;
+}
+
+typedef struct {
+    FileAndList **docs;
+    DocVector *vantage;
+    vp_item_t *items;
+    int count;
+} vpDistanceArgs;
+
+void* vpDistanceThreadTask(void* arg){
+    vpDistanceArgs *args = arg;
+    for(int i = 0; i < args->count; i++){
+        args->items[i].distance = vpDistance(args->vantage, args->docs[args->items[i].doc]->vec);
+    }
+    return NULL;
+}
+
+/**
+ * purpose: fill in the distance of items[0..count) from vantage, split
+ * between threads threads.
+ */
+void measureVpItems(FileAndList **docs, DocVector *vantage, vp_item_t *items, int count, int threads){
+    int parts = (count >= VP_PARALLEL && threads > 1) ? threads : 1;
+    pthread_t *tids = malloc(sizeof(pthread_t) * parts);
+    vpDistanceArgs *args = malloc(sizeof(vpDistanceArgs) * parts);
+    for(int p = 0; p < parts; p++){
+        int first = (int) ((long) count * p / parts);
+        int last = (int) ((long) count * (p + 1) / parts);
+        args[p].docs = docs;
+        args[p].vantage = vantage;
+        args[p].items = &items[first];
+        args[p].count = last - first;
+        if(p > 0) pthread_create(&tids[p], NULL, vpDistanceThreadTask, &args[p]);
+    }
+    vpDistanceThreadTask(&args[0]);
+    for(int p = 1; p < parts; p++){
+        pthread_join(tids[p], NULL);
+    }
+    free(tids);
+    free(args);
+}
+
+typedef struct {
+    vp_tree_t *tree;
+    FileAndList **docs;
+    vp_item_t *items;
+    int start;
+    int end;
+    int threads;
+} vpBuildArgs;
+
+void* vpBuildThreadTask(void* arg);
+
+/**
+ * purpose: build the node of items[start..end) and its subtrees, with up to
+ * threads threads. The smaller side of each split is built by a call of its
+ * own (on a new thread while there are threads to hand out), the larger one
+ * by the loop, so the recursion stays logarithmic however lopsided the splits.
+ */
+void buildVpNode(vp_tree_t *tree, FileAndList **docs, vp_item_t *items, int start, int end, int threads){
+    pthread_t tids[64];
+    vpBuildArgs args[64];
+    int spawned = 0;
+
+    while(end - start > VP_LEAF){
+        //a fixed pseudo random vantage point, so the tree does not depend on the input order
+        uint64_t pick = ((uint64_t) start * 2654435761ULL + (uint64_t) end * 40503ULL) % (uint64_t) (end - start);
+        vp_item_t swap = items[start];
+        items[start] = items[start + pick];
+        items[start + pick] = swap;
+
+        int count = end - start - 1;
+        measureVpItems(docs, docs[items[start].doc]->vec, &items[start + 1], count, threads);
+        qsort(&items[start + 1], count, sizeof(vp_item_t), compareVpItems);
+
+        int mid = start + 1 + splitVpItems(&items[start + 1], count);
+        vp_node_t *node = &tree->nodes[start];
+        node->mid = mid;
+        node->innerMin = items[start + 1].distance;
+        node->innerMax = items[mid - 1].distance;
+        node->outerMin = items[mid].distance;
+        node->outerMax = items[end - 1].distance;
+
+        int innerSmaller = (mid - start - 1 <= end - mid);
+        int first = innerSmaller ? start + 1 : mid;
+        int last = innerSmaller ? mid : end;
+        if(threads > 1 && last - first >= VP_PARALLEL / 8 && spawned < 64){
+            args[spawned] = (vpBuildArgs) { tree, docs, items, first, last, threads / 2 };
+            pthread_create(&tids[spawned], NULL, vpBuildThreadTask, &args[spawned]);
+            spawned++;
+            threads -= threads / 2;
+        } else {
+            buildVpNode(tree, docs, items, first, last, 1);
+        }
+        if(innerSmaller){
+            start = mid;
+        } else {
+            end = mid;
+            start = start + 1;
+        }
+    }
+
+    for(int t = 0; t < spawned; t++){
+        pthread_join(tids[t], NULL);
+    }
+}
+
+void* vpBuildThreadTask(void* arg){
+    vpBuildArgs *args = arg;
+    buildVpNode(args->tree, args->docs, args->items, args->start, args->end, args->threads);
+    return NULL;
+}
+
+/**
+ * purpose: build the tree of docs[0..numDocs), which must hold compact
+ * vectors, with up to threads threads.
+ */
+int init_vptree(vp_tree_t *tree, FileAndList **docs, int numDocs, int threads){
+    tree->numDocs = numDocs;
+    tree->order = malloc(sizeof(int) * (numDocs + 1));
+    tree->nodes = calloc(numDocs + 1, sizeof(vp_node_t));
+    tree->fingerprint = vpFingerprint(docs, numDocs);
+    tree->compared = 0;
+
+    vp_item_t *items = malloc(sizeof(vp_item_t) * (numDocs + 1));
+    for(int i = 0; i < numDocs; i++){
+        items[i].doc = i;
+        items[i].distance = 0;
+    }
+    buildVpNode(tree, docs, items, 0, numDocs, threads < 1 ? 1 : threads);
+    for(int i = 0; i < numDocs; i++){
+        tree->order[i] = items[i].doc;
+    }
+    free(items);
+    return 0;
+}
+
+void destroy_vptree(vp_tree_t *tree){
+    free(tree->order);
+    free(tree->nodes);
+}
+
+/**
+ * purpose: write the tree to path, through a temporary file renamed over it.
+ */
+int saveVptree(const char *path, vp_tree_t *tree){
+    vptree_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, VPTREE_MAGIC, 4);
+    header.version = VPTREE_VERSION;
+    header.numDocs = tree->numDocs;
+    header.leafSize = VP_LEAF;
+    header.fingerprint = tree->fingerprint;
+
+    char *temp = malloc(strlen(path) + 5);
+    sprintf(temp, "%s.tmp", path);
+    FILE *out = fopen(temp, "wb");
+    if(out == NULL){
+        perror(temp);
+        free(temp);
+        return -1;
+    }
+    int err = (fwrite(&header, sizeof(header), 1, out) != 1);
+    if(!err && tree->numDocs > 0){
+        err = fwrite(tree->order, sizeof(int), tree->numDocs, out) != (size_t) tree->numDocs
+              || fwrite(tree->nodes, sizeof(vp_node_t), tree->numDocs, out) != (size_t) tree->numDocs;
+    }
+    if(fclose(out)) err = 1;
+    if(!err && rename(temp, path)) err = 1;
+    if(err){
+        perror(path);
+        unlink(temp);
+    }
+    free(temp);
+    return err ? -1 : 0;
+}
+
+//whether every node a search can reach splits its range into two nonempty sides
+int checkVpTree(vp_tree_t *tree){
+    int *stack = malloc(sizeof(int) * 2 * (tree->numDocs + 1));
+    int depth = 0;
+    int err = 0;
+    stack[depth++] = 0;
+    stack[depth++] = tree->numDocs;
+    while(depth > 0 && !err){
+        int end = stack[--depth];
+        int start = stack[--depth];
+        if(end - start <= VP_LEAF) continue;
+        int mid = tree->nodes[start].mid;
+        if(mid <= start + 1 || mid >= end){
+            err = -1;
+            break;
+        }
+        stack[depth++] = start + 1;
+        stack[depth++] = mid;
+        stack[depth++] = mid;
+        stack[depth++] = end;
+    }
+    free(stack);
+    return err;
+}
+
+/**
+ * purpose: read a tree written by saveVptree for docs[0..numDocs).
+ */
+int loadVptree(const char *path, vp_tree_t *tree, FileAndList **docs, int numDocs){
+    FILE *in = fopen(path, "rb");
+    if(in == NULL){
+        perror(path);
+        return -1;
+    }
+    vptree_header_t header;
+    if(fread(&header, sizeof(header), 1, in) != 1 || memcmp(header.magic, VPTREE_MAGIC, 4) != 0
+       || header.version != VPTREE_VERSION || header.leafSize != VP_LEAF){
+        fprintf(stderr, "ERROR: %s is not a compatible vantage-point tree\n", path);
+        fclose(in);
+        return -1;
+    }
+    if(header.numDocs != (uint32_t) numDocs || header.fingerprint != vpFingerprint(docs, numDocs)){
+        fprintf(stderr, "ERROR: %s was built over a different corpus\n", path);
+        fclose(in);
+        return -1;
+    }
+
+    tree->numDocs = numDocs;
+    tree->order = malloc(sizeof(int) * (numDocs + 1));
+    tree->nodes = malloc(sizeof(vp_node_t) * (numDocs + 1));
+    tree->fingerprint = header.fingerprint;
+    tree->compared = 0;
+    int err = numDocs > 0 && (fread(tree->order, sizeof(int), numDocs, in) != (size_t) numDocs
+                              || fread(tree->nodes, sizeof(vp_node_t), numDocs, in) != (size_t) numDocs);
+    fclose(in);
+    for(int i = 0; i < numDocs && !err; i++){
+        err = tree->order[i] < 0 || tree->order[i] >= numDocs;
+    }
+    if(!err){
+        err = checkVpTree(tree);
+    }
+    if(err){
+        fprintf(stderr, "ERROR: %s is corrupt\n", path);
+        destroy_vptree(tree);
+        return -1;
+    }
+    return 0;
+}
+
+//a subtree the search has yet to look at, and a lower bound on its distances
+typedef struct {
+    int start;
+    int end;
+    double bound;
+} vp_pending_t;
+
+typedef struct {
+    vp_tree_t *tree;
+    FileAndList **docs;
+    DocVector *query;
+    const char *skip;
+    int k;                      //k nearest: the best so far, sorted
+    index_match_t *best;
+    int found;
+    double radius;              //or everything within radius, when it is not negative
+    index_match_t *within;
+    int numWithin;
+    int capacity;
+    vp_pending_t *heap;         //pending subtrees, a min-heap on bound
+    int heapSize;
+    int heapCapacity;
+    long compared;
+} vp_search_t;
+
+//the distance past which a document cannot be a result any more
+double vpBound(vp_search_t *search){
+    if(search->radius >= 0) return search->radius;
+    return (search->found < search->k) ? INFINITY : search->best[search->k - 1].JSD;
+}
+
+void offerVpMatch(vp_search_t *search, int doc, double distance){
+    if(search->skip != NULL && search->skip[doc]) return;
+    if(search->radius < 0){
+        offerIndexMatch(search->best, &search->found, search->k, doc, distance);
+    } else if(distance <= search->radius){
+        if(search->numWithin == search->capacity){
+            search->capacity = search->capacity ? 2 * search->capacity : 16;
+            search->within = realloc(search->within, sizeof(index_match_t) * search->capacity);
+        }
+        search->within[search->numWithin].doc = doc;
+        search->within[search->numWithin].JSD = distance;
+        search->numWithin++;
+    }
+}
+
+void pushVpPending(vp_search_t *search, int start, int end, double bound){
+    if(start >= end || bound > vpBound(search) + VP_SLACK) return;
+    if(search->heapSize == search->heapCapacity){
+        search->heapCapacity = search->heapCapacity ? 2 * search->heapCapacity : 64;
+        search->heap = realloc(search->heap, sizeof(vp_pending_t) * search->heapCapacity);
+    }
+    int i = search->heapSize++;
+    while(i > 0 && search->heap[(i - 1) / 2].bound > bound){
+        search->heap[i] = search->heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    search->heap[i] = (vp_pending_t) { start, end, bound };
+}
+
+vp_pending_t popVpPending(vp_search_t *search){
+    vp_pending_t top = search->heap[0];
+    vp_pending_t last = search->heap[--search->heapSize];
+    int i = 0;
+    for(;;){
+        int child = 2 * i + 1;
+        if(child >= search->heapSize) break;
+        if(child + 1 < search->heapSize && search->heap[child + 1].bound < search->heap[child].bound) child++;
+        if(search->heap[child].bound >= last.bound) break;
+        search->heap[i] = search->heap[child];
+        i = child;
+    }
+    if(search->heapSize > 0) search->heap[i] = last;
+    return top;
+}
+
+void searchVptree(vp_search_t *search){
+    vp_tree_t *tree = search->tree;
+    pushVpPending(search, 0, tree->numDocs, 0);
+    while(search->heapSize > 0){
+        vp_pending_t next = popVpPending(search);
+
+        //every subtree left is at least this far away
+        if(next.bound > vpBound(search) + VP_SLACK) break;
+
+        if(next.end - next.start <= VP_LEAF){
+            for(int i = next.start; i < next.end; i++){
+                int doc = tree->order[i];
+                search->compared++;
+                offerVpMatch(search, doc, vpDistance(search->query, search->docs[doc]->vec));
+            }
+            continue;
+        }
+
+        int vantage = tree->order[next.start];
+        double d = vpDistance(search->query, search->docs[vantage]->vec);
+        search->compared++;
+        offerVpMatch(search, vantage, d);
+
+        vp_node_t *node = &tree->nodes[next.start];
+        double inner = fmax(next.bound, fmax(d - node->innerMax, node->innerMin - d));
+        double outer = fmax(next.bound, fmax(d - node->outerMax, node->outerMin - d));
+        pushVpPending(search, next.start + 1, node->mid, inner);
+        pushVpPending(search, node->mid, next.end, outer);
+    }
+    free(search->heap);
+}
+
+/**
+ * purpose: the k documents closest to query, closest first with ties to the
+ * lower document, like query_index. skip (may be NULL) flags documents to
+ * leave out. Returns the number of matches written to best.
+ */
+int query_vptree(vp_tree_t *tree, FileAndList **docs, DocVector *query, int k, const char *skip, index_match_t *best){
+    vp_search_t search;
+    memset(&search, 0, sizeof(search));
+    search.tree = tree;
+    search.docs = docs;
+    search.query = query;
+    search.skip = skip;
+    search.k = k;
+    search.best = best;
+    search.radius = -1;
+    if(k > 0) searchVptree(&search);
+    tree->compared += search.compared;
+    return search.found;
+}
+
+/**
+ * purpose: every document within radius of query, closest first with ties
+ * to the lower document. Sets *matches to a malloc'd array (NULL if there
+ * are none) and returns its length.
+ */
+int query_vptree_radius(vp_tree_t *tree, FileAndList **docs, DocVector *query, double radius,
+                        const char *skip, index_match_t **matches){
+    vp_search_t search;
+    memset(&search, 0, sizeof(search));
+    search.tree = tree;
+    search.docs = docs;
+    search.query = query;
+    search.skip = skip;
+    search.radius = (radius < 0) ? 0 : radius;
+    searchVptree(&search);
+    tree->compared += search.compared;
+    if(search.numWithin > 1){
+        qsort(search.within, search.numWithin, sizeof(index_match_t), compareIndexMatches);
+    }
+    *matches = search.within;
+    return search.numWithin;
+}
@@ -0,0 +1,428 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+
+#ifndef WATCH_TAIL
+#define WATCH_TAIL 4096         //bytes before the end of what was read that must not have changed
+#endif
+
+#ifndef WATCH_SETTLE
+#define WATCH_SETTLE 200        //milliseconds without events before a batch of changes is taken
+#endif
+
+#define WATCH_EVENTS (IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_CREATE | IN_MOVED_TO | IN_DELETE)
+
+//---------------------------------------------------------------------
+// Watch mode: incremental tokenization of growing files
+//---------------------------------------------------------------------
+
+/*
+ * --watch keeps, for every document, the word table its file was counted
+ * into, the tokenizer and how far into the file it has read. inotify on the
+ * directories of the documents reports writes; a file that grew only has its
+ * new bytes tokenized. The tokenizer is never told the file ended: the word
+ * the file ends in is counted, but also kept (pending), and taken back out
+ * before the next bytes are read so a word cut by the old end is counted
+ * once, whole. A character cut off by the end is read again next time.
+ *
+ * A file is read again from the start when it is a different file (inode),
+ * shorter than what was read, or the WATCH_TAIL bytes before the old end
+ * differ, and always if it is compressed. A rewrite that keeps the size and
+ * those bytes is not noticed. Files created after the start are not added.
+ */
+
+enum { WATCH_UNCHANGED, WATCH_APPENDED, WATCH_REREAD };
+
+typedef struct {
+    wordtable_t table;
+    uint64_t word_count;
+    tableWords words;           //the tokenizer's context, pointing at the two above
+    tokenizer_t tok;
+    char *pending;              //the word the file ends in, counted until more of it arrives
+    off_t offset;               //bytes tokenized
+    off_t tailStart;
+    uint64_t tailHash;          //of the bytes [tailStart, offset)
+    dev_t dev;
+    ino_t ino;
+    int changed;                //an event named the file since the last batch
+    int action;                 //what the last refresh did
+} watch_file_t;
+
+typedef struct {
+    int wd;
+    char *prefix;               //what the paths of the documents in the directory start with
+} watch_dir_t;
+
+typedef struct {
+    int fd;                     //inotify
+    FileAndList **docs;         //sorted by path, see sortRepository
+    int numDocs;
+    watch_file_t *files;
+    watch_dir_t *dirs;          //sorted by wd
+    int numDirs;
+} watch_t;
+
+void initWatchFile(watch_file_t *w){
+    w->word_count = 0;
+    w->words.table = &w->table;
+    w->words.word_count = &w->word_count;
+    init_wordtable(&w->table);
+    init_tokenizer(&w->tok, tokenRules, countWord, &w->words);
+    w->pending = NULL;
+    w->offset = 0;
+    w->tailStart = 0;
+    w->tailHash = 0;
+}
+
+//forget everything read from the file, to read it from the start
+void resetWatchFile(watch_file_t *w){
+    destroy_wordtable(&w->table);
+    destroy_tokenizer(&w->tok);
+    free(w->pending);
+    initWatchFile(w);
+}
+
+int compareWatchWds(const void *a, const void *b){
+    const watch_dir_t *x = a;
+    const watch_dir_t *y = b;
+    return (x->wd > y->wd) - (x->wd < y->wd);
+}
+
+int compareWatchDirs(const void *a, const void *b){
+    const watch_dir_t *x = a;
+    const watch_dir_t *y = b;
+    if(x->wd != y->wd) return (x->wd < y->wd) ? -1 : 1;
+    return strcmp(x->prefix, y->prefix);
+}
+
+int comparePrefixes(const void *a, const void *b){
+    return strcmp(*(char * const *) a, *(char * const *) b);
+}
+
+/**
+ * purpose: watch the directories of every document. The documents are read
+ * by refreshWatchFiles, the first time like every other.
+ * Returns -1 if inotify or a directory cannot be watched.
+ */
+int init_watch(watch_t *watch, FileAndList **docs, int numDocs){
+    watch->docs = docs;
+    watch->numDocs = numDocs;
+    watch->files = calloc(numDocs + 1, sizeof(watch_file_t));
+    watch->dirs = NULL;
+    watch->numDirs = 0;
+    for(int i = 0; i < numDocs; i++){
+        initWatchFile(&watch->files[i]);
+        watch->files[i].changed = 1;
+    }
+
+    watch->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if(watch->fd == -1){
+        perror("inotify");
+        return -1;
+    }
+
+    //one watch per distinct directory prefix
+    char **prefixes = malloc(sizeof(char *) * (numDocs + 1));
+    for(int i = 0; i < numDocs; i++){
+        const char *slash = strrchr(docs[i]->filepath, '/');
+        size_t length = (slash == NULL) ? 0 : (size_t) (slash - docs[i]->filepath) + 1;
+        prefixes[i] = strndup(docs[i]->filepath, length);
+    }
+    qsort(prefixes, numDocs, sizeof(char *), comparePrefixes);
+
+    int err = 0;
+    char *kept = calloc(numDocs + 1, 1);
+    watch->dirs = malloc(sizeof(watch_dir_t) * (numDocs + 1));
+    for(int i = 0; i < numDocs && !err; i++){
+        if(i > 0 && strcmp(prefixes[i], prefixes[i - 1]) == 0) continue;
+        const char *dir = (prefixes[i][0] == '\0') ? "." : prefixes[i];
+        int wd = inotify_add_watch(watch->fd, dir, WATCH_EVENTS);
+        if(wd == -1){
+            perror(dir);
+            err = -1;
+            continue;
+        }
+        watch->dirs[watch->numDirs].wd = wd;
+        watch->dirs[watch->numDirs].prefix = prefixes[i];
+        watch->numDirs++;
+        kept[i] = 1;
+    }
+    for(int i = 0; i < numDocs; i++){
+        if(!kept[i]) free(prefixes[i]);
+    }
+    free(kept);
+    free(prefixes);
+    qsort(watch->dirs, watch->numDirs, sizeof(watch_dir_t), compareWatchDirs);
+    return err;
+}
+
+void destroy_watch(watch_t *watch){
+    for(int i = 0; i < watch->numDocs; i++){
+        destroy_wordtable(&watch->files[i].table);
+        destroy_tokenizer(&watch->files[i].tok);
+        free(watch->files[i].pending);
+    }
+    for(int d = 0; d < watch->numDirs; d++){
+        free(watch->dirs[d].prefix);
+    }
+    free(watch->files);
+    free(watch->dirs);
+    if(watch->fd != -1) close(watch->fd);
+}
+
+//the hash of the bytes [start, end) of fd, 0 if they cannot all be read
+uint64_t watchTailHash(int fd, off_t start, off_t end){
+    unsigned char buf[WATCH_TAIL];
+    if(end - start > WATCH_TAIL) start = end - WATCH_TAIL;
+    if(pread(fd, buf, end - start, start) != end - start) return 0;
+    return fnvBytes(14695981039346656037ULL, buf, end - start);
+}
+
+/**
+ * purpose: the list of a watched file, copied from its table: words whose
+ * pending occurrence was taken back and never came again are left out.
+ */
+List *watchList(watch_file_t *w){
+    List *head = NULL;
+    for(size_t i = 0; i < w->table.capacity; i++){
+        wordEntry *entry = &w->table.entries[i];
+        if(entry->word == NULL || entry->count == 0) continue;
+        List *node = malloc(sizeof(List));
+        node->word = malloc(strlen(entry->word) + 1);
+        strcpy(node->word, entry->word);
+        node->frequency = entry->count;
+        node->WFD = (double) node->frequency / w->word_count;
+        node->next = head;
+        head = node;
+    }
+    return head;
+}
+
+void replaceDocument(FileAndList *fal, List *list, vocabulary_t *vocab){
+    destroy_list(&fal->list);
+    destroy_vector(fal->vec);
+    finishDocument(fal, list, vocab);
+}
+
+//a file that cannot be read: its document is empty until it can be read from the start
+int failWatchFile(watch_file_t *w, FileAndList *fal, vocabulary_t *vocab, int fd){
+    int saved = errno;
+    if(fd != -1) close(fd);
+    resetWatchFile(w);
+    w->dev = 0;
+    w->ino = 0;
+    w->action = WATCH_REREAD;
+    replaceDocument(fal, NULL, vocab);
+    errno = saved;
+    return -1;
+}
+
+/**
+ * purpose: bring a document up to date with its file, reading only what was
+ * appended if it can (see above). Sets w->action. Returns -1 with errno set
+ * if the file cannot be read; the document is then left empty.
+ */
+int refreshWatchFile(watch_file_t *w, FileAndList *fal, vocabulary_t *vocab){
+    struct stat st;
+    int fd = open(fal->filepath, O_RDONLY, 0);
+    if(fd == -1 || fstat(fd, &st)){
+        return failWatchFile(w, fal, vocab, fd);
+    }
+
+    int compressed = compressionOf(fd) != COMPRESSION_NONE;
+    int reread = compressed || st.st_dev != w->dev || st.st_ino != w->ino || st.st_size < w->offset
+                 || (w->offset > 0 && watchTailHash(fd, w->tailStart, w->offset) != w->tailHash);
+    if(!reread && st.st_size == w->offset){
+        close(fd);
+        w->action = WATCH_UNCHANGED;
+        return 0;
+    }
+    w->action = reread ? WATCH_REREAD : WATCH_APPENDED;
+    w->dev = st.st_dev;
+    w->ino = st.st_ino;
+    if(reread) resetWatchFile(w);
+
+    //a compressed file has no tail to read on from
+    if(compressed){
+        destroy_list(&fal->list);
+        destroy_vector(fal->vec);
+        int err = readDocument(fal, fd, vocab, 1, tokenRules, ngramSize);
+        int saved = errno;
+        close(fd);
+        errno = saved;
+        return err;
+    }
+
+    if(w->pending != NULL){
+        wordtable_add(&w->table, w->pending, hashWord(w->pending), (uint64_t) -1, 0);     //wraps round to one fewer
+        w->word_count--;
+        free(w->pending);
+        w->pending = NULL;
+    }
+
+    unsigned char *buf = malloc(TOKENBUF);
+    off_t pos = w->offset;
+    ssize_t bytes_read;
+    while((bytes_read = pread(fd, buf, TOKENBUF, pos)) > 0){
+        size_t used = tokenize(&w->tok, buf, bytes_read, 0);
+        if(used == 0) break;
+        pos += used;
+    }
+    free(buf);
+    if(bytes_read < 0){
+        return failWatchFile(w, fal, vocab, fd);
+    }
+
+    if(w->tok.word.used > 0){
+        w->pending = malloc(w->tok.word.used + 1);
+        strcpy(w->pending, w->tok.word.data);
+        wordtable_add(&w->table, w->pending, hashWord(w->pending), 1, 0);
+        w->word_count++;
+    }
+    w->offset = pos;
+    w->tailStart = (pos > WATCH_TAIL) ? pos - WATCH_TAIL : 0;
+    w->tailHash = watchTailHash(fd, w->tailStart, pos);
+    close(fd);
+
+    replaceDocument(fal, watchList(w), vocab);
+    return 0;
+}
+
+typedef struct {
+    watch_t *watch;
+    vocabulary_t *vocab;
+    int stride;
+    int id;
+    int failed;
+} watchThreadArgs;
+
+void* watchThreadTask(void* arg){
+    watchThreadArgs *args = arg;
+    watch_t *watch = args->watch;
+
+    for(int i = args->id; i < watch->numDocs; i += args->stride){
+        if(!watch->files[i].changed){
+            watch->files[i].action = WATCH_UNCHANGED;
+            continue;
+        }
+        if(refreshWatchFile(&watch->files[i], watch->docs[i], args->vocab)){
+            perror(watch->docs[i]->filepath);
+            args->failed++;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * purpose: refresh every document flagged changed on threads threads, then
+ * clear the flags. Returns the number of files that could not be read.
+ */
+int refreshWatchFiles(watch_t *watch, vocabulary_t *vocab, int threads){
+    pthread_t *tids = malloc(sizeof(pthread_t) * threads);
+    watchThreadArgs *args = malloc(sizeof(watchThreadArgs) * threads);
+    for(int i = 0; i < threads; i++){
+        args[i].watch = watch;
+        args[i].vocab = vocab;
+        args[i].stride = threads;
+        args[i].id = i;
+        args[i].failed = 0;
+        pthread_create(&tids[i], NULL, watchThreadTask, &args[i]);
+    }
+    int failed = 0;
+    for(int i = 0; i < threads; i++){
+        pthread_join(tids[i], NULL);
+        failed += args[i].failed;
+    }
+    for(int i = 0; i < watch->numDocs; i++){
+        watch->files[i].changed = 0;
+    }
+    free(tids);
+    free(args);
+    return failed;
+}
+
+//flag the document an event names, if it is one
+void flagWatchEvent(watch_t *watch, const struct inotify_event *event){
+    if(event->mask & IN_Q_OVERFLOW){
+        //events were lost: every file is checked, the unchanged ones cheaply
+        for(int i = 0; i < watch->numDocs; i++){
+            watch->files[i].changed = 1;
+        }
+        return;
+    }
+    if(event->len == 0) return;
+
+    //several prefixes ("d/" and "./d/") can name one directory and share its wd
+    watch_dir_t key = { event->wd, NULL };
+    watch_dir_t *dir = bsearch(&key, watch->dirs, watch->numDirs, sizeof(watch_dir_t), compareWatchWds);
+    if(dir == NULL) return;
+    int first = dir - watch->dirs;
+    while(first > 0 && watch->dirs[first - 1].wd == event->wd) first--;
+
+    for(int d = first; d < watch->numDirs && watch->dirs[d].wd == event->wd; d++){
+        char *path = malloc(strlen(watch->dirs[d].prefix) + strlen(event->name) + 1);
+        strcpy(path, watch->dirs[d].prefix);
+        strcat(path, event->name);
+        FileAndList probe = { .filepath = path };
+        FileAndList *probePtr = &probe;
+        FileAndList **found = bsearch(&probePtr, watch->docs, watch->numDocs, sizeof(FileAndList *),
+                                      compareDocuments);
+        if(found != NULL) watch->files[found - watch->docs].changed = 1;
+        free(path);
+    }
+}
+
+/**
+ * purpose: wait for events naming documents, then keep taking them until
+ * none come for WATCH_SETTLE milliseconds. Returns the number of documents
+ * flagged, 0 if the wait was interrupted, -1 on an error.
+ */
+int waitForChanges(watch_t *watch){
+    char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    struct pollfd pfd = { watch->fd, POLLIN, 0 };
+    int timeout = -1;
+
+    while(1){
+        int ready = poll(&pfd, 1, timeout);
+        if(ready < 0 && errno == EINTR) return 0;
+        if(ready < 0){
+            perror("poll");
+            return -1;
+        }
+        if(ready == 0) break;
+
+        ssize_t n;
+        while((n = read(watch->fd, buf, sizeof(buf))) > 0){
+            for(char *p = buf; p < buf + n; ){
+                struct inotify_event *event = (struct inotify_event *) p;
+                flagWatchEvent(watch, event);
+                p += sizeof(struct inotify_event) + event->len;
+            }
+        }
+        if(n < 0 && errno != EAGAIN && errno != EINTR){
+            perror("inotify");
+            return -1;
+        }
+
+        int flagged = 0;
+        for(int i = 0; i < watch->numDocs && !flagged; i++){
+            flagged = watch->files[i].changed;
+        }
+        if(flagged) timeout = WATCH_SETTLE;
+    }
+
+    int flagged = 0;
+    for(int i = 0; i < watch->numDocs; i++){
+        flagged += watch->files[i].changed;
+    }
+    return flagged;
+}